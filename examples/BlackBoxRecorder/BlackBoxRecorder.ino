@@ -0,0 +1,87 @@
+/**
+ * BlackBoxRecorder.ino
+ *
+ * Keeps the last few seconds of radar frames in RAM and dumps them
+ * when something interesting happens. Useful for debugging incidents
+ * without recording all the time.
+ *
+ * Triggers:
+ * - Sending 't' in the Serial Monitor
+ * - A burst of parse errors (5 errors within 1 second)
+ * - A target coming closer than 50 cm
+ *
+ * Output (one line per recorded frame, oldest first):
+ *   #bb,index,total,timestamp,flags,<30 raw bytes in hex>
+ *
+ * Hardware:
+ * - ESP32 (any variant with hardware UART)
+ * - RD-03D radar connected to Serial1 (RX=20, TX=21)
+ */
+
+#include <RD03D.h>
+#include <RD03D_BlackBox.h>
+
+#define RADAR_RX_PIN 20
+#define RADAR_TX_PIN 21
+
+// 64 frames is roughly 1.5-3 seconds of history at 20-50 Hz
+#define BLACKBOX_FRAMES 64
+#define POST_TRIGGER_FRAMES 16
+
+RD03D radar;
+RD03D_BlackBoxEntry blackBoxStorage[BLACKBOX_FRAMES];
+RD03D_BlackBox blackBox(blackBoxStorage, BLACKBOX_FRAMES, POST_TRIGGER_FRAMES);
+
+/**
+ * Flush callback - writes one recorded frame per line.
+ * Returning false would retry the same entry on the next service() call.
+ */
+bool printEntry(const RD03D_BlackBoxEntry& entry, uint16_t index, uint16_t total) {
+    if (index == 0) {
+        Serial.printf("# Black box dump, reason %d, %d frames\n",
+                      blackBox.getTriggerReason(), total);
+    }
+
+    Serial.printf("#bb,%u,%u,%lu,%u,", index, total,
+                  (unsigned long)entry.timestamp, entry.flags);
+    for (int i = 0; i < RD03D_FRAME_SIZE; i++) {
+        Serial.printf("%02X", entry.raw[i]);
+    }
+    Serial.println();
+    return true;
+}
+
+void onRadarFrame(RD03D_Target* targets, uint8_t count) {
+    for (int i = 0; i < RD03D_MAX_TARGETS; i++) {
+        if (targets[i].valid && targets[i].distance < 50.0f) {
+            blackBox.trigger(RD03D_TRIGGER_EVENT);
+        }
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("# RD-03D Black Box Recorder");
+
+    radar.begin(Serial1, RADAR_RX_PIN, RADAR_TX_PIN);
+    radar.onFrame(onRadarFrame);
+    radar.attachBlackBox(&blackBox);
+
+    blackBox.onFlush(printEntry);
+    blackBox.setErrorTrigger(5, 1000);
+
+    Serial.println("# Send 't' to trigger a dump");
+}
+
+void loop() {
+    radar.update();
+
+    // Manual trigger from Serial Monitor
+    if (Serial.available() && Serial.read() == 't') {
+        blackBox.trigger(RD03D_TRIGGER_MANUAL);
+    }
+
+    // Flush a few entries per loop so the radar is never starved
+    blackBox.service();
+}
@@ -0,0 +1,129 @@
+/**
+ * ConfigOverWiFi.ino
+ *
+ * Updates the site configuration while the radar keeps running. Blobs
+ * built by extras/host/mkconfig are sent as single UDP datagrams:
+ *
+ *   ./mkconfig site.txt -o site.bin
+ *   socat -u FILE:site.bin UDP-DATAGRAM:<esp32-ip>:9000
+ *
+ * Each blob is written into a shadow buffer, validated, and swapped in by
+ * the radar between two frames, so no frame is lost or handled with a
+ * half-applied config. The tracker and mounting pose follow when the
+ * version changes.
+ *
+ * Output (one line per confirmed track, in site coordinates: the blob's
+ * mounting pose applied to the sensor-frame track):
+ *   config_version,id,x_mm,y_mm
+ *
+ * Hardware:
+ * - ESP32 with WiFi
+ * - RD-03D radar connected to Serial1 (RX=20, TX=21)
+ */
+
+#include <RD03D.h>
+#include <RD03D_Config.h>
+#include <RD03D_Tracker.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+
+// ============== CONFIGURATION ==============
+
+// WiFi credentials - EDIT THESE!
+const char* WIFI_SSID = "YourNetworkName";
+const char* WIFI_PASSWORD = "YourPassword";
+
+#define RADAR_RX_PIN 20
+#define RADAR_TX_PIN 21
+#define CONFIG_PORT  9000
+#define CONFIG_MAX   1024
+
+// ============== GLOBALS ==============
+
+RD03D radar;
+RD03D_Tracker tracker;
+WiFiUDP udp;
+
+alignas(4) uint8_t configA[CONFIG_MAX];
+alignas(4) uint8_t configB[CONFIG_MAX];
+RD03D_ConfigShadow shadow(radar, configA, configB, CONFIG_MAX);
+
+RD03D_Pose pose;    // Sensor to site frame, identity if the blob has none
+uint32_t trackerConfigVersion = 0;
+
+// ============== RADAR ==============
+
+void onRadarFrame(RD03D_Target* targets, uint8_t count) {
+    // The version is fixed for the whole frame
+    uint32_t version = radar.getConfigVersion();
+    if (version != trackerConfigVersion) {
+        const RD03D_ConfigBlob* blob = radar.getConfig();
+        RD03D_TrackerConfig config;
+        if (blob && blob->getTrackerConfig(config)) {
+            tracker.setConfig(config);
+        }
+        if (!blob || !blob->getPose(pose)) pose.setIdentity();
+        trackerConfigVersion = version;
+    }
+
+    // Track in the sensor frame, report in the site frame
+    tracker.update(targets, millis());
+
+    for (int i = 0; i < RD03D_MAX_TRACKS; i++) {
+        RD03D_Track* t = tracker.getTrack(i);
+        if (!t->isValid()) continue;
+
+        float x, y;
+        pose.apply(t->x, t->y, x, y);
+        Serial.printf("%u,%u,%.0f,%.0f\n", version, t->id, x, y);
+    }
+}
+
+// ============== CONFIG UPDATES ==============
+
+void pollConfig() {
+    int size = udp.parsePacket();
+    if (size <= 0) return;
+
+    uint8_t* buffer = shadow.getBuffer();
+    if (!buffer) {
+        udp.flush();   // Previous update still waiting for a frame
+        Serial.println("# Config busy, resend later");
+        return;
+    }
+
+    int len = udp.read(buffer, shadow.getCapacity());
+    RD03D_ConfigError err = shadow.commit(len);
+    if (err == RD03D_CONFIG_OK) {
+        Serial.println("# Config staged, active from next frame");
+    } else {
+        Serial.printf("# Config rejected (error %d)\n", err);
+    }
+}
+
+// ============== SETUP & LOOP ==============
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("# RD-03D Config over WiFi Example");
+
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    while (WiFi.status() != WL_CONNECTED) {
+        delay(100);
+    }
+    Serial.print("# Send configs to ");
+    Serial.print(WiFi.localIP());
+    Serial.printf(":%d\n", CONFIG_PORT);
+    udp.begin(CONFIG_PORT);
+
+    pose.setIdentity();
+    radar.begin(Serial1, RADAR_RX_PIN, RADAR_TX_PIN);
+    radar.onFrame(onRadarFrame);
+}
+
+void loop() {
+    radar.update();
+    pollConfig();
+}
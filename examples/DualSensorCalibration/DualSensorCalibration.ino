@@ -0,0 +1,101 @@
+/**
+ * DualSensorCalibration.ino
+ *
+ * Finds the mounting pose of a second radar relative to the first,
+ * instead of measuring it with a tape. Walk slowly through the area
+ * both radars can see (alone!) for a minute or two, covering as much
+ * of the shared area as possible. The solved pose is printed every few
+ * seconds and can be pasted into your sketch as an RD03D_Pose.
+ *
+ * Once solved, radar B's targets are also printed in radar A's frame.
+ *
+ * Hardware:
+ * - ESP32 with two free hardware UARTs (ESP32, ESP32-S3)
+ * - Radar A on Serial1 (RX=20, TX=21)
+ * - Radar B on Serial2 (RX=16, TX=17)
+ */
+
+#include <RD03D.h>
+#include <RD03D_Calibration.h>
+
+#define RADAR_A_RX_PIN 20
+#define RADAR_A_TX_PIN 21
+#define RADAR_B_RX_PIN 16
+#define RADAR_B_TX_PIN 17
+
+// Frames closer together than this are treated as simultaneous
+#define PAIR_TOLERANCE_MS 30
+
+#define MAX_PAIRS 300
+
+RD03D radarA;
+RD03D radarB;
+
+RD03D_CalibrationPair pairs[MAX_PAIRS];
+RD03D_Calibration calibration(pairs, MAX_PAIRS);
+RD03D_Pose poseB;
+bool poseSolved = false;
+
+RD03D_Target lastB[RD03D_MAX_TARGETS];
+uint32_t lastBTime = 0;
+
+void onRadarB(RD03D_Target* targets, uint8_t count) {
+    for (int i = 0; i < RD03D_MAX_TARGETS; i++) {
+        lastB[i] = targets[i];
+    }
+    lastBTime = millis();
+}
+
+void onRadarA(RD03D_Target* targets, uint8_t count) {
+    if (millis() - lastBTime > PAIR_TOLERANCE_MS) return;
+    calibration.addFrames(targets, lastB);
+
+    if (poseSolved) {
+        for (int i = 0; i < RD03D_MAX_TARGETS; i++) {
+            RD03D_Target t = lastB[i];
+            poseB.apply(t);
+            if (t.valid) {
+                Serial.printf("B%d in A frame: %d, %d mm\n", i + 1, t.x, t.y);
+            }
+        }
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("=== RD-03D Dual Sensor Calibration ===");
+    Serial.println("Walk alone through the area both radars can see.");
+
+    radarA.begin(Serial1, RADAR_A_RX_PIN, RADAR_A_TX_PIN);
+    radarB.begin(Serial2, RADAR_B_RX_PIN, RADAR_B_TX_PIN);
+    radarA.onFrame(onRadarA);
+    radarB.onFrame(onRadarB);
+
+    for (int i = 0; i < RD03D_MAX_TARGETS; i++) {
+        lastB[i].clear();
+    }
+}
+
+void loop() {
+    // Read B first so A's callback pairs with the newest B frame
+    radarB.update();
+    radarA.update();
+
+    static uint32_t lastSolve = 0;
+    if (millis() - lastSolve > 5000) {
+        lastSolve = millis();
+
+        if (calibration.solve(poseB)) {
+            poseSolved = true;
+            Serial.printf("Pose: RD03D_Pose poseB = {%.1ff, %.1ff, %.2ff};  "
+                          "inliers %u/%u, RMS %.0f mm\n",
+                          poseB.x, poseB.y, poseB.theta,
+                          calibration.getInlierCount(), calibration.getCount(),
+                          calibration.getRmsError());
+        } else {
+            Serial.printf("Collecting: %u pairs (need %d, spread out over the area)\n",
+                          calibration.getCount(), RD03D_CALIB_MIN_PAIRS);
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * Gestures.ino
+ *
+ * Recognises body gestures on the ESP32 itself: a brisk step or swipe
+ * left/right, towards or away from the radar, plus a custom "wave"
+ * (right then back left). Each track's velocity is matched against the
+ * gesture templates with streaming DTW as frames arrive, so an event is
+ * printed on the frame that completes the gesture.
+ *
+ * Output (one line per gesture):
+ *   gesture,track_id,duration_ms,cost
+ *
+ * Hardware:
+ * - ESP32 (any variant with hardware UART)
+ * - RD-03D radar connected to Serial1 (RX=20, TX=21)
+ */
+
+#include <RD03D.h>
+#include <RD03D_Tracker.h>
+#include <RD03D_Gesture.h>
+
+#define RADAR_RX_PIN 20
+#define RADAR_TX_PIN 21
+
+RD03D radar;
+RD03D_Tracker tracker;
+RD03D_GestureRecognizer gestures;
+
+// X velocity every 100 ms in units of 100 mm/s: right, stop, back left
+const int8_t WAVE_VX[9] = {0, 6, 10, 6, 0, -6, -10, -6, 0};
+const int8_t WAVE_VY[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+void onGesture(const RD03D_GestureEvent& event) {
+    Serial.printf("%s,%u,%u,%.2f\n", gestures.getName(event.gesture), event.trackId,
+                  event.duration, event.cost);
+}
+
+void onRadarFrame(RD03D_Target* targets, uint8_t count) {
+    tracker.update(targets, millis());
+    gestures.update(tracker, millis());
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("# RD-03D Gestures Example");
+
+    gestures.addDefaultGestures();
+    gestures.addGesture("wave", WAVE_VX, WAVE_VY, 9, 6.0f);
+    gestures.onGesture(onGesture);
+
+    radar.begin(Serial1, RADAR_RX_PIN, RADAR_TX_PIN);
+    radar.onFrame(onRadarFrame);
+}
+
+void loop() {
+    radar.update();
+}
@@ -10,19 +10,21 @@
  *   /radar/3  (x, y, distance, angle, speed)  - Target 3
  *   /radar/count  (count)                      - Number of valid targets
  * 
+ * Messages are encoded with RD03D_OSCEncoder, which needs no OSC
+ * library and never touches the heap (safe for months of uptime).
+ * 
  * Hardware:
  * - ESP32 with WiFi (ESP32, ESP32-S2, ESP32-S3, ESP32-C3, etc.)
  * - RD-03D radar connected to Serial1
  * 
  * Dependencies:
  * - WiFi library (built into ESP32 Arduino core)
- * - OSC library by Adrian Freed (install via Library Manager)
  */
 
 #include <RD03D.h>
 #include <WiFi.h>
 #include <WiFiUdp.h>
-#include <OSCMessage.h>
+#include <RD03D_OSC.h>
 
 // ============== CONFIGURATION ==============
 
@@ -49,6 +51,10 @@ WiFiUDP udp;
 bool wifiConnected = false;
 uint32_t lastOscTime = 0;
 
+// OSC messages are built in a fixed buffer: nothing is allocated per frame
+RD03D_OSCEncoder osc;
+uint8_t oscPacket[RD03D_OSC_MAX_MESSAGE];
+
 // ============== WIFI SETUP ==============
 
 void connectWiFi() {
@@ -103,28 +109,17 @@ void sendOSC(RD03D_Target* targets, uint8_t count) {
     // Send each valid target
     for (int i = 0; i < 3; i++) {
         if (targets[i].valid) {
-            char address[20];
-            snprintf(address, sizeof(address), "/radar/%d", i + 1);
-            
-            OSCMessage msg(address);
-            msg.add((int32_t)targets[i].x);
-            msg.add((int32_t)targets[i].y);
-            msg.add(targets[i].distance);
-            msg.add(targets[i].angle);
-            msg.add((int32_t)targets[i].speed);
-            
+            size_t len = osc.encodeTarget(i, targets[i], oscPacket, sizeof(oscPacket));
             udp.beginPacket(oscTargetIP, oscTargetPort);
-            msg.send(udp);
+            udp.write(oscPacket, len);
             udp.endPacket();
-            msg.empty();
         }
     }
     
     // Send target count
-    OSCMessage countMsg("/radar/count");
-    countMsg.add((int32_t)count);
+    size_t len = osc.encodeCount(count, oscPacket, sizeof(oscPacket));
     udp.beginPacket(oscTargetIP, oscTargetPort);
-    countMsg.send(udp);
+    udp.write(oscPacket, len);
     udp.endPacket();
 }
 
@@ -0,0 +1,63 @@
+/**
+ * OccupancyLevels.ino
+ *
+ * Drops to a minimal processing level while the room is empty. After
+ * 30 s without a valid target the radar keeps decoding every frame but
+ * only delivers one empty frame in ten (a presence heartbeat), and the
+ * sketch skips its heavy work and naps between updates. The first frame
+ * with a target restores the full level and is delivered immediately.
+ *
+ * Output:
+ *   # level full|idle
+ *   <count>,<x_mm>,<y_mm>   (first target, full level only)
+ *   # heartbeat             (idle level, ~1 per second)
+ *
+ * Hardware:
+ * - ESP32 (any variant with hardware UART)
+ * - RD-03D radar connected to Serial1 (RX=20, TX=21)
+ */
+
+#include <RD03D.h>
+
+#define RADAR_RX_PIN 20
+#define RADAR_TX_PIN 21
+
+#define IDLE_AFTER_MS 30000
+
+RD03D radar;
+
+void onLevel(uint8_t level) {
+    Serial.println(level == RD03D_LEVEL_IDLE ? "# level idle" : "# level full");
+}
+
+void onRadarFrame(RD03D_Target* targets, uint8_t count) {
+    if (radar.isIdle()) {
+        Serial.println("# heartbeat");
+        return;
+    }
+
+    // Full pipeline: analytics, network output...
+    if (count > 0) {
+        Serial.printf("%u,%d,%d\n", count, targets[0].x, targets[0].y);
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("# RD-03D Occupancy Levels Example");
+
+    radar.begin(Serial1, RADAR_RX_PIN, RADAR_TX_PIN);
+    radar.onFrame(onRadarFrame);
+    radar.onLevelChange(onLevel);
+    radar.setIdleTimeout(IDLE_AFTER_MS);
+}
+
+void loop() {
+    radar.update();
+
+    // Frames are only 30 bytes, so a short nap never overflows the UART
+    if (radar.isIdle()) {
+        delay(10);
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * Pipeline.ino
+ *
+ * Builds the frame processing as a compile-time pipeline:
+ *   validate -> track -> zone count -> print
+ *
+ * The stages are chained with RD03D_Pipeline, so the whole chain is
+ * inlined into the frame callback (NearStage and PrintStage define
+ * process() in the class, like the built-in stages). Per-stage timing is
+ * printed every 5 seconds:
+ *   # stage runs stops avg_us max_us
+ *
+ * Hardware:
+ * - ESP32 (any variant with hardware UART)
+ * - RD-03D radar connected to Serial1 (RX=20, TX=21)
+ */
+
+#include <RD03D.h>
+#include <RD03D_Pipeline.h>
+#include <RD03D_Tracker.h>
+
+#define RADAR_RX_PIN 20
+#define RADAR_TX_PIN 21
+
+// ============== USER STAGES ==============
+
+// Counts confirmed tracks closer than 1.5 m
+class NearStage {
+public:
+    uint8_t nearCount = 0;
+
+    bool process(RD03D_FrameContext& ctx) {
+        nearCount = 0;
+        for (int i = 0; i < RD03D_MAX_TRACKS; i++) {
+            RD03D_Track* t = ctx.tracker->getTrack(i);
+            if (t->isValid() && t->y < 1500) nearCount++;
+        }
+        return true;
+    }
+    const char* name() const { return "near"; }
+};
+
+class PrintStage {
+public:
+    explicit PrintStage(NearStage& near) : _near(near) {}
+
+    bool process(RD03D_FrameContext& ctx) {
+        for (int i = 0; i < RD03D_MAX_TRACKS; i++) {
+            RD03D_Track* t = ctx.tracker->getTrack(i);
+            if (t->isValid()) {
+                Serial.printf("%u,%.0f,%.0f,%u\n", t->id, t->x, t->y, _near.nearCount);
+            }
+        }
+        return true;
+    }
+    const char* name() const { return "print"; }
+
+private:
+    NearStage& _near;
+};
+
+// ============== PIPELINE ==============
+
+RD03D radar;
+RD03D_Tracker tracker;
+
+RD03D_ValidateStage validateStage(600, 55);   // 6 m, ±55°
+RD03D_TrackStage trackStage(tracker);
+NearStage nearStage;
+PrintStage printStage(nearStage);
+
+RD03D_Pipeline<RD03D_ValidateStage, RD03D_TrackStage, NearStage, PrintStage>
+    pipeline(validateStage, trackStage, nearStage, printStage);
+
+uint32_t lastStats = 0;
+
+void onRadarFrame(RD03D_Target* targets, uint8_t count) {
+    pipeline.process(targets, count);
+}
+
+// ============== SETUP & LOOP ==============
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("# RD-03D Pipeline Example");
+
+    radar.begin(Serial1, RADAR_RX_PIN, RADAR_TX_PIN);
+    radar.onFrame(onRadarFrame);
+}
+
+void loop() {
+    radar.update();
+
+    if (millis() - lastStats >= 5000) {
+        lastStats = millis();
+        for (uint8_t i = 0; i < pipeline.getStageCount(); i++) {
+            const RD03D_StageTiming* t = pipeline.getTiming(i);
+            Serial.printf("# %s %lu %lu %lu %lu\n", t->name, t->runs, t->stops, t->avgMicros, t->maxMicros);
+        }
+    }
+}
@@ -0,0 +1,105 @@
+/**
+ * Scheduler.ino
+ *
+ * Runs per-frame processing through RD03D_Scheduler. Tracking and output
+ * are mandatory and run every frame; the heatmap and clutter stages are
+ * optional and only run when the frame's time budget allows, so a slow
+ * loop never makes the radar's UART buffer overflow.
+ *
+ * Stage statistics are printed every 5 seconds:
+ *   # stage runs deferred skipped decimated avg_us max_us
+ *
+ * Hardware:
+ * - ESP32 (any variant with hardware UART)
+ * - RD-03D radar connected to Serial1 (RX=20, TX=21)
+ */
+
+#include <RD03D.h>
+#include <RD03D_Scheduler.h>
+#include <RD03D_Tracker.h>
+
+#define RADAR_RX_PIN 20
+#define RADAR_TX_PIN 21
+
+#define HEATMAP_CELLS 16   // 16 x 16 cells of 50 cm over 8 m x 8 m
+
+RD03D radar;
+RD03D_Tracker tracker;
+RD03D_Scheduler scheduler;
+
+uint16_t heatmap[HEATMAP_CELLS][HEATMAP_CELLS];
+uint16_t clutter[HEATMAP_CELLS][HEATMAP_CELLS];
+uint32_t lastStats = 0;
+
+// ============== STAGES ==============
+
+void trackStage(RD03D_Target* targets, uint8_t count) {
+    tracker.update(targets, millis());
+}
+
+void outputStage(RD03D_Target* targets, uint8_t count) {
+    for (int i = 0; i < RD03D_MAX_TRACKS; i++) {
+        RD03D_Track* t = tracker.getTrack(i);
+        if (t->isValid()) {
+            Serial.printf("%u,%.0f,%.0f\n", t->id, t->x, t->y);
+        }
+    }
+}
+
+void heatmapStage(RD03D_Target* targets, uint8_t count) {
+    for (int i = 0; i < RD03D_MAX_TARGETS; i++) {
+        if (!targets[i].valid) continue;
+        int cx = constrain((targets[i].x + 4000) / 500, 0, HEATMAP_CELLS - 1);
+        int cy = constrain(targets[i].y / 500, 0, HEATMAP_CELLS - 1);
+        if (heatmap[cy][cx] < 0xFFFF) heatmap[cy][cx]++;
+    }
+}
+
+void clutterStage(RD03D_Target* targets, uint8_t count) {
+    // Slow decay of the whole grid - the expensive part
+    for (int y = 0; y < HEATMAP_CELLS; y++) {
+        for (int x = 0; x < HEATMAP_CELLS; x++) {
+            clutter[y][x] = (clutter[y][x] * 15 + heatmap[y][x]) / 16;
+        }
+    }
+}
+
+// ============== SETUP & LOOP ==============
+
+void onRadarFrame(RD03D_Target* targets, uint8_t count) {
+    scheduler.runFrame(targets, count);
+}
+
+void printStats() {
+    Serial.printf("# period %lu us, overruns %lu\n", scheduler.getFramePeriod(), scheduler.getOverrunCount());
+    for (uint8_t i = 0; i < scheduler.getStageCount(); i++) {
+        const RD03D_StageStats* s = scheduler.getStage(i);
+        Serial.printf("# %s %lu %lu %lu %lu %lu %lu\n", s->name, s->runs, s->deferred,
+                      s->skipped, s->decimated, s->avgMicros, s->maxMicros);
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("# RD-03D Scheduler Example");
+
+    scheduler.addStage("track", trackStage, true);
+    scheduler.addStage("output", outputStage, true);
+    scheduler.addStage("heatmap", heatmapStage, false);
+    scheduler.addStage("clutter", clutterStage, false, 10);   // At most every 10th frame
+    scheduler.setBudget(60);   // Leave 40% of each frame for UART and WiFi
+
+    radar.begin(Serial1, RADAR_RX_PIN, RADAR_TX_PIN);
+    radar.onFrame(onRadarFrame);
+}
+
+void loop() {
+    radar.update();
+    scheduler.runDeferred();
+
+    if (millis() - lastStats >= 5000) {
+        lastStats = millis();
+        printStats();
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ * SiteConfig.ino
+ *
+ * Boots from a precompiled binary site configuration instead of parsing
+ * text. site_config.h is generated on the host from site.txt:
+ *
+ *   ./mkconfig site.txt -c site_config.h
+ *
+ * The blob lives in flash and is only CRC-checked at boot, then read in
+ * place: mounting pose, tracker settings, zones and tripwires.
+ *
+ * Output (one line per confirmed track):
+ *   id,x_mm,y_mm,zone_id (0 = no zone)
+ *
+ * Hardware:
+ * - ESP32 (any variant with hardware UART)
+ * - RD-03D radar connected to Serial1 (RX=20, TX=21)
+ */
+
+#include <RD03D.h>
+#include <RD03D_Config.h>
+#include <RD03D_Tracker.h>
+#include "site_config.h"
+
+#define RADAR_RX_PIN 20
+#define RADAR_TX_PIN 21
+
+RD03D radar;
+RD03D_Tracker tracker;
+RD03D_ConfigBlob config;
+RD03D_Pose pose;    // Sensor to site frame, identity if the blob has none
+
+uint8_t zoneAt(float x, float y) {
+    for (uint16_t i = 0; i < config.getRegionCount(); i++) {
+        const RD03D_ConfigRegion* r = config.getRegion(i);
+        if (r->type != RD03D_REGION_ZONE) continue;
+        if (x >= min(r->x0, r->x1) && x <= max(r->x0, r->x1) &&
+            y >= min(r->y0, r->y1) && y <= max(r->y0, r->y1)) {
+            return r->id;
+        }
+    }
+    return 0;
+}
+
+void onRadarFrame(RD03D_Target* targets, uint8_t count) {
+    // Track in the sensor frame so range and beam limits see the real
+    // geometry, then move each track into the site frame for the zones
+    tracker.update(targets, millis());
+
+    for (int i = 0; i < RD03D_MAX_TRACKS; i++) {
+        RD03D_Track* t = tracker.getTrack(i);
+        if (!t->isValid()) continue;
+
+        float x, y;
+        pose.apply(t->x, t->y, x, y);
+        Serial.printf("%u,%.0f,%.0f,%u\n", t->id, x, y, zoneAt(x, y));
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("# RD-03D Site Config Example");
+
+    pose.setIdentity();
+    uint32_t start = micros();
+    RD03D_ConfigError err = config.load(siteConfig, sizeof(siteConfig));
+    if (err != RD03D_CONFIG_OK) {
+        Serial.printf("# Config rejected (error %d), using defaults\n", err);
+    } else {
+        radar.applyConfig(&config);
+        if (!config.getPose(pose)) pose.setIdentity();
+
+        RD03D_TrackerConfig trackerConfig;
+        if (config.getTrackerConfig(trackerConfig)) {
+            tracker.setConfig(trackerConfig);
+        }
+        Serial.printf("# Config revision %u, %u regions, ready in %lu us\n",
+                      config.getVersion(), config.getRegionCount(), micros() - start);
+    }
+
+    radar.begin(Serial1, RADAR_RX_PIN, RADAR_TX_PIN);
+    radar.onFrame(onRadarFrame);
+}
+
+void loop() {
+    radar.update();
+}
@@ -0,0 +1,15 @@
+// Generated by extras/host/mkconfig - site revision 3, 96 bytes
+#pragma once
+
+#include <stdint.h>
+
+alignas(4) static const uint8_t siteConfig[96] = {
+    0x52, 0x44, 0x33, 0x44, 0xC5, 0xE8, 0x7E, 0x9C, 0x01, 0x00, 0x20, 0x00, 
+    0x60, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x20, 0x00, 0x28, 0x00, 
+    0x48, 0x00, 0x02, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x64, 0x00, 0x03, 0x00, 
+    0x00, 0x80, 0xBB, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xC1, 
+    0x00, 0x00, 0x48, 0x44, 0x00, 0x00, 0x70, 0x42, 0x00, 0x00, 0xFA, 0x43, 
+    0x9A, 0x99, 0x19, 0x3F, 0xCD, 0xCC, 0x4C, 0x3E, 0x06, 0x02, 0x00, 0x00, 
+    0x01, 0x01, 0x00, 0x00, 0x18, 0xFC, 0xF4, 0x01, 0xE8, 0x03, 0xC4, 0x09, 
+    0x02, 0x02, 0x00, 0x00, 0x24, 0xFA, 0xB8, 0x0B, 0xDC, 0x05, 0xB8, 0x0B
+};
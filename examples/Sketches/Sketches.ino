@@ -0,0 +1,113 @@
+/**
+ * Sketches.ino
+ *
+ * Summarises walking speed and zone dwell time on the device with
+ * fixed-memory quantile sketches, and ships one small sketch of each per
+ * hour instead of raw samples. The host merges the hourly sketches of
+ * any number of sensors and reports medians and 95th percentiles:
+ *
+ *   ./sketches -q 0.5,0.95 serial_log.txt
+ *
+ * Speed is added every frame for each confirmed, moving track. Dwell is
+ * added when a track leaves ZONE (or is lost while inside it).
+ *
+ * Output (once per REPORT_MS):
+ *   sketch,speed,<hex>
+ *   sketch,dwell,<hex>
+ *
+ * Hardware:
+ * - ESP32 (any variant with hardware UART)
+ * - RD-03D radar connected to Serial1 (RX=20, TX=21)
+ */
+
+#include <RD03D.h>
+#include <RD03D_Tracker.h>
+#include <RD03D_Sketch.h>
+
+#define RADAR_RX_PIN 20
+#define RADAR_TX_PIN 21
+
+#define REPORT_MS       3600000UL   // One sketch of each per hour
+#define MIN_WALK_SPEED  100.0f      // mm/s; slower tracks are standing, not walking
+
+// Dwell zone in mm (sensor frame)
+#define ZONE_X0 -1000
+#define ZONE_X1 1000
+#define ZONE_Y0 1000
+#define ZONE_Y1 3000
+
+RD03D radar;
+RD03D_Tracker tracker;
+RD03D_QuantileSketch speeds(50, 5000);      // mm/s, ±1.9%
+RD03D_QuantileSketch dwells(1, 4 * 3600);   // s, ±3.9%
+
+// Per track slot: which track is in the zone and since when
+uint16_t zoneTrack[RD03D_MAX_TRACKS];
+uint32_t zoneEnter[RD03D_MAX_TRACKS];
+
+uint32_t lastReport = 0;
+
+bool inZone(const RD03D_Track* t) {
+    return t->x >= ZONE_X0 && t->x <= ZONE_X1 && t->y >= ZONE_Y0 && t->y <= ZONE_Y1;
+}
+
+void onRadarFrame(RD03D_Target* targets, uint8_t count) {
+    uint32_t now = millis();
+    tracker.update(targets, now);
+
+    for (int i = 0; i < RD03D_MAX_TRACKS; i++) {
+        RD03D_Track* t = tracker.getTrack(i);
+        bool valid = t->isValid();
+
+        if (valid && t->missed == 0) {
+            float speed = sqrtf(t->vx * t->vx + t->vy * t->vy);
+            if (speed >= MIN_WALK_SPEED) speeds.add(speed);
+        }
+
+        // A visit ends when the track leaves the zone or the slot moves on
+        bool inside = valid && inZone(t);
+        if (zoneTrack[i] != 0 && (!inside || t->id != zoneTrack[i])) {
+            dwells.add((now - zoneEnter[i]) / 1000.0f);
+            zoneTrack[i] = 0;
+        }
+        if (inside && zoneTrack[i] == 0) {
+            zoneTrack[i] = t->id;
+            zoneEnter[i] = now;
+        }
+    }
+}
+
+void printSketch(const char* name, RD03D_QuantileSketch& sketch) {
+    uint8_t blob[RD03D_SKETCH_MAX_SIZE];
+    size_t len = sketch.serialize(blob, sizeof(blob));
+
+    Serial.printf("sketch,%s,", name);
+    for (size_t i = 0; i < len; i++) {
+        Serial.printf("%02x", blob[i]);
+    }
+    Serial.println();
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("# RD-03D Quantile Sketches Example");
+
+    radar.begin(Serial1, RADAR_RX_PIN, RADAR_TX_PIN);
+    radar.onFrame(onRadarFrame);
+}
+
+void loop() {
+    radar.update();
+
+    if (millis() - lastReport >= REPORT_MS) {
+        lastReport = millis();
+        Serial.printf("# %u speeds (median %.0f mm/s), %u visits (median %.0f s)\n",
+                      (unsigned)speeds.getCount(), speeds.quantile(0.5f),
+                      (unsigned)dwells.getCount(), dwells.quantile(0.5f));
+        printSketch("speed", speeds);
+        printSketch("dwell", dwells);
+        speeds.clear();
+        dwells.clear();
+    }
+}
@@ -0,0 +1,54 @@
+/**
+ * Tracker.ino
+ *
+ * Uses RD03D_Tracker to turn raw radar slots into stable tracks.
+ * The radar can swap slot order or drop a target for a frame; the
+ * tracker keeps the same ID for each person and smooths the position.
+ *
+ * Output (one line per confirmed track):
+ *   id,x_mm,y_mm,vx_mm_s,vy_mm_s
+ *
+ * Hardware:
+ * - ESP32 (any variant with hardware UART)
+ * - RD-03D radar connected to Serial1 (RX=20, TX=21)
+ */
+
+#include <RD03D.h>
+#include <RD03D_Tracker.h>
+
+#define RADAR_RX_PIN 20
+#define RADAR_TX_PIN 21
+
+RD03D radar;
+RD03D_Tracker tracker;
+
+void onRadarFrame(RD03D_Target* targets, uint8_t count) {
+    tracker.update(targets, millis());
+
+    for (int i = 0; i < RD03D_MAX_TRACKS; i++) {
+        RD03D_Track* t = tracker.getTrack(i);
+        if (!t->isValid()) continue;
+
+        Serial.printf("%u,%.0f,%.0f,%.0f,%.0f\n", t->id, t->x, t->y, t->vx, t->vy);
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("# RD-03D Tracker Example");
+
+    // Optional tuning - defaults suit a person walking in a room
+    RD03D_TrackerConfig config;
+    config.setDefaults();
+    config.maxRangeCm = 600;   // Ignore anything beyond 6 m
+    config.coastFrames = 8;    // Keep tracks through longer dropouts
+    tracker.setConfig(config);
+
+    radar.begin(Serial1, RADAR_RX_PIN, RADAR_TX_PIN);
+    radar.onFrame(onRadarFrame);
+}
+
+void loop() {
+    radar.update();
+}
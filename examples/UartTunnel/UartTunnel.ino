@@ -0,0 +1,99 @@
+/**
+ * UartTunnel.ino
+ *
+ * Minimal node for central parsing: forwards the radar's raw UART bytes
+ * over WiFi in batched UDP datagrams (sequence number plus arrival time
+ * of every batch) and decodes nothing itself. The host parses every
+ * sensor as if it were plugged in locally:
+ *
+ *   ./tunnel -p 9000              # frames as CSV, prefixed with NODE_ID
+ *   ./tunnel -p 9000 --pty        # plus a pseudo terminal per sensor
+ *
+ * Give every node its own NODE_ID. Tracking, zones and everything else
+ * run on the host, so they can be upgraded without touching the nodes.
+ *
+ * Output (every 10 s):
+ *   [Status] Bytes: 123456, Datagrams: 2345, Dropped: 0, WiFi: OK
+ *
+ * Hardware:
+ * - ESP32 with WiFi (ESP32, ESP32-S2, ESP32-S3, ESP32-C3, etc.)
+ * - RD-03D radar connected to Serial1 (RX=20, TX=21)
+ */
+
+#include <RD03D.h>
+#include <RD03D_Tunnel.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+
+// ============== CONFIGURATION ==============
+
+// WiFi credentials - EDIT THESE!
+const char* WIFI_SSID = "YourNetworkName";
+const char* WIFI_PASSWORD = "YourPassword";
+
+// Radar pins
+#define RADAR_RX_PIN 20
+#define RADAR_TX_PIN 21
+
+#define NODE_ID 1
+
+// Host running extras/host/tunnel
+IPAddress hostIP(192, 168, 1, 100);
+const uint16_t hostPort = 9000;
+
+// ============== GLOBALS ==============
+
+RD03D radar;
+RD03D_Tunnel tunnel(NODE_ID);
+WiFiUDP udp;
+
+// ============== TUNNEL SEND ==============
+
+bool sendDatagram(const uint8_t* datagram, size_t len) {
+    // A failed send is a lost datagram; the host resyncs its parser
+    if (WiFi.status() != WL_CONNECTED) return false;
+    udp.beginPacket(hostIP, hostPort);
+    udp.write(datagram, len);
+    return udp.endPacket();
+}
+
+// ============== SETUP ==============
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== RD-03D UART Tunnel ===\n");
+
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    Serial.printf("Connecting to WiFi: %s", WIFI_SSID);
+    for (int i = 0; i < 100 && WiFi.status() != WL_CONNECTED; i++) {
+        delay(100);
+        Serial.print(".");
+    }
+    Serial.println(WiFi.status() == WL_CONNECTED ? "\nWiFi connected!" : "\nWiFi connection failed!");
+    udp.begin(hostPort);
+
+    radar.begin(Serial1, RADAR_RX_PIN, RADAR_TX_PIN);
+    tunnel.onSend(sendDatagram);
+    radar.attachTunnel(&tunnel);    // Forward only: no frames are decoded here
+
+    Serial.printf("Tunnelling sensor %d to %s:%d\n", NODE_ID, hostIP.toString().c_str(), hostPort);
+}
+
+// ============== LOOP ==============
+
+void loop() {
+    radar.update();
+
+    static uint32_t lastStatus = 0;
+    if (millis() - lastStatus > 10000) {
+        lastStatus = millis();
+        if (WiFi.status() != WL_CONNECTED) WiFi.reconnect();
+        Serial.printf("[Status] Bytes: %lu, Datagrams: %lu, Dropped: %lu, WiFi: %s\n",
+                      (unsigned long)tunnel.getByteCount(),
+                      (unsigned long)tunnel.getSentCount(),
+                      (unsigned long)tunnel.getDroppedCount(),
+                      WiFi.status() == WL_CONNECTED ? "OK" : "DISCONNECTED");
+    }
+}
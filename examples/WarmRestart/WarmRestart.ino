@@ -0,0 +1,99 @@
+/**
+ * WarmRestart.ino
+ *
+ * Keeps tracks and IDs across watchdog resets, esp_restart() and deep
+ * sleep. The tracker state is saved into RTC memory that is not cleared
+ * at boot (RTC_NOINIT_ATTR) after every frame and from a shutdown
+ * handler; at boot it is restored if it is intact and less than
+ * MAX_STATE_AGE_MS old, so downstream systems see the same people carry
+ * on instead of everyone leaving and re-entering.
+ *
+ * The state is stamped with gettimeofday(), which the ESP32 keeps
+ * running across deep sleep and software resets. After a power cycle
+ * the RTC memory holds garbage, which the CRC rejects.
+ *
+ * Output (one line per confirmed track):
+ *   id,x_mm,y_mm
+ *
+ * Hardware:
+ * - ESP32 (any variant with hardware UART and RTC memory)
+ * - RD-03D radar connected to Serial1 (RX=20, TX=21)
+ */
+
+#include <RD03D.h>
+#include <RD03D_Tracker.h>
+#include <esp_sleep.h>
+#include <esp_system.h>
+#include <sys/time.h>
+
+#define RADAR_RX_PIN 20
+#define RADAR_TX_PIN 21
+
+#define MAX_STATE_AGE_MS 5000   // Older state is discarded (people may have left)
+
+RD03D radar;
+RD03D_Tracker tracker;
+
+// Survives resets and deep sleep, not power cycles
+RTC_NOINIT_ATTR uint32_t savedState[(RD03D_TRACKER_STATE_SIZE + 3) / 4];
+
+uint32_t stampMs() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return (uint32_t)((uint64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000);
+}
+
+void saveTracker() {
+    tracker.saveState((uint8_t*)savedState, sizeof(savedState), millis(), stampMs());
+}
+
+void onRadarFrame(RD03D_Target* targets, uint8_t count) {
+    tracker.update(targets, millis());
+    saveTracker();
+
+    for (int i = 0; i < RD03D_MAX_TRACKS; i++) {
+        RD03D_Track* t = tracker.getTrack(i);
+        if (!t->isValid()) continue;
+
+        Serial.printf("%u,%.0f,%.0f\n", t->id, t->x, t->y);
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("# RD-03D Warm Restart Example");
+
+    RD03D_RestoreResult result = tracker.restoreState((const uint8_t*)savedState, sizeof(savedState),
+                                                      millis(), stampMs(), MAX_STATE_AGE_MS);
+    switch (result) {
+        case RD03D_RESTORE_OK:
+            Serial.printf("# Warm start: %u tracks restored (reset reason %d)\n",
+                          tracker.getTrackCount(), (int)esp_reset_reason());
+            break;
+        case RD03D_RESTORE_STALE:
+            Serial.println("# Cold start: saved state too old");
+            break;
+        default:
+            Serial.println("# Cold start: no saved state");
+            break;
+    }
+
+    // esp_restart() runs shutdown handlers; a watchdog reset relies on the per-frame save
+    esp_register_shutdown_handler(saveTracker);
+
+    radar.begin(Serial1, RADAR_RX_PIN, RADAR_TX_PIN);
+    radar.onFrame(onRadarFrame);
+}
+
+void loop() {
+    radar.update();
+
+    // Type 's' to sleep for 2 seconds and come back with the same tracks
+    if (Serial.read() == 's') {
+        saveTracker();
+        Serial.flush();
+        esp_sleep_enable_timer_wakeup(2000000);
+        esp_deep_sleep_start();
+    }
+}
@@ -0,0 +1,165 @@
+/**
+ * @file Arduino.cpp
+ * @brief Host implementation of the Arduino core stand-in
+ */
+
+#include "Arduino.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+
+// ============== CLOCK ==============
+static std::atomic<bool> g_virtualClock(false);
+static std::atomic<uint64_t> g_virtualMicros(0);
+
+static uint64_t realMicros() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t hostMicros64() {
+    return g_virtualClock ? g_virtualMicros.load() : realMicros();
+}
+
+uint32_t millis() {
+    return (uint32_t)(hostMicros64() / 1000);
+}
+
+uint32_t micros() {
+    return (uint32_t)hostMicros64();
+}
+
+void delay(uint32_t ms) {
+    delayMicroseconds(ms * 1000UL);
+}
+
+void delayMicroseconds(uint32_t us) {
+    if (g_virtualClock) {
+        g_virtualMicros += us;
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+}
+
+void yield() {
+}
+
+void hostUseVirtualClock(bool enabled) {
+    g_virtualClock = enabled;
+}
+
+void hostSetMicros(uint64_t us) {
+    g_virtualMicros = us;
+}
+
+void hostAdvanceMicros(uint64_t us) {
+    g_virtualMicros += us;
+}
+
+// ============== RANDOM ==============
+static std::mutex g_randomLock;
+static std::mt19937 g_random(std::random_device{}());
+
+long random(long howbig) {
+    if (howbig <= 0) return 0;
+    std::lock_guard<std::mutex> lock(g_randomLock);
+    return (long)(g_random() % (uint32_t)howbig);
+}
+
+long random(long howmin, long howmax) {
+    if (howmin >= howmax) return howmin;
+    return howmin + random(howmax - howmin);
+}
+
+void randomSeed(unsigned long seed) {
+    std::lock_guard<std::mutex> lock(g_randomLock);
+    g_random.seed((uint32_t)seed);
+}
+
+// ============== SERIAL ==============
+HardwareSerial::HardwareSerial() {
+    _rxHead = 0;
+    _rxCount = 0;
+    _rxLimit = HOST_SERIAL_RX_SIZE;
+    _txCount = 0;
+    _overflow = 0;
+    _baud = 0;
+}
+
+void HardwareSerial::setRxBufferSize(size_t size) {
+    // Mirror the configured UART buffer so overflow behaves like hardware
+    _rxLimit = (size == 0 || size > HOST_SERIAL_RX_SIZE) ? HOST_SERIAL_RX_SIZE : size;
+}
+
+void HardwareSerial::begin(unsigned long baud, uint32_t config, int rxPin, int txPin) {
+    (void)config;
+    (void)rxPin;
+    (void)txPin;
+    _baud = baud;
+}
+
+void HardwareSerial::end() {
+    _rxCount = 0;
+    _txCount = 0;
+}
+
+int HardwareSerial::available() {
+    return (int)_rxCount;
+}
+
+int HardwareSerial::peek() {
+    if (_rxCount == 0) return -1;
+    return _rx[_rxHead];
+}
+
+int HardwareSerial::read() {
+    if (_rxCount == 0) return -1;
+    uint8_t b = _rx[_rxHead];
+    _rxHead = (_rxHead + 1) % HOST_SERIAL_RX_SIZE;
+    _rxCount--;
+    return b;
+}
+
+size_t HardwareSerial::read(uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (n < size && _rxCount > 0) {
+        buffer[n++] = _rx[_rxHead];
+        _rxHead = (_rxHead + 1) % HOST_SERIAL_RX_SIZE;
+        _rxCount--;
+    }
+    return n;
+}
+
+size_t HardwareSerial::write(uint8_t b) {
+    return write(&b, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (n < size && _txCount < HOST_SERIAL_TX_SIZE) {
+        _tx[_txCount++] = buffer[n++];
+    }
+    return size;
+}
+
+size_t HardwareSerial::hostInject(const uint8_t* data, size_t len) {
+    size_t n = 0;
+    while (n < len && _rxCount < _rxLimit) {
+        _rx[(_rxHead + _rxCount) % HOST_SERIAL_RX_SIZE] = data[n++];
+        _rxCount++;
+    }
+    _overflow += (uint32_t)(len - n);
+    return n;
+}
+
+size_t HardwareSerial::hostTakeTx(uint8_t* buffer, size_t size) {
+    size_t n = (_txCount < size) ? _txCount : size;
+    memcpy(buffer, _tx, n);
+    memmove(_tx, _tx + n, _txCount - n);
+    _txCount -= n;
+    return n;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file Arduino.h
+ * @brief Minimal Arduino core stand-in for building RD03D on a host
+ *
+ * Provides just enough of the Arduino API for the library sources in
+ * src/ to compile with a desktop compiler. The clock can run in real
+ * time or be driven manually (virtual time) so tools can replay hours
+ * of radar data in seconds. HardwareSerial is backed by a fixed RX ring
+ * that tools fill with hostInject(). random() differs between runs, as
+ * on hardware.
+ */
+
+#ifndef RD03D_HOST_ARDUINO_H
+#define RD03D_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define SERIAL_8N1 0x800001c
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ============== CLOCK ==============
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+/**
+ * @brief Switch between the real monotonic clock and virtual time
+ * @param enabled true = time only moves through hostAdvanceMicros()/delay()
+ */
+void hostUseVirtualClock(bool enabled);
+
+/**
+ * @brief Set virtual time (64-bit, so millis()/micros() wrap like on hardware)
+ */
+void hostSetMicros(uint64_t us);
+
+/**
+ * @brief Advance virtual time
+ */
+void hostAdvanceMicros(uint64_t us);
+
+/**
+ * @brief Current time in 64-bit microseconds
+ */
+uint64_t hostMicros64();
+
+// ============== RANDOM ==============
+/**
+ * @brief Random number in [0, howbig); seeded from the OS at start-up,
+ *        like the hardware RNG behind random() on ESP32
+ */
+long random(long howbig);
+long random(long howmin, long howmax);
+void randomSeed(unsigned long seed);
+
+// ============== SERIAL ==============
+#define HOST_SERIAL_RX_SIZE 8192
+#define HOST_SERIAL_TX_SIZE 1024
+
+class HardwareSerial {
+public:
+    HardwareSerial();
+
+    void setRxBufferSize(size_t size);
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int rxPin = -1, int txPin = -1);
+    void end();
+
+    int available();
+    int peek();
+    int read();
+    size_t read(uint8_t* buffer, size_t size);
+    size_t readBytes(uint8_t* buffer, size_t size) { return read(buffer, size); }
+    size_t write(uint8_t b);
+    size_t write(const uint8_t* buffer, size_t size);
+
+    /**
+     * @brief Push bytes into the RX ring as if they came from the radar
+     * @return Bytes accepted (the rest count as overflow, like a full UART FIFO)
+     */
+    size_t hostInject(const uint8_t* data, size_t len);
+
+    /**
+     * @brief Take bytes the library wrote to the radar
+     * @return Bytes copied into buffer
+     */
+    size_t hostTakeTx(uint8_t* buffer, size_t size);
+
+    uint32_t hostOverflowCount() const { return _overflow; }
+    size_t hostRxLimit() const { return _rxLimit; }
+
+private:
+    uint8_t _rx[HOST_SERIAL_RX_SIZE];
+    size_t _rxHead;
+    size_t _rxCount;
+    size_t _rxLimit;
+    uint8_t _tx[HOST_SERIAL_TX_SIZE];
+    size_t _txCount;
+    uint32_t _overflow;
+    unsigned long _baud;
+};
+
+#endif // RD03D_HOST_ARDUINO_H
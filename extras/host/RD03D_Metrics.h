@@ -0,0 +1,133 @@
+/**
+ * @file RD03D_Metrics.h
+ * @brief CLEAR-MOT accuracy metrics for comparing tracks with ground truth
+ *
+ * Accumulates misses, false positives and ID switches per frame and
+ * reports MOTA and position RMSE. Correspondences from the previous
+ * frame are kept while still inside the match threshold, so an ID switch
+ * is only counted when the hypothesis covering an object really changes.
+ */
+
+#ifndef RD03D_METRICS_H
+#define RD03D_METRICS_H
+
+#include <math.h>
+#include <map>
+#include <vector>
+
+#include "RD03D_Sim.h"
+
+/**
+ * @brief Hypothesis (reported track) for one frame
+ */
+struct MotHypothesis {
+    int id;
+    double x, y;
+};
+
+class MotAccumulator {
+public:
+    explicit MotAccumulator(double thresholdMm = 500.0) : _threshold(thresholdMm) {}
+
+    void addFrame(const std::vector<SimTruth>& truth, const std::vector<MotHypothesis>& hyps) {
+        std::vector<bool> hypUsed(hyps.size(), false);
+        std::vector<bool> truthDone(truth.size(), false);
+        std::map<int, int> current;
+
+        // Keep last frame's correspondences that are still valid
+        for (size_t g = 0; g < truth.size(); g++) {
+            auto prev = _last.find(truth[g].id);
+            if (prev == _last.end()) continue;
+            for (size_t h = 0; h < hyps.size(); h++) {
+                if (hypUsed[h] || hyps[h].id != prev->second) continue;
+                if (dist(truth[g], hyps[h]) <= _threshold) {
+                    match(truth[g], hyps[h], current);
+                    hypUsed[h] = true;
+                    truthDone[g] = true;
+                }
+            }
+        }
+
+        // Greedy nearest match for the rest
+        while (true) {
+            double best = _threshold;
+            int bg = -1, bh = -1;
+            for (size_t g = 0; g < truth.size(); g++) {
+                if (truthDone[g]) continue;
+                for (size_t h = 0; h < hyps.size(); h++) {
+                    if (hypUsed[h]) continue;
+                    double d = dist(truth[g], hyps[h]);
+                    if (d <= best) {
+                        best = d;
+                        bg = (int)g;
+                        bh = (int)h;
+                    }
+                }
+            }
+            if (bg < 0) break;
+            auto prev = _everMatched.find(truth[bg].id);
+            if (prev != _everMatched.end() && prev->second != hyps[bh].id) idSwitches++;
+            match(truth[bg], hyps[bh], current);
+            truthDone[bg] = true;
+            hypUsed[bh] = true;
+        }
+
+        for (bool d : truthDone) if (!d) misses++;
+        for (bool u : hypUsed) if (!u) falsePositives++;
+        groundTruth += truth.size();
+        frames++;
+        _last = current;
+    }
+
+    /**
+     * @brief Add the totals of another accumulator (e.g. one sequence)
+     *
+     * Correspondences are not carried over, so sequences with their own
+     * truth and track IDs can be scored separately and then summed.
+     */
+    void merge(const MotAccumulator& other) {
+        frames += other.frames;
+        groundTruth += other.groundTruth;
+        matches += other.matches;
+        misses += other.misses;
+        falsePositives += other.falsePositives;
+        idSwitches += other.idSwitches;
+        _sqErr += other._sqErr;
+    }
+
+    double mota() const {
+        if (groundTruth == 0) return 1.0;
+        return 1.0 - (double)(misses + falsePositives + idSwitches) / (double)groundTruth;
+    }
+
+    double rmse() const {
+        return matches ? sqrt(_sqErr / (double)matches) : 0.0;
+    }
+
+    uint64_t frames = 0;
+    uint64_t groundTruth = 0;
+    uint64_t matches = 0;
+    uint64_t misses = 0;
+    uint64_t falsePositives = 0;
+    uint64_t idSwitches = 0;
+
+private:
+    double _threshold;
+    double _sqErr = 0.0;
+    std::map<int, int> _last;         // truth id -> hyp id (previous frame)
+    std::map<int, int> _everMatched;  // truth id -> last hyp id seen
+
+    static double dist(const SimTruth& g, const MotHypothesis& h) {
+        return hypot(g.x - h.x, g.y - h.y);
+    }
+
+    void match(const SimTruth& g, const MotHypothesis& h, std::map<int, int>& current) {
+        double d = dist(g, h);
+        _sqErr += d * d;
+        matches++;
+        current[g.id] = h.id;
+        _everMatched[g.id] = h.id;
+    }
+};
+
+#endif // RD03D_METRICS_H
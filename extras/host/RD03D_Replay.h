@@ -0,0 +1,96 @@
+/**
+ * @file RD03D_Replay.h
+ * @brief Helpers for decoding captures and simulator output on the host
+ *
+ * A capture is the raw byte stream from the radar UART, e.g. recorded with
+ * `cat /dev/ttyUSB0 > capture.bin` at 256000 baud. Captures and simulator
+ * frames are decoded through the real RD03D parser so host tools see
+ * exactly what the library would produce on the device.
+ */
+
+#ifndef RD03D_REPLAY_H
+#define RD03D_REPLAY_H
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_Sim.h"
+
+/**
+ * @brief One decoded frame
+ */
+struct ReplayFrame {
+    RD03D_Target targets[RD03D_MAX_TARGETS];
+    uint8_t count;
+};
+
+/**
+ * @brief Read a whole file into memory
+ * @return false if the file could not be read
+ */
+inline bool replayLoadFile(const std::string& path, std::vector<uint8_t>& out) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    uint8_t chunk[4096];
+    size_t n;
+    out.clear();
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        out.insert(out.end(), chunk, chunk + n);
+    }
+    fclose(f);
+    return true;
+}
+
+inline std::vector<ReplayFrame>* g_replayOut = nullptr;
+
+inline void replayOnFrame(RD03D_Target* targets, uint8_t count) {
+    ReplayFrame f;
+    for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) f.targets[i] = targets[i];
+    f.count = count;
+    g_replayOut->push_back(f);
+}
+
+/**
+ * @brief Decode a raw byte stream with the RD03D parser
+ * @param bytes Raw UART bytes
+ * @param errors Optional output for the parser error count
+ * @return Decoded frames in order
+ */
+inline std::vector<ReplayFrame> replayDecode(const std::vector<uint8_t>& bytes, uint32_t* errors = nullptr) {
+    std::vector<ReplayFrame> frames;
+    HardwareSerial port;
+    RD03D radar;
+
+    hostUseVirtualClock(true);
+    radar.begin(port, -1, -1);
+    radar.onFrame(replayOnFrame);
+    g_replayOut = &frames;
+
+    size_t pos = 0;
+    while (pos < bytes.size()) {
+        pos += port.hostInject(bytes.data() + pos, bytes.size() - pos);
+        radar.update();
+        hostAdvanceMicros(1000);
+    }
+
+    g_replayOut = nullptr;
+    if (errors) *errors = radar.getErrorCount();
+    return frames;
+}
+
+/**
+ * @brief Concatenate simulator frames into a raw byte stream
+ */
+inline std::vector<uint8_t> replaySimBytes(const std::vector<SimFrame>& frames) {
+    std::vector<uint8_t> bytes;
+    bytes.reserve(frames.size() * RD03D_SIM_FRAME_SIZE);
+    for (const SimFrame& f : frames) {
+        bytes.insert(bytes.end(), f.bytes, f.bytes + RD03D_SIM_FRAME_SIZE);
+    }
+    return bytes;
+}
+
+#endif // RD03D_REPLAY_H
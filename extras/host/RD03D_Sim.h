@@ -0,0 +1,252 @@
+/**
+ * @file RD03D_Sim.h
+ * @brief Scene simulator producing RD-03D frames with known ground truth
+ *
+ * People move along scripted paths; a simple radar model turns them into
+ * 30-byte frames using the same encoding as the real sensor (see
+ * extras/protocol.md), including measurement noise, missed detections,
+ * slot swaps and ghost targets. Host-only (uses the C++ standard library).
+ */
+
+#ifndef RD03D_SIM_H
+#define RD03D_SIM_H
+
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#define RD03D_SIM_FRAME_SIZE 30
+
+// ============== ENCODING ==============
+/**
+ * @brief Encode a sign-magnitude value (bit 15 set = positive)
+ */
+inline uint16_t rd03dSimSignMag(int v) {
+    if (v >= 0) return (uint16_t)(0x8000 | (v & 0x7FFF));
+    return (uint16_t)((-v) & 0x7FFF);
+}
+
+/**
+ * @brief Encode one 8-byte target block
+ * @param xMm X in mm, yMm Y in mm, speedCms radial speed in cm/s
+ */
+inline void rd03dSimEncodeTarget(int xMm, int yMm, int speedCms, uint8_t* out) {
+    uint16_t rx = rd03dSimSignMag(xMm);
+    uint16_t ry = (uint16_t)(yMm + 0x8000);
+    uint16_t rs = rd03dSimSignMag(speedCms);
+    uint16_t rd = 360;  // Distance resolution, constant on real sensors
+    out[0] = rx & 0xFF; out[1] = rx >> 8;
+    out[2] = ry & 0xFF; out[3] = ry >> 8;
+    out[4] = rs & 0xFF; out[5] = rs >> 8;
+    out[6] = rd & 0xFF; out[7] = rd >> 8;
+}
+
+// ============== SCENE ==============
+/**
+ * @brief Straight-line path with optional sideways sway
+ */
+struct SimPath {
+    int id;            ///< Ground-truth object ID
+    double t0, t1;     ///< Visible time span (s)
+    double x0, y0;     ///< Start position (mm)
+    double vx, vy;     ///< Velocity (mm/s)
+    double sway;       ///< Sway amplitude (mm)
+
+    void positionAt(double t, double& x, double& y) const {
+        double dt = t - t0;
+        x = x0 + vx * dt + sway * sin(dt * 2.0);
+        y = y0 + vy * dt;
+    }
+};
+
+/**
+ * @brief Radar imperfections applied by the simulator
+ */
+struct SimRadarModel {
+    double noiseMm = 60.0;     ///< Position noise (standard deviation)
+    double missProb = 0.05;    ///< Chance a visible object is not reported
+    double swapProb = 0.02;    ///< Chance per frame that two slots swap
+    double ghostProb = 0.01;   ///< Chance per frame of a ghost in an empty slot
+};
+
+struct SimTruth {
+    int id;
+    double x, y;
+};
+
+struct SimFrame {
+    double t;                              ///< Frame time (s)
+    uint8_t bytes[RD03D_SIM_FRAME_SIZE];   ///< Encoded frame
+    std::vector<SimTruth> truth;           ///< Objects inside the radar's view
+};
+
+struct SimScene {
+    std::string name;
+    double duration;
+    std::vector<SimPath> paths;
+};
+
+// ============== SIMULATOR ==============
+class RD03D_Sim {
+public:
+    RD03D_Sim(const SimScene& scene, const SimRadarModel& model, uint32_t seed)
+        : _scene(scene), _model(model), _rng(seed) {
+        for (int i = 0; i < 3; i++) _slotOwner[i] = -1;
+    }
+
+    /**
+     * @brief Produce the frame at time t (call with increasing t)
+     */
+    void frameAt(double t, SimFrame& out) {
+        std::normal_distribution<double> noise(0.0, _model.noiseMm);
+        std::uniform_real_distribution<double> uni(0.0, 1.0);
+
+        out.t = t;
+        out.truth.clear();
+
+        // Visible objects
+        std::vector<SimTruth> visible;
+        for (const SimPath& p : _scene.paths) {
+            if (t < p.t0 || t > p.t1) continue;
+            SimTruth g;
+            g.id = p.id;
+            p.positionAt(t, g.x, g.y);
+            if (g.y <= 0 || hypot(g.x, g.y) > 8000.0) continue;
+            if (fabs(atan2(g.x, g.y)) > 60.0 * M_PI / 180.0) continue;
+            visible.push_back(g);
+        }
+        out.truth = visible;
+
+        // Release slots of objects that left
+        for (int s = 0; s < 3; s++) {
+            bool present = false;
+            for (const SimTruth& g : visible) present |= (g.id == _slotOwner[s]);
+            if (!present) _slotOwner[s] = -1;
+        }
+        // Assign new objects to free slots
+        for (const SimTruth& g : visible) {
+            bool hasSlot = false;
+            for (int s = 0; s < 3; s++) hasSlot |= (_slotOwner[s] == g.id);
+            for (int s = 0; s < 3 && !hasSlot; s++) {
+                if (_slotOwner[s] < 0) {
+                    _slotOwner[s] = g.id;
+                    hasSlot = true;
+                }
+            }
+        }
+        // Occasional slot swap, as the real radar does
+        if (uni(_rng) < _model.swapProb) {
+            int a = (int)(uni(_rng) * 3) % 3;
+            int b = (a + 1) % 3;
+            int tmp = _slotOwner[a];
+            _slotOwner[a] = _slotOwner[b];
+            _slotOwner[b] = tmp;
+        }
+
+        // Encode
+        static const uint8_t header[4] = {0xAA, 0xFF, 0x03, 0x00};
+        memcpy(out.bytes, header, 4);
+        memset(out.bytes + 4, 0, 24);
+        out.bytes[28] = 0x55;
+        out.bytes[29] = 0xCC;
+
+        bool ghostDone = false;
+        for (int s = 0; s < 3; s++) {
+            uint8_t* block = out.bytes + 4 + s * 8;
+            if (_slotOwner[s] < 0) {
+                if (!ghostDone && uni(_rng) < _model.ghostProb) {
+                    ghostDone = true;
+                    int gx = (int)((uni(_rng) - 0.5) * 4000.0);
+                    int gy = 500 + (int)(uni(_rng) * 6000.0);
+                    rd03dSimEncodeTarget(gx, gy, 0, block);
+                }
+                continue;
+            }
+            if (uni(_rng) < _model.missProb) continue;
+
+            const SimTruth* g = nullptr;
+            for (const SimTruth& v : visible) {
+                if (v.id == _slotOwner[s]) g = &v;
+            }
+            const SimPath* p = pathFor(g->id);
+            int x = (int)lround(g->x + noise(_rng));
+            int y = (int)lround(g->y + noise(_rng));
+            if (y < 1) y = 1;
+
+            // Radial speed from path velocity
+            double r = hypot(g->x, g->y);
+            double radial = (r > 0) ? (p->vx * g->x + p->vy * g->y) / r : 0.0;
+            rd03dSimEncodeTarget(x, y, (int)lround(radial / 10.0), block);
+        }
+    }
+
+    /**
+     * @brief Generate all frames of the scene at a fixed frame rate
+     */
+    std::vector<SimFrame> run(double frameRateHz) {
+        std::vector<SimFrame> frames;
+        double period = 1.0 / frameRateHz;
+        for (double t = 0.0; t < _scene.duration; t += period) {
+            frames.emplace_back();
+            frameAt(t, frames.back());
+        }
+        return frames;
+    }
+
+private:
+    SimScene _scene;
+    SimRadarModel _model;
+    std::mt19937 _rng;
+    int _slotOwner[3];
+
+    const SimPath* pathFor(int id) const {
+        for (const SimPath& p : _scene.paths) {
+            if (p.id == id) return &p;
+        }
+        return nullptr;
+    }
+};
+
+// ============== BUILT-IN SCENES ==============
+/**
+ * @brief Standard scenes used by the benchmark and load tools
+ */
+inline std::vector<SimScene> rd03dSimScenes() {
+    std::vector<SimScene> scenes;
+
+    SimScene walk;
+    walk.name = "single_walk";
+    walk.duration = 30.0;
+    walk.paths.push_back({1, 0.0, 30.0, -2000, 1500, 150, 80, 100});
+    scenes.push_back(walk);
+
+    SimScene crossing;
+    crossing.name = "crossing";
+    crossing.duration = 30.0;
+    crossing.paths.push_back({1, 0.0, 25.0, -2500, 3000, 200, 0, 50});
+    crossing.paths.push_back({2, 2.0, 27.0, 2500, 3200, -200, 0, 50});
+    scenes.push_back(crossing);
+
+    SimScene group;
+    group.name = "three_people";
+    group.duration = 60.0;
+    group.paths.push_back({1, 0.0, 60.0, -1500, 1000, 40, 60, 200});
+    group.paths.push_back({2, 5.0, 40.0, 1500, 5000, -60, -80, 150});
+    group.paths.push_back({3, 20.0, 60.0, 0, 6500, 30, -100, 300});
+    group.paths.push_back({4, 42.0, 60.0, 2000, 2000, -120, 40, 100});
+    scenes.push_back(group);
+
+    SimScene approach;
+    approach.name = "approach_retreat";
+    approach.duration = 20.0;
+    approach.paths.push_back({1, 0.0, 9.0, 200, 6000, 0, -600, 0});
+    approach.paths.push_back({2, 10.0, 19.0, -200, 600, 0, 600, 0});
+    scenes.push_back(approach);
+
+    return scenes;
+}
+
+#endif // RD03D_SIM_H
@@ -0,0 +1,89 @@
+/**
+ * @file RD03D_SpscQueue.h
+ * @brief Bounded lock-free single-producer / single-consumer queue
+ *
+ * Fixed capacity (power of two), no allocation after construction.
+ * Head and tail live on separate cache lines; each side caches the other
+ * side's index so the common case touches no shared cache line.
+ */
+
+#ifndef RD03D_SPSC_QUEUE_H
+#define RD03D_SPSC_QUEUE_H
+
+#include <stddef.h>
+#include <atomic>
+#include <thread>
+
+template <typename T, size_t Capacity>
+class RD03D_SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /**
+     * @brief Try to enqueue (producer thread only)
+     * @return false if the queue is full
+     */
+    bool tryPush(const T& item) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tailCache >= Capacity) {
+            _tailCache = _tail.load(std::memory_order_acquire);
+            if (head - _tailCache >= Capacity) return false;
+        }
+        _items[head & (Capacity - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Enqueue, yielding while the queue is full (back-pressure)
+     * @return Number of times the producer had to wait
+     */
+    size_t push(const T& item) {
+        size_t waits = 0;
+        while (!tryPush(item)) {
+            waits++;
+            std::this_thread::yield();
+        }
+        return waits;
+    }
+
+    /**
+     * @brief Try to dequeue (consumer thread only)
+     * @return false if the queue is empty
+     */
+    bool tryPop(T& item) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _headCache) {
+            _headCache = _head.load(std::memory_order_acquire);
+            if (tail == _headCache) return false;
+        }
+        item = _items[tail & (Capacity - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Dequeue, yielding while the queue is empty
+     */
+    void pop(T& item) {
+        while (!tryPop(item)) {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Approximate number of queued items
+     */
+    size_t size() const {
+        return _head.load(std::memory_order_relaxed) - _tail.load(std::memory_order_relaxed);
+    }
+
+private:
+    alignas(64) std::atomic<size_t> _head{0};
+    size_t _tailCache = 0;                      // Producer's view of _tail
+    alignas(64) std::atomic<size_t> _tail{0};
+    size_t _headCache = 0;                      // Consumer's view of _head
+    alignas(64) T _items[Capacity];
+};
+
+#endif // RD03D_SPSC_QUEUE_H
@@ -0,0 +1,172 @@
+/**
+ * @file bench_tracker.cpp
+ * @brief Tracker accuracy and speed benchmark against simulated ground truth
+ *
+ * Runs every built-in scene from RD03D_Sim.h through the real library
+ * pipeline (bytes -> RD03D parser -> RD03D_Tracker validate/track) under a
+ * set of tracker options, and reports CLEAR-MOT accuracy (MOTA, ID
+ * switches, misses, false positives), position RMSE and ns per frame.
+ * The "raw_slots" row scores the radar's own slot numbering as IDs, i.e.
+ * what you get without the tracker.
+ *
+ * Build: see extras/host/README.md
+ *
+ * Usage:
+ *   ./bench_tracker [frameRateHz] [seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_Tracker.h"
+#include "RD03D_Metrics.h"
+#include "RD03D_Sim.h"
+
+// ============== TRACKER OPTIONS ==============
+struct TrackerOption {
+    const char* name;
+    bool useTracker;
+    RD03D_TrackerConfig config;
+};
+
+static std::vector<TrackerOption> trackerOptions() {
+    std::vector<TrackerOption> options;
+    RD03D_TrackerConfig base;
+    base.setDefaults();
+
+    options.push_back({"raw_slots", false, base});
+    options.push_back({"default", true, base});
+
+    RD03D_TrackerConfig smooth = base;
+    smooth.alpha = 0.35f;
+    smooth.beta = 0.05f;
+    options.push_back({"smooth", true, smooth});
+
+    RD03D_TrackerConfig tight = base;
+    tight.gateMm = 300.0f;
+    options.push_back({"tight_gate", true, tight});
+
+    RD03D_TrackerConfig noCoast = base;
+    noCoast.coastFrames = 0;
+    options.push_back({"no_coast", true, noCoast});
+
+    RD03D_TrackerConfig instant = base;
+    instant.confirmFrames = 1;
+    options.push_back({"confirm_1", true, instant});
+
+    return options;
+}
+
+// ============== PIPELINE ==============
+// Frame callbacks are plain function pointers, so the run state is global
+static RD03D_Tracker* g_tracker = nullptr;
+static std::vector<MotHypothesis> g_hyps;
+
+static void onFrame(RD03D_Target* targets, uint8_t count) {
+    (void)count;
+    g_hyps.clear();
+    if (g_tracker) {
+        g_tracker->update(targets, millis());
+        for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+            RD03D_Track* t = g_tracker->getTrack(i);
+            if (t->isValid()) g_hyps.push_back({t->id, t->x, t->y});
+        }
+    } else {
+        for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+            if (targets[i].valid) g_hyps.push_back({i + 1, (double)targets[i].x, (double)targets[i].y});
+        }
+    }
+}
+
+struct RunResult {
+    MotAccumulator mot;
+    double nsPerFrame = 0.0;
+    uint32_t parseErrors = 0;
+};
+
+static RunResult runScene(const std::vector<SimFrame>& frames, const TrackerOption& option) {
+    RunResult result;
+    HardwareSerial port;
+    RD03D radar;
+    RD03D_Tracker tracker;
+    tracker.setConfig(option.config);
+
+    hostUseVirtualClock(true);
+    hostSetMicros(0);
+    radar.begin(port, -1, -1);
+    radar.onFrame(onFrame);
+    g_tracker = option.useTracker ? &tracker : nullptr;
+
+    uint64_t start = hostMicros64();
+    uint64_t totalNs = 0;
+    for (const SimFrame& f : frames) {
+        hostSetMicros(start + (uint64_t)(f.t * 1e6));
+        port.hostInject(f.bytes, sizeof(f.bytes));
+        g_hyps.clear();
+
+        auto t0 = std::chrono::steady_clock::now();
+        radar.update();
+        auto t1 = std::chrono::steady_clock::now();
+        totalNs += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+
+        result.mot.addFrame(f.truth, g_hyps);
+    }
+
+    result.nsPerFrame = frames.empty() ? 0.0 : (double)totalNs / (double)frames.size();
+    result.parseErrors = radar.getErrorCount();
+    g_tracker = nullptr;
+    return result;
+}
+
+// ============== MAIN ==============
+int main(int argc, char** argv) {
+    double frameRate = (argc > 1) ? atof(argv[1]) : 20.0;
+    uint32_t seed = (argc > 2) ? (uint32_t)strtoul(argv[2], nullptr, 10) : 1;
+
+    std::vector<SimScene> scenes = rd03dSimScenes();
+    std::vector<TrackerOption> options = trackerOptions();
+    SimRadarModel model;
+
+    printf("RD03D tracker benchmark: %.1f Hz, seed %u\n\n", frameRate, seed);
+    printf("%-18s %-11s %7s %5s %6s %6s %8s %9s\n",
+           "scene", "option", "MOTA", "IDSW", "FN", "FP", "RMSE mm", "ns/frame");
+
+    for (const TrackerOption& option : options) {
+        MotAccumulator total;
+        double nsSum = 0.0;
+        uint64_t frameSum = 0;
+
+        for (const SimScene& scene : scenes) {
+            RD03D_Sim sim(scene, model, seed);
+            std::vector<SimFrame> frames = sim.run(frameRate);
+            RunResult r = runScene(frames, option);
+
+            printf("%-18s %-11s %7.3f %5llu %6llu %6llu %8.1f %9.0f\n",
+                   scene.name.c_str(), option.name, r.mot.mota(),
+                   (unsigned long long)r.mot.idSwitches,
+                   (unsigned long long)r.mot.misses,
+                   (unsigned long long)r.mot.falsePositives,
+                   r.mot.rmse(), r.nsPerFrame);
+
+            total.groundTruth += r.mot.groundTruth;
+            total.misses += r.mot.misses;
+            total.falsePositives += r.mot.falsePositives;
+            total.idSwitches += r.mot.idSwitches;
+            nsSum += r.nsPerFrame * frames.size();
+            frameSum += frames.size();
+        }
+
+        printf("%-18s %-11s %7.3f %5llu %6llu %6llu %8s %9.0f\n\n",
+               "ALL", option.name, total.mota(),
+               (unsigned long long)total.idSwitches,
+               (unsigned long long)total.misses,
+               (unsigned long long)total.falsePositives,
+               "-", frameSum ? nsSum / frameSum : 0.0);
+    }
+    return 0;
+}
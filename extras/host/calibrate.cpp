@@ -0,0 +1,182 @@
+/**
+ * @file calibrate.cpp
+ * @brief Solve the relative pose of two overlapping radars from captures
+ *
+ * Reads two CSV captures in the MultiTargetCallback format
+ * (timestamp,count,t1_x,t1_y,t1_dist,t1_angle,t1_speed,...), recorded
+ * while one person walks through the shared area with both sensors on
+ * the same clock. Frames are paired by nearest timestamp and passed to
+ * RD03D_Calibration, the same solver that runs on the device.
+ *
+ * --sim generates a synthetic walk with a known pose, noise and
+ * outliers, and reports the error of the recovered pose.
+ *
+ * Build: see extras/host/README.md
+ *
+ * Usage:
+ *   ./calibrate sensorA.csv sensorB.csv [toleranceMs]
+ *   ./calibrate --sim [x_mm y_mm theta_deg]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_Calibration.h"
+#include "RD03D_Pose.h"
+
+#define MAX_PAIRS 4000
+
+static RD03D_CalibrationPair g_pairs[MAX_PAIRS];
+
+// ============== CSV CAPTURES ==============
+struct CsvFrame {
+    uint32_t timestamp;
+    RD03D_Target targets[RD03D_MAX_TARGETS];
+};
+
+static bool loadCsv(const char* path, std::vector<CsvFrame>& out) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+
+        double v[2 + 5 * RD03D_MAX_TARGETS];
+        int n = 0;
+        char* save = nullptr;
+        for (char* tok = strtok_r(line, ",", &save); tok && n < (int)(sizeof(v) / sizeof(v[0]));
+             tok = strtok_r(nullptr, ",", &save)) {
+            v[n++] = atof(tok);
+        }
+        if (n < 2 + 5 * RD03D_MAX_TARGETS) continue;
+
+        CsvFrame frame;
+        frame.timestamp = (uint32_t)v[0];
+        for (int i = 0; i < RD03D_MAX_TARGETS; i++) {
+            RD03D_Target& t = frame.targets[i];
+            t.clear();
+            t.x = (int16_t)v[2 + i * 5];
+            t.y = (int16_t)v[3 + i * 5];
+            t.distance = (float)v[4 + i * 5];
+            t.angle = (float)v[5 + i * 5];
+            t.speed = (int16_t)v[6 + i * 5];
+            t.valid = (t.x != 0 || t.y != 0);
+        }
+        out.push_back(frame);
+    }
+    fclose(f);
+    return true;
+}
+
+static void printResult(RD03D_Calibration& calib, const RD03D_Pose& pose) {
+    printf("Pose of B in A's frame:\n");
+    printf("  x     = %.1f mm\n", pose.x);
+    printf("  y     = %.1f mm\n", pose.y);
+    printf("  theta = %.2f deg\n", pose.theta);
+    printf("Inliers: %u of %u pairs, RMS residual %.1f mm\n",
+           calib.getInlierCount(), calib.getCount(), calib.getRmsError());
+    printf("\nRD03D_Pose poseB = {%.1ff, %.1ff, %.2ff};\n", pose.x, pose.y, pose.theta);
+}
+
+static int runCaptures(const char* pathA, const char* pathB, uint32_t toleranceMs) {
+    std::vector<CsvFrame> a, b;
+    if (!loadCsv(pathA, a) || !loadCsv(pathB, b)) {
+        fprintf(stderr, "Cannot read captures\n");
+        return 1;
+    }
+    printf("A: %zu frames, B: %zu frames\n", a.size(), b.size());
+
+    RD03D_Calibration calib(g_pairs, MAX_PAIRS);
+    size_t j = 0;
+    uint32_t used = 0;
+    for (const CsvFrame& fa : a) {
+        // Advance B to the frame closest in time
+        while (j + 1 < b.size() &&
+               labs((long)b[j + 1].timestamp - (long)fa.timestamp) <= labs((long)b[j].timestamp - (long)fa.timestamp)) {
+            j++;
+        }
+        if (j >= b.size()) break;
+        if ((uint32_t)labs((long)b[j].timestamp - (long)fa.timestamp) > toleranceMs) continue;
+        if (calib.addFrames(fa.targets, b[j].targets)) used++;
+    }
+    printf("Paired %u single-target frames (tolerance %u ms)\n\n", used, toleranceMs);
+
+    RD03D_Pose pose;
+    if (!calib.solve(pose)) {
+        fprintf(stderr, "Calibration failed: not enough pairs or the walk covered too little area\n");
+        return 1;
+    }
+    printResult(calib, pose);
+    return 0;
+}
+
+// ============== SYNTHETIC CHECK ==============
+static int runSim(const RD03D_Pose& truth) {
+    std::mt19937 rng(3);
+    std::normal_distribution<float> noise(0.0f, 60.0f);
+    std::uniform_real_distribution<float> uni(0.0f, 1.0f);
+
+    // Inverse of the true pose maps A's frame into B's
+    float rad = -truth.theta * PI / 180.0f;
+    float c = cosf(rad), s = sinf(rad);
+
+    RD03D_Calibration calib(g_pairs, MAX_PAIRS);
+    int outliers = 0;
+    for (int k = 0; k < 600; k++) {
+        // Figure-eight walk in A's frame
+        float t = k * 0.05f;
+        float ax = 1500.0f * sinf(t * 0.4f);
+        float ay = 3000.0f + 1000.0f * sinf(t * 0.8f);
+
+        float dx = ax - truth.x, dy = ay - truth.y;
+        float bx = c * dx - s * dy;
+        float by = s * dx + c * dy;
+
+        if (uni(rng) < 0.1f) {
+            // Ghost or wrong association in B
+            bx = (uni(rng) - 0.5f) * 6000.0f;
+            by = uni(rng) * 6000.0f;
+            outliers++;
+        }
+        calib.addPair(ax + noise(rng), ay + noise(rng), bx + noise(rng), by + noise(rng));
+    }
+
+    printf("Synthetic walk: %u pairs, %d outliers\n", calib.getCount(), outliers);
+    printf("True pose: x %.1f, y %.1f, theta %.2f\n\n", truth.x, truth.y, truth.theta);
+
+    RD03D_Pose pose;
+    if (!calib.solve(pose)) {
+        fprintf(stderr, "Calibration failed\n");
+        return 1;
+    }
+    printResult(calib, pose);
+    printf("\nError: %.1f mm, %.2f deg\n",
+           hypotf(pose.x - truth.x, pose.y - truth.y), fabsf(pose.theta - truth.theta));
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "--sim") == 0) {
+        RD03D_Pose truth = {2500.0f, 800.0f, 35.0f};
+        if (argc >= 5) {
+            truth.x = atof(argv[2]);
+            truth.y = atof(argv[3]);
+            truth.theta = atof(argv[4]);
+        }
+        return runSim(truth);
+    }
+    if (argc >= 3) {
+        uint32_t tolerance = (argc >= 4) ? (uint32_t)atoi(argv[3]) : 25;
+        return runCaptures(argv[1], argv[2], tolerance);
+    }
+    fprintf(stderr, "usage: calibrate sensorA.csv sensorB.csv [toleranceMs]\n"
+                    "       calibrate --sim [x_mm y_mm theta_deg]\n");
+    return 1;
+}
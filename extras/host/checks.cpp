@@ -0,0 +1,1251 @@
+/**
+ * @file checks.cpp
+ * @brief Behaviour checks for the library on the virtual clock
+ *
+ * Each section drives the library through the Arduino stand-in with
+ * hand-built frames and asserts what it must do, printing one PASS or
+ * FAIL line per section. The exit status is 0 only if every selected
+ * section passed.
+ *
+ * Sections:
+ *   pose   SiteConfig-style rotated mount: the tracker gates range and
+ *          beam angle in the sensor frame, zones see site coordinates
+ *   budget update(maxBytes, maxMicros): return value and backlog per
+ *          call, and no frame timeout while a backlog remains
+ *   conflation  overload control is opt-in; a slow callback enters
+ *          latest-frame-only delivery, holds it inside the hysteresis
+ *          band and leaves it, and feed() input is never conflated
+ *   idle   idle level entry after the timeout of empty frames, one in
+ *          N empty frames delivered, exit on the first target
+ *   input  a 200k-frame faulty stream decodes identically byte by byte,
+ *          in one feed() and through RD03D_RingSource with random wrap
+ *          points and budgets; ring overflow and budget stops
+ *   restore tracker state across a simulated reset matches a tracker
+ *          that never reset; damaged, stale and invalid states are
+ *          rejected without touching the tracker
+ *   gestures swipes and steps are recognised alike at 10, 20 and
+ *          50 Hz; steady walking never matches
+ *   window rolling track statistics match a brute-force window over a
+ *          long stream at metre-scale offsets; the window is cleared
+ *          when its track slot is dropped, replaced or reset
+ *   sample sampleAt() interpolates between the last two updates,
+ *          extrapolates up to RD03D_SAMPLE_HORIZON and then holds, and
+ *          does not interpolate across gaps of over a second
+ *
+ * Build: see extras/host/README.md
+ *
+ * Usage:
+ *   ./checks [section...]      (default: all)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_Config.h"
+#include "RD03D_Gesture.h"
+#include "RD03D_Input.h"
+#include "RD03D_Pose.h"
+#include "RD03D_Tracker.h"
+#include "RD03D_TrackWindow.h"
+#include "RD03D_Sim.h"
+#include "RD03D_Replay.h"
+
+static unsigned g_failures = 0;
+
+static void expect(bool ok, const char* section, const char* what) {
+    if (ok) return;
+    printf("  %s: %s\n", section, what);
+    g_failures++;
+}
+
+// ============== FRAMES ==============
+struct Point {
+    int x, y;
+};
+
+/**
+ * @brief Encode a frame with up to three targets (sensor frame, mm)
+ */
+static void makeFrame(const Point* points, int count, uint8_t* out) {
+    static const uint8_t header[4] = {0xAA, 0xFF, 0x03, 0x00};
+    memcpy(out, header, 4);
+    memset(out + 4, 0, 24);
+    for (int i = 0; i < count && i < 3; i++) {
+        rd03dSimEncodeTarget(points[i].x, points[i].y, 0, out + 4 + i * 8);
+    }
+    out[28] = 0x55;
+    out[29] = 0xCC;
+}
+
+static Point polar(float distanceMm, float angleDeg) {
+    float rad = angleDeg * PI / 180.0f;
+    Point p = {(int)lroundf(distanceMm * sinf(rad)), (int)lroundf(distanceMm * cosf(rad))};
+    return p;
+}
+
+// ============== POSE ==============
+// Mounted as in the SiteConfig example: 1.5 m along the wall, turned 30°
+// clockwise, with a tighter range than the default
+static RD03D_Tracker* g_poseTracker;
+
+static void onPoseFrame(RD03D_Target* targets, uint8_t count) {
+    (void)count;
+    g_poseTracker->update(targets, millis());
+}
+
+/**
+ * @brief Stream one standing target and report what the tracker made of it
+ * @return Number of confirmed tracks after one second at 20 Hz
+ */
+static uint8_t poseRun(const RD03D_ConfigBlob& config, Point p, uint32_t& rejected,
+                       float& siteX, float& siteY, RD03D_Target& siteTarget) {
+    RD03D radar;
+    RD03D_Tracker tracker;
+    RD03D_TrackerConfig tc;
+    if (config.getTrackerConfig(tc)) tracker.setConfig(tc);
+    radar.applyConfig(&config);
+    g_poseTracker = &tracker;
+    radar.onFrame(onPoseFrame);
+
+    uint8_t frame[RD03D_SIM_FRAME_SIZE];
+    makeFrame(&p, 1, frame);
+    for (int n = 0; n < 20; n++) {
+        hostAdvanceMicros(50000);
+        radar.feed(frame, sizeof(frame));
+    }
+
+    RD03D_Target* site = radar.getSiteTargets();
+    siteTarget = site[0];
+    rejected = tracker.getRejectedCount();
+
+    RD03D_Pose pose;
+    config.getPose(pose);
+    uint8_t confirmed = 0;
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        RD03D_Track* t = tracker.getTrack(i);
+        if (!t->isValid()) continue;
+        pose.apply(t->x, t->y, siteX, siteY);
+        confirmed++;
+    }
+    return confirmed;
+}
+
+static bool checkPose() {
+    const char* s = "pose";
+    unsigned before = g_failures;
+
+    RD03D_ConfigSettings settings;
+    memset(&settings, 0, sizeof(settings));
+    settings.flags = RD03D_CONFIG_FLAG_POSE | RD03D_CONFIG_FLAG_TRACKER;
+    settings.poseX = 1500;
+    settings.poseY = 0;
+    settings.poseTheta = -30;
+    settings.maxRangeCm = 600;
+    settings.maxAngleDeg = 60;
+    settings.gateMm = 600;
+    settings.alpha = 0.6f;
+    settings.beta = 0.2f;
+    settings.coastFrames = 5;
+    settings.confirmFrames = 2;
+
+    static uint8_t blob[256] __attribute__((aligned(4)));
+    size_t len = RD03D_ConfigBlob::build(settings, nullptr, 0, 1, blob, sizeof(blob));
+    RD03D_ConfigBlob config;
+    expect(len > 0 && config.load(blob, len) == RD03D_CONFIG_OK, s, "blob does not load");
+
+    RD03D_Pose pose;
+    RD03D_TrackerConfig tc;
+    expect(config.getPose(pose) && config.getTrackerConfig(tc), s, "blob has no pose or tracker settings");
+
+    uint32_t rejected;
+    float x = 0, y = 0;
+    RD03D_Target site;
+
+    // 55° off boresight at 4 m: inside the beam, although the site-frame
+    // bearing is beyond ±60°
+    Point edge = polar(4000, 55);
+    uint8_t n = poseRun(config, edge, rejected, x, y, site);
+    float ex, ey;
+    pose.apply((float)edge.x, (float)edge.y, ex, ey);
+    expect(fabsf(site.angle) > 60, s, "edge target should be outside ±60° in the site frame");
+    expect(n == 1 && rejected == 0, s, "target inside the beam was rejected");
+    expect(fabsf(x - ex) < 2 && fabsf(y - ey) < 2, s, "site position of the track is wrong");
+
+    // 70° off boresight at 3 m: outside the beam, although the site-frame
+    // bearing is only about -10°
+    n = poseRun(config, polar(3000, -70), rejected, x, y, site);
+    expect(fabsf(site.angle) < 60, s, "wide target should be inside ±60° in the site frame");
+    expect(n == 0 && rejected == 20, s, "target outside the beam was accepted");
+
+    // 6.2 m from the sensor: past the range, although under 6 m from the
+    // site origin
+    n = poseRun(config, polar(6200, -58), rejected, x, y, site);
+    expect(site.distance < 600, s, "far target should be within 6 m of the site origin");
+    expect(n == 0 && rejected == 20, s, "target past the range was accepted");
+    n = poseRun(config, polar(5900, 0), rejected, x, y, site);
+    expect(n == 1 && rejected == 0, s, "target inside the range was rejected");
+
+    bool ok = g_failures == before;
+    printf("%s: pose (sensor-frame gating, site-frame tracks)\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+// ============== BUDGET ==============
+static uint32_t g_budgetCallbackMicros;
+
+static void onBudgetFrame(RD03D_Target* targets, uint8_t count) {
+    (void)targets;
+    (void)count;
+    hostAdvanceMicros(g_budgetCallbackMicros);
+}
+
+static bool checkBudget() {
+    const char* s = "budget";
+    unsigned before = g_failures;
+
+    HardwareSerial port;
+    RD03D radar;
+    radar.begin(port, -1, -1, 4096);
+    radar.onFrame(onBudgetFrame);
+    g_budgetCallbackMicros = 0;
+
+    uint8_t frame[RD03D_SIM_FRAME_SIZE];
+    Point p = {300, 2000};
+    makeFrame(&p, 1, frame);
+
+    // Byte budget: ten frames drained 64 bytes at a time
+    for (int n = 0; n < 10; n++) port.hostInject(frame, sizeof(frame));
+    size_t expected = 300;
+    unsigned calls = 0;
+    bool more = true;
+    while (more && calls < 20) {
+        more = radar.update(64, 0);
+        calls++;
+        expected = expected > 64 ? expected - 64 : 0;
+        expect(radar.getBacklog() == expected, s, "backlog does not match the bytes left");
+        expect(more == (expected > 0), s, "return value does not match the backlog");
+        expect(radar.getFrameCount() == (300 - expected) / RD03D_FRAME_SIZE, s,
+               "frames decoded past the byte budget");
+    }
+    expect(calls == 5 && radar.getFrameCount() == 10, s, "ten frames not drained in five calls");
+    expect(radar.getMaxBacklog() == 300, s, "max backlog is not the injected size");
+
+    // Time budget: a 300 µs callback and a 1 ms budget stop early
+    g_budgetCallbackMicros = 300;
+    for (int n = 0; n < 10; n++) port.hostInject(frame, sizeof(frame));
+    more = radar.update(0, 1000);
+    uint32_t frames = radar.getFrameCount() - 10;
+    expect(more && radar.getBacklog() > 0, s, "time budget did not leave a backlog");
+    expect(frames >= 2 && frames < 10, s, "time budget did not stop part way");
+    while (radar.update(0, 1000)) {}
+    expect(radar.getFrameCount() == 20 && radar.getBacklog() == 0, s, "time-budgeted drain lost frames");
+    g_budgetCallbackMicros = 0;
+
+    // A backlog left over a long pause is late, not missing: the frame
+    // split across the budget must not time out
+    uint32_t errors = radar.getErrorCount();
+    for (int n = 0; n < 4; n++) port.hostInject(frame, sizeof(frame));
+    more = radar.update(45, 0);
+    expect(more && radar.getBacklog() == 75, s, "split frame not left part way");
+    hostAdvanceMicros(500000);
+    while (radar.update(45, 0)) {}
+    expect(radar.getErrorCount() == errors, s, "timeout fired while a backlog remained");
+    expect(radar.getFrameCount() == 24, s, "frames lost after a pause with a backlog");
+
+    // Without a backlog the same stuck partial frame does time out
+    port.hostInject(frame, 15);
+    radar.update(0, 0);
+    expect(radar.getBacklog() == 0, s, "partial frame left a backlog");
+    hostAdvanceMicros(500000);
+    radar.update(0, 0);
+    expect(radar.getErrorCount() == errors + 1, s, "stuck partial frame did not time out");
+    port.hostInject(frame, sizeof(frame));
+    radar.update(0, 0);
+    expect(radar.getFrameCount() == 25, s, "parser did not recover after the timeout");
+
+    bool ok = g_failures == before;
+    printf("%s: budget (update() byte and time budgets, backlog, timeout)\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+// ============== CONFLATION ==============
+static uint32_t g_callbackCost;
+static uint32_t g_delivered;
+
+static void onSlowFrame(RD03D_Target* targets, uint8_t count) {
+    (void)targets;
+    (void)count;
+    g_delivered++;
+    hostAdvanceMicros(g_callbackCost);
+}
+
+/**
+ * @brief Frames arrive every 50 ms (20 Hz) while the loop calls update()
+ *
+ * The callback advances the virtual clock by its cost, so a slow one
+ * lets frames queue up in the UART exactly as on a device.
+ */
+struct SlowLoop {
+    HardwareSerial port;
+    RD03D radar;
+    uint8_t frame[RD03D_SIM_FRAME_SIZE];
+    uint64_t nextArrival;
+    uint32_t sent;
+
+    SlowLoop() : nextArrival(0), sent(0) {
+        radar.begin(port, -1, -1, 4096);
+        radar.onFrame(onSlowFrame);
+        Point p = {0, 1500};
+        makeFrame(&p, 1, frame);
+        nextArrival = hostMicros64();
+    }
+
+    void run(uint32_t frames) {
+        uint32_t end = sent + frames;
+        while (sent < end) {
+            if (hostMicros64() < nextArrival) hostSetMicros(nextArrival);
+            while (nextArrival <= hostMicros64() && sent < end) {
+                port.hostInject(frame, sizeof(frame));
+                nextArrival += 50000;
+                sent++;
+            }
+            radar.update();
+        }
+    }
+};
+
+static bool checkConflation() {
+    const char* s = "conflation";
+    unsigned before = g_failures;
+
+    // Off by default: an overloaded callback still gets every frame
+    {
+        g_delivered = 0;
+        g_callbackCost = 70000;
+        SlowLoop loop;
+        loop.run(100);
+        expect(!loop.radar.isConflating() && loop.radar.getConflatedCount() == 0, s,
+               "conflated without setOverloadControl(true)");
+        expect(g_delivered == 100, s, "frames dropped with overload control off");
+    }
+
+    SlowLoop loop;
+    RD03D& radar = loop.radar;
+    radar.setOverloadControl(true);
+
+    // 80 % of the interval is below the entry threshold
+    g_delivered = 0;
+    g_callbackCost = 40000;
+    loop.run(100);
+    expect(!radar.isConflating() && radar.getConflatedCount() == 0, s, "entered below 90 %");
+    expect(g_delivered == 100, s, "frames dropped below the entry threshold");
+    expect(radar.getFrameInterval() > 45000 && radar.getFrameInterval() < 55000, s,
+           "frame interval not measured as 50 ms");
+
+    // 140 %: switches to latest-frame-only delivery within a few frames
+    g_callbackCost = 70000;
+    uint32_t frames = 0;
+    while (!radar.isConflating() && frames < 50) {
+        loop.run(1);
+        frames++;
+    }
+    expect(radar.isConflating() && radar.getModeSwitchCount() == 1, s, "did not enter at 140 %");
+    expect(frames <= 20, s, "took more than 20 frames to enter");
+
+    uint32_t delivered = g_delivered;
+    uint32_t conflated = radar.getConflatedCount();
+    loop.run(200);
+    delivered = g_delivered - delivered;
+    conflated = radar.getConflatedCount() - conflated;
+    expect(conflated > 0 && delivered + conflated == 200, s,
+           "delivered and conflated frames do not add up to the frames sent");
+    expect(radar.getBacklog() == 0, s, "backlog grew while conflating");
+
+    // 80 %: inside the hysteresis band, stays conflating
+    g_callbackCost = 40000;
+    loop.run(100);
+    expect(radar.isConflating() && radar.getModeSwitchCount() == 1, s, "left above 60 %");
+
+    // 40 %: normal delivery resumes and every frame arrives again
+    g_callbackCost = 20000;
+    frames = 0;
+    while (radar.isConflating() && frames < 50) {
+        loop.run(1);
+        frames++;
+    }
+    expect(!radar.isConflating() && radar.getModeSwitchCount() == 2, s, "did not leave at 40 %");
+    conflated = radar.getConflatedCount();
+    delivered = g_delivered;
+    loop.run(100);
+    expect(radar.getConflatedCount() == conflated && g_delivered - delivered == 100, s,
+           "frames dropped after leaving");
+
+    // feed() input is never conflated, however slow the callback
+    {
+        RD03D fed;
+        fed.setOverloadControl(true);
+        fed.onFrame(onSlowFrame);
+        g_callbackCost = 70000;
+        g_delivered = 0;
+        uint8_t burst[RD03D_SIM_FRAME_SIZE * 10];
+        for (int n = 0; n < 10; n++) memcpy(burst + n * RD03D_SIM_FRAME_SIZE, loop.frame, RD03D_SIM_FRAME_SIZE);
+        for (int n = 0; n < 20; n++) {
+            hostAdvanceMicros(50000);
+            fed.feed(burst, sizeof(burst));
+        }
+        expect(!fed.isConflating() && fed.getConflatedCount() == 0 && g_delivered == 200, s,
+               "feed() input was conflated");
+    }
+
+    bool ok = g_failures == before;
+    printf("%s: conflation (opt-in, entry, hysteresis, exit, %u conflated)\n", ok ? "PASS" : "FAIL",
+           (unsigned)radar.getConflatedCount());
+    return ok;
+}
+
+// ============== IDLE ==============
+static uint32_t g_idleFrame;          // Index of the frame being fed
+static uint32_t g_idleDelivered[512];
+static uint32_t g_idleDeliveredCount;
+static uint8_t g_idleLevel;
+static uint32_t g_idleLevelFrame;
+static uint32_t g_idleLevelChanges;
+
+static void onIdleFrame(RD03D_Target* targets, uint8_t count) {
+    (void)targets;
+    (void)count;
+    if (g_idleDeliveredCount < 512) g_idleDelivered[g_idleDeliveredCount] = g_idleFrame;
+    g_idleDeliveredCount++;
+}
+
+static void onIdleLevel(uint8_t level) {
+    g_idleLevel = level;
+    g_idleLevelFrame = g_idleFrame;
+    g_idleLevelChanges++;
+}
+
+static bool checkIdle() {
+    const char* s = "idle";
+    unsigned before = g_failures;
+
+    uint8_t present[RD03D_SIM_FRAME_SIZE];
+    uint8_t empty[RD03D_SIM_FRAME_SIZE];
+    Point p = {-200, 2500};
+    makeFrame(&p, 1, present);
+    makeFrame(nullptr, 0, empty);
+
+    RD03D radar;
+    radar.onFrame(onIdleFrame);
+    radar.onLevelChange(onIdleLevel);
+    g_idleDeliveredCount = 0;
+    g_idleLevelChanges = 0;
+
+    // Default: no idle timeout, every empty frame is delivered
+    for (g_idleFrame = 0; g_idleFrame < 100; g_idleFrame++) {
+        hostAdvanceMicros(50000);
+        radar.feed(empty, sizeof(empty));
+    }
+    expect(!radar.isIdle() && g_idleLevelChanges == 0 && g_idleDeliveredCount == 100, s,
+           "went idle without an idle timeout");
+
+    // 1 s timeout at 20 Hz: idle on the 20th empty frame after presence,
+    // then one empty frame in ten is delivered
+    radar.setIdleTimeout(1000);
+    radar.setIdleDecimation(10);
+    g_idleDeliveredCount = 0;
+    for (g_idleFrame = 0; g_idleFrame < 10; g_idleFrame++) {
+        hostAdvanceMicros(50000);
+        radar.feed(present, sizeof(present));
+    }
+    for (; g_idleFrame < 210; g_idleFrame++) {
+        hostAdvanceMicros(50000);
+        radar.feed(empty, sizeof(empty));
+    }
+    expect(radar.isIdle() && radar.getLevel() == RD03D_LEVEL_IDLE, s, "not idle after 200 empty frames");
+    expect(g_idleLevelChanges == 1 && g_idleLevel == RD03D_LEVEL_IDLE && g_idleLevelFrame == 29, s,
+           "idle not entered on the 20th empty frame");
+
+    // Frames 10-28 delivered before the switch, then only frames 38, 48, ...
+    uint32_t skipped = radar.getIdleSkippedCount();
+    expect(skipped == 163 && g_idleDeliveredCount == 210 - skipped, s,
+           "delivered and skipped frames do not add up");
+    bool spacing = true;
+    for (uint32_t i = 0; i < g_idleDeliveredCount && i < 512; i++) {
+        uint32_t f = g_idleDelivered[i];
+        bool due = f < 29 || (f - 29) % 10 == 9;
+        if (!due) spacing = false;
+    }
+    expect(spacing, s, "a skipped empty frame was delivered");
+
+    // The first frame with a target restores the full level and is delivered
+    uint32_t delivered = g_idleDeliveredCount;
+    hostAdvanceMicros(50000);
+    radar.feed(present, sizeof(present));
+    expect(!radar.isIdle() && g_idleLevelChanges == 2 && g_idleLevel == RD03D_LEVEL_FULL &&
+           g_idleLevelFrame == 210, s, "full level not restored by the first target");
+    expect(g_idleDeliveredCount == delivered + 1 && g_idleDelivered[delivered] == 210, s,
+           "the frame that ended idle was not delivered");
+
+    // Short gaps (under the timeout) never go idle
+    for (g_idleFrame = 211; g_idleFrame < 411; g_idleFrame++) {
+        hostAdvanceMicros(50000);
+        radar.feed(g_idleFrame % 15 == 0 ? present : empty, RD03D_SIM_FRAME_SIZE);
+    }
+    expect(!radar.isIdle() && g_idleLevelChanges == 2 && radar.getIdleSkippedCount() == skipped, s,
+           "went idle with a target every 0.75 s");
+
+    bool ok = g_failures == before;
+    printf("%s: idle (entry after the timeout, decimated delivery, exit on presence)\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+// ============== INPUT ==============
+struct DecodeLog {
+    uint32_t callbacks;
+    uint64_t hash;     // FNV-1a over every delivered target
+};
+
+static DecodeLog* g_decodeLog;
+
+static void onLoggedFrame(RD03D_Target* targets, uint8_t count) {
+    DecodeLog& log = *g_decodeLog;
+    log.callbacks++;
+    uint64_t h = log.hash ^ count;
+    for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+        int32_t v[5] = {targets[i].valid, targets[i].x, targets[i].y, targets[i].speed, targets[i].distanceRaw};
+        const uint8_t* b = (const uint8_t*)v;
+        for (size_t k = 0; k < sizeof(v); k++) h = (h ^ b[k]) * 1099511628211ULL;
+    }
+    log.hash = h;
+}
+
+/**
+ * @brief Radar stream with corrupted bytes, bad tails, truncated frames
+ *        and noise full of header fragments
+ */
+static std::vector<uint8_t> faultyStream(uint32_t frames, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+    static const uint8_t noiseBytes[6] = {0xAA, 0xFF, 0x03, 0x00, 0x55, 0xCC};
+
+    std::vector<uint8_t> out;
+    out.reserve((size_t)frames * 31);
+    uint8_t frame[RD03D_SIM_FRAME_SIZE];
+    for (uint32_t n = 0; n < frames; n++) {
+        Point p[3];
+        int count = n % 4;
+        for (int i = 0; i < count; i++) {
+            p[i].x = (int)((n * 37 + i * 911) % 4000) - 2000;
+            p[i].y = 500 + (int)((n * 53 + i * 1301) % 5000);
+        }
+        makeFrame(p, count, frame);
+
+        double r = uni(rng);
+        size_t len = sizeof(frame);
+        if (r < 0.01) {
+            frame[rng() % RD03D_SIM_FRAME_SIZE] ^= (uint8_t)(1 + rng() % 255);
+        } else if (r < 0.015) {
+            frame[29] = 0x00;
+        } else if (r < 0.02) {
+            len = 1 + rng() % (RD03D_SIM_FRAME_SIZE - 1);
+        }
+        out.insert(out.end(), frame, frame + len);
+
+        if (uni(rng) < 0.01) {
+            size_t noise = 1 + rng() % 40;
+            for (size_t i = 0; i < noise; i++) {
+                out.push_back(uni(rng) < 0.5 ? noiseBytes[rng() % 6] : (uint8_t)rng());
+            }
+        }
+    }
+    return out;
+}
+
+static bool sameDecode(const DecodeLog& a, RD03D& ra, const DecodeLog& b, RD03D& rb) {
+    return a.callbacks == b.callbacks && a.hash == b.hash &&
+           ra.getFrameCount() == rb.getFrameCount() && ra.getErrorCount() == rb.getErrorCount();
+}
+
+static bool checkInput() {
+    const char* s = "input";
+    unsigned before = g_failures;
+    std::mt19937 rng(117);
+
+    std::vector<uint8_t> stream = faultyStream(200000, 117);
+
+    // Reference: one byte at a time, always through the stitching path
+    DecodeLog refLog = {0, 1469598103934665603ULL};
+    RD03D ref;
+    ref.onFrame(onLoggedFrame);
+    g_decodeLog = &refLog;
+    for (size_t i = 0; i < stream.size(); i++) ref.feed(&stream[i], 1);
+    expect(ref.getFrameCount() > 190000 && ref.getErrorCount() > 1000, s,
+           "stream does not exercise both frames and faults");
+
+    // Whole stream in one call, decoded in place
+    DecodeLog bulkLog = {0, 1469598103934665603ULL};
+    RD03D bulk;
+    bulk.onFrame(onLoggedFrame);
+    g_decodeLog = &bulkLog;
+    bulk.feed(stream.data(), stream.size());
+    expect(sameDecode(refLog, ref, bulkLog, bulk), s, "bulk feed() differs from byte-wise feed()");
+
+    // Rings of awkward sizes with a random starting wrap point, random
+    // write sizes and random byte budgets
+    static const size_t capacities[4] = {31, 61, 257, 1031};
+    static uint8_t storage[1031];
+    for (size_t c = 0; c < 4; c++) {
+        RD03D_RingSource ring(storage, capacities[c]);
+        uint8_t skip[64];
+        size_t offset = rng() % capacities[c];
+        while (offset > 0) {
+            size_t n = std::min(offset, sizeof(skip));
+            ring.write(skip, n);
+            ring.consume(n);
+            offset -= n;
+        }
+
+        DecodeLog ringLog = {0, 1469598103934665603ULL};
+        RD03D radar;
+        radar.onFrame(onLoggedFrame);
+        g_decodeLog = &ringLog;
+        size_t pos = 0;
+        uint32_t stops = 0;
+        while (pos < stream.size() || ring.available() > 0) {
+            size_t space = ring.getCapacity() - ring.available();
+            size_t n = std::min(std::min(space, (size_t)(1 + rng() % capacities[c])), stream.size() - pos);
+            pos += ring.write(stream.data() + pos, n);
+
+            size_t budget = rng() % 4 == 0 ? 0 : 1 + rng() % 90;
+            size_t queued = ring.available();
+            bool more = radar.update(ring, budget, 0);
+            expect(more == (ring.available() > 0) && radar.getBacklog() == ring.available(), s,
+                   "update(source) return value or backlog wrong");
+            if (budget > 0 && queued > budget) {
+                stops++;
+                expect(ring.available() == queued - budget, s, "byte budget consumed the wrong amount");
+            }
+        }
+        expect(ring.getOverflowCount() == 0, s, "ring overflowed although writes fit");
+        expect(stops > 0, s, "byte budget never stopped a drain");
+        expect(sameDecode(refLog, ref, ringLog, radar), s, "ring input differs from byte-wise feed()");
+    }
+
+    // Overflow: a 64-byte ring holds 63; excess bytes are dropped and counted
+    {
+        uint8_t buf[100] = {0};
+        RD03D_RingSource ring(storage, 64);
+        expect(ring.getCapacity() == 63, s, "ring capacity is not storage - 1");
+        expect(ring.write(buf, 100) == 63 && ring.getOverflowCount() == 37, s, "overflow on a full write");
+        expect(ring.write(buf, 10) == 0 && ring.getOverflowCount() == 47, s, "overflow on a write to a full ring");
+        ring.consume(20);
+        expect(ring.write(buf, 30) == 20 && ring.getOverflowCount() == 57, s, "overflow after a partial drain");
+        expect(ring.available() == 63, s, "ring not full after overflow");
+    }
+
+    // A time budget stops between frames and leaves the rest in the ring
+    {
+        RD03D_RingSource ring(storage, 1031);
+        uint8_t frame[RD03D_SIM_FRAME_SIZE];
+        Point p = {100, 1000};
+        makeFrame(&p, 1, frame);
+        for (int n = 0; n < 10; n++) ring.write(frame, sizeof(frame));
+
+        RD03D radar;
+        radar.onFrame(onBudgetFrame);
+        g_budgetCallbackMicros = 300;
+        bool more = radar.update(ring, 0, 1000);
+        uint32_t frames = radar.getFrameCount();
+        expect(more && frames >= 1 && frames < 10, s, "time budget did not stop part way");
+        expect(ring.available() == (10 - frames) * RD03D_SIM_FRAME_SIZE, s,
+               "time budget consumed bytes it did not decode");
+        while (radar.update(ring, 0, 1000)) {}
+        expect(radar.getFrameCount() == 10 && ring.available() == 0, s, "bytes left after the time budget were lost");
+        g_budgetCallbackMicros = 0;
+    }
+
+    bool ok = g_failures == before;
+    printf("%s: input (%zu-byte faulty stream, %u frames, %u errors: byte-wise = bulk = ring)\n",
+           ok ? "PASS" : "FAIL", stream.size(), (unsigned)ref.getFrameCount(), (unsigned)ref.getErrorCount());
+    return ok;
+}
+
+// ============== RESTORE ==============
+/**
+ * @brief Compare two trackers whose clocks differ by offset ms
+ */
+static bool sameTracks(RD03D_Tracker& a, RD03D_Tracker& b, uint32_t offset) {
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        const RD03D_Track& ta = *a.getTrack(i);
+        const RD03D_Track& tb = *b.getTrack(i);
+        if (ta.active != tb.active) return false;
+        if (!ta.active) continue;
+        if (ta.id != tb.id || ta.x != tb.x || ta.y != tb.y || ta.vx != tb.vx || ta.vy != tb.vy ||
+            ta.hits != tb.hits || ta.missed != tb.missed || ta.confirmed != tb.confirmed ||
+            ta.firstSeen != tb.firstSeen + offset || ta.lastSeen != tb.lastSeen + offset) {
+            return false;
+        }
+    }
+    return a.getRejectedCount() == b.getRejectedCount();
+}
+
+static bool sameSamples(RD03D_Tracker& a, uint32_t ta, RD03D_Tracker& b, uint32_t tb) {
+    RD03D_TrackSample sa[RD03D_MAX_TRACKS];
+    RD03D_TrackSample sb[RD03D_MAX_TRACKS];
+    if (a.sampleAt(ta, sa) != b.sampleAt(tb, sb)) return false;
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        if (sa[i].id != sb[i].id || sa[i].x != sb[i].x || sa[i].y != sb[i].y ||
+            sa[i].extrapolated != sb[i].extrapolated) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void resealState(uint8_t* state, size_t len) {
+    uint32_t crc = RD03D_ConfigBlob::crc32(state + 8, len - 8);
+    memcpy(state + 4, &crc, sizeof(crc));
+}
+
+static bool checkRestore() {
+    const char* s = "restore";
+    unsigned before = g_failures;
+
+    // three_people at 20 Hz: reset at 30 s, a fourth person enters at 42 s
+    std::vector<SimScene> scenes = rd03dSimScenes();
+    RD03D_Sim sim(scenes[2], SimRadarModel(), 118);
+    std::vector<ReplayFrame> frames = replayDecode(replaySimBytes(sim.run(20.0)));
+    const size_t resetAt = 600;
+    const uint32_t outage = 3000;           // ms the device is down
+    const uint32_t maxAge = 10000;
+
+    // Reference tracker that never resets: it just sees a gap
+    RD03D_Tracker ref;
+    uint32_t t = 1000;
+    for (size_t i = 0; i < resetAt; i++, t += 50) ref.update(frames[i].targets, t);
+    uint32_t saveNow = t - 50 + 20;
+    uint32_t saveStamp = 7000000;           // Persistent clock (e.g. RTC ms)
+    uint16_t maxIdAtSave = 0;
+    uint8_t activeAtSave = 0;
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        RD03D_Track* tr = ref.getTrack(i);
+        if (!tr->active) continue;
+        activeAtSave++;
+        if (tr->id > maxIdAtSave) maxIdAtSave = tr->id;
+    }
+    expect(activeAtSave >= 2, s, "scene has fewer than two tracks at the reset");
+
+    uint8_t state[RD03D_TRACKER_STATE_SIZE];
+    size_t len = ref.saveState(state, sizeof(state), saveNow, saveStamp);
+    expect(len == 28 + activeAtSave * 32u, s, "saved size does not match the active tracks");
+    expect(ref.saveState(state, len - 1, saveNow, saveStamp) == 0, s, "saveState() wrote past a short buffer");
+
+    // Reboot: millis() restarts, the persistent clock moved on by the outage
+    const uint32_t bootNow = 150;
+    RD03D_Tracker restored;
+    RD03D_RestoreResult r = restored.restoreState(state, len, bootNow, saveStamp + outage, maxAge);
+    uint32_t offset = saveNow + outage - bootNow;
+    expect(r == RD03D_RESTORE_OK, s, "intact state not restored");
+    expect(sameTracks(ref, restored, offset), s, "restored tracks or rebased times differ");
+    expect(sameSamples(ref, saveNow + outage, restored, bootNow), s, "restored update time differs");
+
+    // Both carry on: same tracks, same IDs, same filter steps
+    bool same = true;
+    bool samples = true;
+    uint16_t maxId = 0;
+    uint32_t tr = bootNow;
+    t = saveNow + outage;
+    for (size_t i = resetAt; i < frames.size(); i++, t += 50, tr += 50) {
+        ref.update(frames[i].targets, t);
+        restored.update(frames[i].targets, tr);
+        same &= sameTracks(ref, restored, offset);
+        samples &= sameSamples(ref, t + 25, restored, tr + 25);
+        for (uint8_t k = 0; k < RD03D_MAX_TRACKS; k++) {
+            if (restored.getTrack(k)->id > maxId) maxId = restored.getTrack(k)->id;
+        }
+    }
+    expect(same, s, "restored tracker diverged from the one that never reset");
+    expect(samples, s, "sampleAt() diverged after the restore");
+    expect(maxId > maxIdAtSave, s, "no new track after the restore to check ID continuity");
+
+    // Every rejection leaves the tracker untouched
+    uint8_t victimBefore[RD03D_TRACKER_STATE_SIZE];
+    uint8_t victimAfter[RD03D_TRACKER_STATE_SIZE];
+    size_t victimLen = restored.saveState(victimBefore, sizeof(victimBefore), tr, 1);
+    uint8_t bad[RD03D_TRACKER_STATE_SIZE];
+    struct Case {
+        const char* what;
+        RD03D_RestoreResult expected;
+        size_t size;
+        uint32_t stamp;
+    };
+    bool untouched = true;
+    auto attempt = [&](const Case& c, const uint8_t* buf) {
+        RD03D_RestoreResult got = restored.restoreState(buf, c.size, tr, c.stamp, maxAge);
+        if (got != c.expected) {
+            printf("  %s: %s returned %d, expected %d\n", s, c.what, got, c.expected);
+            g_failures++;
+        }
+        untouched &= restored.saveState(victimAfter, sizeof(victimAfter), tr, 1) == victimLen &&
+                     memcmp(victimBefore, victimAfter, victimLen) == 0;
+    };
+
+    memcpy(bad, state, len);
+    bad[len - 10] ^= 0x01;                  // Damaged track record
+    attempt({"flipped bit", RD03D_RESTORE_CRC, len, saveStamp + outage}, bad);
+    attempt({"stale", RD03D_RESTORE_STALE, len, saveStamp + maxAge + 1}, state);
+    attempt({"stamp ahead of the clock", RD03D_RESTORE_STALE, len, saveStamp - 1000}, state);
+    attempt({"truncated", RD03D_RESTORE_INVALID, len - 1, saveStamp + outage}, state);
+    attempt({"shorter than the header", RD03D_RESTORE_INVALID, 20, saveStamp + outage}, state);
+    attempt({"null buffer", RD03D_RESTORE_INVALID, len, saveStamp + outage}, nullptr);
+
+    memcpy(bad, state, len);
+    bad[0] ^= 0xFF;                         // Magic
+    attempt({"wrong magic", RD03D_RESTORE_INVALID, len, saveStamp + outage}, bad);
+
+    memcpy(bad, state, len);
+    bad[8]++;                               // Format, resealed
+    resealState(bad, len);
+    attempt({"unknown format", RD03D_RESTORE_INVALID, len, saveStamp + outage}, bad);
+
+    // Record layout: id, hits, missed, confirmed, slot, reserved, x, y, ...
+    memcpy(bad, state, len);
+    bad[28 + 32 + 6] = bad[28 + 6];         // Two records in one slot, resealed
+    resealState(bad, len);
+    attempt({"duplicate slot", RD03D_RESTORE_INVALID, len, saveStamp + outage}, bad);
+
+    memcpy(bad, state, len);
+    float nan = NAN;
+    memcpy(bad + 28 + 8, &nan, sizeof(nan));
+    resealState(bad, len);
+    attempt({"NaN position", RD03D_RESTORE_INVALID, len, saveStamp + outage}, bad);
+
+    expect(untouched, s, "a rejected restore changed the tracker");
+
+    bool ok = g_failures == before;
+    printf("%s: restore (%u tracks across a %u ms reset, IDs continue past %u, 10 rejections)\n",
+           ok ? "PASS" : "FAIL", activeAtSave, (unsigned)outage, maxIdAtSave);
+    return ok;
+}
+
+// ============== GESTURES ==============
+static int g_gestureSeen[RD03D_MAX_GESTURES];
+static uint32_t g_gestureEvents;
+
+static void onCheckGesture(const RD03D_GestureEvent& e) {
+    if (e.gesture < RD03D_MAX_GESTURES) g_gestureSeen[e.gesture]++;
+    g_gestureEvents++;
+}
+
+/**
+ * @brief One person moving along a scripted velocity profile
+ *
+ * Stands for 1 s, moves, then stands again, seen at hz frames per
+ * second with noiseMm of position noise.
+ * @param kind Gesture the move should produce, or -1 for walking through
+ * @return Events per gesture in g_gestureSeen
+ */
+static void gestureRun(int kind, double hz, double noiseMm, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, noiseMm > 0 ? noiseMm : 1e-9);
+
+    RD03D radar;
+    RD03D_Tracker tracker;
+    RD03D_GestureRecognizer gestures;
+    gestures.addDefaultGestures();
+    gestures.onGesture(onCheckGesture);
+    g_gestureEvents = 0;
+    memset(g_gestureSeen, 0, sizeof(g_gestureSeen));
+
+    // Brisk move: sin² velocity pulse peaking at 1.5 m/s over 0.7 s
+    const double pulse = 0.7, peak = 1500.0;
+    double dx = 0, dy = 0;
+    if (kind == RD03D_GESTURE_SWIPE_LEFT) dx = -1;
+    if (kind == RD03D_GESTURE_SWIPE_RIGHT) dx = 1;
+    if (kind == RD03D_GESTURE_APPROACH) dy = -1;
+    if (kind == RD03D_GESTURE_RETREAT) dy = 1;
+
+    uint8_t frame[RD03D_SIM_FRAME_SIZE];
+    const double duration = 4.0;
+    uint32_t t0 = millis();
+    for (uint32_t n = 0; n / hz < duration; n++) {
+        double t = n / hz;
+        double x, y;
+        if (kind < 0) {
+            // Walking through at a steady 1 m/s, diagonally
+            x = -1500 + 700 * t;
+            y = 1500 + 700 * t;
+        } else {
+            double s = t - 1.0;
+            double d;   // Distance covered along the move
+            if (s <= 0) {
+                d = 0;
+            } else if (s >= pulse) {
+                d = peak * pulse / 2;
+            } else {
+                d = peak * (s / 2 - pulse * sin(2 * M_PI * s / pulse) / (4 * M_PI));
+            }
+            x = 0 + dx * d;
+            y = 3000 + dy * d;
+        }
+        Point p = {(int)lround(x + noise(rng)), (int)lround(y + noise(rng))};
+        makeFrame(&p, 1, frame);
+
+        uint32_t now = t0 + (uint32_t)lround(t * 1000.0);
+        hostSetMicros((uint64_t)now * 1000);
+        radar.feed(frame, sizeof(frame));
+        const RD03D_Target* targets = radar.getTargets();
+        tracker.update(targets, now);
+        gestures.update(tracker, now);
+    }
+    hostAdvanceMicros(1000000);
+}
+
+static bool checkGestures() {
+    const char* s = "gestures";
+    unsigned before = g_failures;
+    static const double rates[3] = {10.0, 20.0, 50.0};
+    static const int kinds[4] = {RD03D_GESTURE_SWIPE_LEFT, RD03D_GESTURE_SWIPE_RIGHT,
+                                 RD03D_GESTURE_APPROACH, RD03D_GESTURE_RETREAT};
+
+    // Exact positions: every move is recognised once at every rate.
+    // With 30 mm noise a few moves are missed (the tracker's velocity
+    // gets noisier per frame as the rate rises), but none are mistaken
+    // and walking never matches.
+    static const double noises[2] = {0.0, 30.0};
+    const uint32_t seeds = 10;
+    for (int n = 0; n < 2; n++) {
+        for (int r = 0; r < 3; r++) {
+            unsigned matched = 0, wrong = 0, walking = 0;
+            for (uint32_t seed = 1; seed <= seeds; seed++) {
+                for (int k = 0; k < 4; k++) {
+                    gestureRun(kinds[k], rates[r], noises[n], seed * 4 + k);
+                    if (g_gestureSeen[kinds[k]] == 1) matched++;
+                    wrong += g_gestureEvents - (g_gestureSeen[kinds[k]] > 0 ? 1 : 0);
+                }
+                gestureRun(-1, rates[r], noises[n], seed);
+                walking += g_gestureEvents;
+            }
+            unsigned needed = n == 0 ? seeds * 4 : seeds * 4 * 85 / 100;
+            bool pass = matched >= needed && wrong == 0 && walking == 0;
+            printf("  %s: %2.0f mm noise, %2.0f Hz: %u/%u moves, %u wrong or repeated, %u on walking%s\n",
+                   s, noises[n], rates[r], matched, seeds * 4, wrong, walking, pass ? "" : " (FAIL)");
+            if (!pass) g_failures++;
+        }
+    }
+
+    bool ok = g_failures == before;
+    printf("%s: gestures (swipes and steps at 10, 20 and 50 Hz, none on steady walking)\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+// ============== WINDOW ==============
+/**
+ * @brief Brute-force statistics over the last samples of one series
+ */
+struct WindowReference {
+    double mean, variance;
+    float min, max, latest;
+};
+
+static WindowReference windowReference(const std::vector<float>& values, size_t end, size_t count) {
+    WindowReference r = {0, 0, values[end - 1], values[end - 1], values[end - 1]};
+    for (size_t k = end - count; k < end; k++) {
+        r.mean += values[k];
+        r.min = std::min(r.min, values[k]);
+        r.max = std::max(r.max, values[k]);
+    }
+    r.mean /= count;
+    for (size_t k = end - count; k < end; k++) {
+        r.variance += (values[k] - r.mean) * (values[k] - r.mean);
+    }
+    r.variance /= count;
+    return r;
+}
+
+/**
+ * @brief One series of a track that restarts at each entry of starts:
+ *        a fresh metre-scale offset, then random walks, steady ramps
+ *        (up to 3 m/s at 10 Hz) and runs of repeated values, kept within
+ *        the radar's ±8 m
+ */
+static std::vector<float> windowSeries(std::mt19937& rng, const std::vector<bool>& starts, bool speed) {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<float> out;
+    double v = 0;
+    while (out.size() < starts.size()) {
+        size_t run = 1 + (size_t)(uniform(rng) * 60);
+        int kind = (int)(uniform(rng) * 3);
+        double sigma = pow(10.0, uniform(rng) * 2);   // 1-100 mm
+        double slope = (uniform(rng) - 0.5) * 600;
+        for (size_t k = 0; k < run && out.size() < starts.size(); k++) {
+            if (starts[out.size()]) v = speed ? uniform(rng) * 3000 : (uniform(rng) - 0.5) * 16000;
+            if (kind == 0) v += std::normal_distribution<double>(0.0, sigma)(rng);
+            if (kind == 1) v += slope;
+            v = speed ? std::min(std::max(v, 0.0), 3000.0) : std::min(std::max(v, -8000.0), 8000.0);
+            double value = kind == 2 ? v : v + std::normal_distribution<double>(0.0, 0.1)(rng);
+            if (speed) value = std::max(0.0, round(value));   // Ties
+            out.push_back((float)value);
+        }
+    }
+    return out;
+}
+
+static bool checkWindow() {
+    const char* s = "window";
+    unsigned before = g_failures;
+
+    // Direct: every statistic after every add() against a brute-force
+    // window, with clear() at random points to cover partial windows
+    const size_t length = 200000;
+    std::mt19937 rng(7);
+    std::vector<bool> starts(length, false);
+    starts[0] = true;
+    for (size_t n = 1; n < length; n++) starts[n] = rng() % 5000 == 0;
+    std::vector<float> series[RD03D_WINDOW_VALUES];
+    series[RD03D_WINDOW_X] = windowSeries(rng, starts, false);
+    series[RD03D_WINDOW_Y] = windowSeries(rng, starts, false);
+    series[RD03D_WINDOW_SPEED] = windowSeries(rng, starts, true);
+
+    RD03D_TrackWindow window;
+    size_t start = 0;
+    double worstMean = 0, worstVar = 0;
+    unsigned wrongExtreme = 0, wrongCount = 0;
+    for (size_t n = 0; n < length; n++) {
+        if (starts[n] && n > 0) {
+            window.clear();
+            start = n;
+            if (window.getCount() != 0 || window.getMean(RD03D_WINDOW_X) != 0) wrongCount++;
+        }
+        window.add(series[0][n], series[1][n], series[2][n]);
+
+        size_t count = std::min(n + 1 - start, (size_t)RD03D_TRACK_WINDOW);
+        if (window.getCount() != count || window.isFull() != (count == RD03D_TRACK_WINDOW)) wrongCount++;
+        for (int v = 0; v < RD03D_WINDOW_VALUES; v++) {
+            RD03D_WindowValue value = (RD03D_WindowValue)v;
+            WindowReference r = windowReference(series[v], n + 1, count);
+            double range = (double)r.max - r.min;
+            // Float resolution at the offset for the mean. The pivot can be
+            // a window old, so right after a fast move the variance carries
+            // about 1 mm² of rounding; allow 4 mm² (2 mm standard
+            // deviation). Without the pivot, cancellation at 8 m costs
+            // several times that
+            double meanErr = fabs(window.getMean(value) - r.mean) / (1e-6 * fabs(r.mean) + 1e-4 * range + 1e-2);
+            double varErr = fabs(window.getVariance(value) - r.variance) / (1e-4 * range * range + 4.0);
+            worstMean = std::max(worstMean, meanErr);
+            worstVar = std::max(worstVar, varErr);
+            if (window.getMin(value) != r.min || window.getMax(value) != r.max ||
+                window.getLatest(value) != r.latest) {
+                wrongExtreme++;
+            }
+        }
+    }
+    printf("  %s: %zu samples, worst mean error %.2f, variance error %.2f of tolerance\n",
+           s, length, worstMean, worstVar);
+    expect(wrongCount == 0, s, "count or isFull() does not match the samples added");
+    expect(worstMean <= 1.0, s, "mean drifts from the brute-force window");
+    expect(worstVar <= 1.0, s, "variance drifts from the brute-force window");
+    expect(wrongExtreme == 0, s, "min, max or latest differs from the brute-force window");
+
+    // Through the tracker: the window belongs to the track, so a slot
+    // that is dropped and restarted holds only the new track's samples
+    RD03D radar;
+    RD03D_Tracker tracker;
+    uint8_t frame[RD03D_SIM_FRAME_SIZE];
+    auto step = [&](const Point* p, int count) {
+        makeFrame(p, count, frame);
+        hostAdvanceMicros(100000);
+        radar.feed(frame, sizeof(frame));
+        tracker.update(radar.getTargets(), millis());
+    };
+
+    Point far = {-2000, 5000};
+    for (int n = 0; n < 20; n++) step(&far, 1);
+    uint16_t firstId = tracker.getTrack(0)->id;
+    const RD03D_TrackWindow* w = tracker.getWindow(0);
+    expect(tracker.getTrack(0)->active && w->isFull(), s, "standing track did not fill its window");
+
+    // Coasting frames still count; past coastFrames the track and its
+    // window are gone
+    RD03D_TrackerConfig tc;
+    tc.setDefaults();
+    for (int n = 0; n < tc.coastFrames; n++) step(nullptr, 0);
+    expect(w->isFull() && tracker.getTrack(0)->active, s, "coasting track lost its window");
+    step(nullptr, 0);
+    expect(!tracker.getTrack(0)->active && w->getCount() == 0, s, "window not cleared with its track");
+
+    Point near = {1000, 1000};
+    for (int n = 0; n < 3; n++) step(&near, 1);
+    expect(tracker.getTrack(0)->active && tracker.getTrack(0)->id != firstId, s, "slot 0 not reused");
+    expect(w->getCount() == 3 && w->getMin(RD03D_WINDOW_X) > 900 && w->getMax(RD03D_WINDOW_Y) < 1100,
+           s, "restarted track sees the old track's samples");
+
+    tracker.reset();
+    expect(w->getCount() == 0, s, "reset() left samples in the window");
+
+    // With every slot busy, a new detection replaces the track missing
+    // longest, and the slot's window starts again
+    Point abc[3] = {{-2500, 2000}, {-800, 2000}, {800, 2000}};
+    Point abd[3] = {{-2500, 2000}, {-800, 2000}, {2500, 2000}};
+    Point abe[3] = {{-2500, 2000}, {-800, 2000}, {0, 4000}};
+    for (int n = 0; n < 20; n++) step(abc, 3);
+    uint16_t replacedId = tracker.getTrack(2)->id;
+    for (int n = 0; n < 2; n++) step(abd, 3);
+    step(abe, 3);
+    RD03D_Track* t = tracker.getTrack(2);
+    w = tracker.getWindow(2);
+    expect(t->active && t->id != replacedId && fabsf(t->y - 4000) < 1, s, "coasting track not replaced");
+    expect(w->getCount() == 1 && w->getLatest(RD03D_WINDOW_Y) == t->y && w->getMin(RD03D_WINDOW_Y) > 3900,
+           s, "replacing track sees the old track's samples");
+    expect(tracker.getWindow(0)->isFull() && tracker.getWindow(3)->getCount() == 3, s,
+           "other tracks' windows disturbed");
+
+    bool ok = g_failures == before;
+    printf("%s: window (rolling statistics against brute force, cleared on restart)\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+// ============== SAMPLE ==============
+static bool near(float a, float b) {
+    return fabsf(a - b) < 0.01f;
+}
+
+static bool checkSample() {
+    const char* s = "sample";
+    unsigned before = g_failures;
+
+    RD03D radar;
+    RD03D_Tracker tracker;
+    RD03D_TrackSample samples[RD03D_MAX_TRACKS];
+    uint8_t frame[RD03D_SIM_FRAME_SIZE];
+    uint32_t now = millis();
+    auto step = [&](uint32_t ms, Point p) {
+        now += ms;
+        hostSetMicros((uint64_t)now * 1000);
+        makeFrame(&p, 1, frame);
+        radar.feed(frame, sizeof(frame));
+        tracker.update(radar.getTargets(), now);
+    };
+
+    expect(tracker.sampleAt(now, samples) == 0 && samples[0].id == 0, s, "empty tracker sampled a track");
+
+    // Walking across at 1 m/s at 25 Hz
+    for (int n = 0; n < 25; n++) step(40, {-1000 + 40 * n, 2000});
+    RD03D_Track prev = *tracker.getTrack(0);
+    uint32_t prevTime = now;
+    step(40, {0, 2000});
+    const RD03D_Track& last = *tracker.getTrack(0);
+    expect(last.isValid() && last.vx > 500, s, "walking target not tracked");
+    expect(radar.getFrameInterval() == 0, s, "feed() input measured a frame interval");
+
+    // Between the last two updates: linear in time, not extrapolated
+    bool interpolated = true;
+    for (uint32_t d = 0; d <= 40; d += 4) {
+        float u = d / 40.0f;
+        interpolated &= tracker.sampleAt(prevTime + d, samples) == 1;
+        interpolated &= samples[0].id == last.id && !samples[0].extrapolated;
+        interpolated &= near(samples[0].x, prev.x + (last.x - prev.x) * u);
+        interpolated &= near(samples[0].y, prev.y + (last.y - prev.y) * u);
+        interpolated &= samples[0].vx == last.vx && samples[0].vy == last.vy;
+    }
+    expect(interpolated, s, "positions between two updates are not interpolated");
+    tracker.sampleAt(prevTime - 200, samples);
+    expect(near(samples[0].x, prev.x) && !samples[0].extrapolated, s, "time before the previous update not held");
+
+    // Past the last update: along the velocity up to the horizon, then held
+    bool extrapolated = true;
+    for (uint32_t d = 1; d <= RD03D_SAMPLE_HORIZON; d += 7) {
+        tracker.sampleAt(now + d, samples);
+        extrapolated &= samples[0].extrapolated;
+        extrapolated &= near(samples[0].x, last.x + last.vx * d / 1000.0f);
+        extrapolated &= near(samples[0].y, last.y + last.vy * d / 1000.0f);
+    }
+    expect(extrapolated, s, "positions after the last update are not extrapolated");
+    bool held = true;
+    static const uint32_t past[4] = {RD03D_SAMPLE_HORIZON + 1, 250, 2000, 600000};
+    for (uint32_t d : past) {
+        tracker.sampleAt(now + d, samples);
+        held &= samples[0].extrapolated;
+        held &= near(samples[0].x, last.x + last.vx * RD03D_SAMPLE_HORIZON / 1000.0f);
+        held &= near(samples[0].y, last.y + last.vy * RD03D_SAMPLE_HORIZON / 1000.0f);
+    }
+    expect(held, s, "extrapolation not clamped at RD03D_SAMPLE_HORIZON");
+
+    // After a gap of over a second, the previous position is too old to
+    // interpolate from: the latest one is held up to the update
+    uint32_t gapStart = now;
+    step(1500, {1000, 2000});    // The tracker predicts at most 1 s ahead
+    expect(last.isValid() && last.missed == 0 && tracker.getTrackCount() == 1, s, "track lost over the gap");
+    bool latest = true;
+    for (uint32_t d = 0; d <= 1500; d += 250) {
+        tracker.sampleAt(gapStart + d, samples);
+        latest &= !samples[0].extrapolated && near(samples[0].x, last.x) && near(samples[0].y, last.y);
+    }
+    expect(latest, s, "interpolated across a gap longer than 1 s");
+    RD03D_Track beforeStep = *tracker.getTrack(0);
+    step(50, {1050, 2000});
+    tracker.sampleAt(now - 25, samples);
+    expect(!samples[0].extrapolated && near(samples[0].x, (beforeStep.x + last.x) / 2), s,
+           "interpolation not back after the gap");
+
+    // Tracks that are not confirmed are not sampled
+    tracker.reset();
+    step(50, {0, 2000});
+    expect(tracker.sampleAt(now, samples) == 0 && samples[0].id == 0, s, "unconfirmed track sampled");
+
+    bool ok = g_failures == before;
+    printf("%s: sample (interpolation, extrapolation, horizon clamp, long gaps)\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+// ============== MAIN ==============
+struct Section {
+    const char* name;
+    bool (*run)();
+};
+
+static const Section SECTIONS[] = {
+    {"pose", checkPose},
+    {"budget", checkBudget},
+    {"conflation", checkConflation},
+    {"idle", checkIdle},
+    {"input", checkInput},
+    {"restore", checkRestore},
+    {"gestures", checkGestures},
+    {"window", checkWindow},
+    {"sample", checkSample},
+};
+
+int main(int argc, char** argv) {
+    hostUseVirtualClock(true);
+    hostSetMicros(1000000);
+
+    const size_t count = sizeof(SECTIONS) / sizeof(SECTIONS[0]);
+    bool ok = true;
+    if (argc < 2) {
+        for (size_t i = 0; i < count; i++) {
+            ok &= SECTIONS[i].run();
+        }
+        return ok ? 0 : 1;
+    }
+
+    for (int a = 1; a < argc; a++) {
+        size_t i = 0;
+        while (i < count && strcmp(argv[a], SECTIONS[i].name) != 0) i++;
+        if (i == count) {
+            fprintf(stderr, "unknown section '%s'\nsections:", argv[a]);
+            for (size_t j = 0; j < count; j++) fprintf(stderr, " %s", SECTIONS[j].name);
+            fprintf(stderr, "\n");
+            return 2;
+        }
+        ok &= SECTIONS[i].run();
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,730 @@
+/**
+ * @file emulator.cpp
+ * @brief Virtual RD-03D on a pseudo terminal
+ *
+ * Exposes a pty that behaves like the radar's UART: frames from a
+ * capture or the built-in simulator scenes are sent at the frame rate,
+ * paced at the real 256000-baud byte rate (39 us per byte), and commands
+ * in the FD FC FB FA envelope are answered with ACKs:
+ *
+ *   0x00FF enable config    ACK with protocol version and buffer size;
+ *                           frames stop until 0x00FE
+ *   0x00FE end config       ACK
+ *   0x0080 single target    ACK, only target 1 is reported from now on
+ *   0x0090 multi target     ACK, all three targets are reported
+ *   anything else           ACK with status 1 (failed)
+ *
+ * Like the radar, the emulator boots in single-target mode. With
+ * --strict, mode commands outside config mode fail.
+ *
+ * Faults, scheduled with --fault or at random with --fault-every:
+ *   silence:<ms>    Output stops mid-frame (loose cable, stalled radar)
+ *   reboot          Output stops mid-frame, the radar boots for --boot ms,
+ *                   then comes back in single-target mode
+ *   garbage:<n>     n random bytes on the line, spliced into a frame
+ *
+ * Every command, mode change and fault is logged to stderr with its time.
+ * For recovery benchmarks the log reports how long the host took to
+ * restore multi-target mode after each reboot, and a summary at exit.
+ *
+ * --check runs the library against the emulator over the pty: begin()'s
+ * multi-target command, a garbage burst (byte rate), a reboot with
+ * re-enable on the resumed stream, and a silence.
+ *
+ * Build: see extras/host/README.md (needs -pthread)
+ *
+ * Usage:
+ *   ./emulator [options] [capture.bin ...]
+ *     -L <path>            Also create a symlink to the pty (e.g. /tmp/ttyRD03D)
+ *     -r <hz>              Frame rate (default 20)
+ *     -s <name>            Simulator scene (default: all, looped)
+ *     -d <seconds>         Run time (default: until interrupted)
+ *     --multi              Boot in multi-target mode
+ *     --strict             Reject mode commands outside config mode
+ *     --boot <ms>          Reboot time (default 500)
+ *     --fault <t>:<kind>[:<n>]   Fault at t seconds (repeatable)
+ *     --fault-every <s>    Random faults, s seconds apart on average
+ *     --seed <n>           Random seed (default 1)
+ *   ./emulator --check
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_Replay.h"
+#include "RD03D_Sim.h"
+
+#define EMU_BYTE_SECONDS   (10.0 / RD03D_BAUD_RATE)   // 8N1: 10 bits per byte
+#define EMU_TICK_SECONDS   0.0005                     // Line is serviced every 0.5 ms
+
+typedef std::array<uint8_t, RD03D_FRAME_SIZE> EmuFrame;
+typedef std::chrono::steady_clock Clock;
+
+// ============== SETTINGS ==============
+enum FaultKind { FAULT_SILENCE, FAULT_REBOOT, FAULT_GARBAGE };
+
+struct EmuFault {
+    double at;          // Seconds after start
+    FaultKind kind;
+    uint32_t amount;    // ms of silence, bytes of garbage
+};
+
+struct EmuOptions {
+    std::string link;
+    double rateHz = 20.0;
+    std::string scene;
+    double seconds = 0.0;
+    bool startMulti = false;
+    bool strict = false;
+    uint32_t bootMs = 500;
+    std::vector<EmuFault> faults;
+    double faultEvery = 0.0;
+    uint32_t seed = 1;
+    std::vector<std::string> captures;
+};
+
+static bool parseFault(const char* text, EmuFault& out) {
+    char kind[16] = {0};
+    unsigned amount = 0;
+    double at = 0.0;
+    if (sscanf(text, "%lf:%15[a-z]:%u", &at, kind, &amount) < 2) return false;
+    out.at = at;
+    if (strcmp(kind, "silence") == 0) {
+        out.kind = FAULT_SILENCE;
+        out.amount = amount ? amount : 2000;
+    } else if (strcmp(kind, "reboot") == 0) {
+        out.kind = FAULT_REBOOT;
+        out.amount = 0;
+    } else if (strcmp(kind, "garbage") == 0) {
+        out.kind = FAULT_GARBAGE;
+        out.amount = amount ? amount : 64;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// ============== FRAME SOURCES ==============
+/**
+ * @brief Cut a raw capture into frames (bytes between frames are dropped)
+ */
+static void framesFromBytes(const std::vector<uint8_t>& bytes, std::vector<EmuFrame>& out) {
+    static const uint8_t header[4] = {0xAA, 0xFF, 0x03, 0x00};
+    for (size_t i = 0; i + RD03D_FRAME_SIZE <= bytes.size();) {
+        if (memcmp(&bytes[i], header, 4) == 0 && bytes[i + 28] == 0x55 && bytes[i + 29] == 0xCC) {
+            EmuFrame f;
+            memcpy(f.data(), &bytes[i], RD03D_FRAME_SIZE);
+            out.push_back(f);
+            i += RD03D_FRAME_SIZE;
+        } else {
+            i++;
+        }
+    }
+}
+
+static bool loadFrames(const EmuOptions& opt, std::vector<EmuFrame>& out) {
+    for (const std::string& path : opt.captures) {
+        std::vector<uint8_t> bytes;
+        if (!replayLoadFile(path, bytes)) {
+            fprintf(stderr, "Cannot read %s\n", path.c_str());
+            return false;
+        }
+        framesFromBytes(bytes, out);
+    }
+    if (opt.captures.empty()) {
+        uint32_t seed = opt.seed;
+        for (const SimScene& scene : rd03dSimScenes()) {
+            if (!opt.scene.empty() && scene.name != opt.scene) continue;
+            RD03D_Sim sim(scene, SimRadarModel(), seed++);
+            framesFromBytes(replaySimBytes(sim.run(opt.rateHz)), out);
+        }
+    }
+    if (out.empty()) fprintf(stderr, "No frames to send\n");
+    return !out.empty();
+}
+
+// ============== VIRTUAL RADAR ==============
+class VirtualRadar {
+public:
+    VirtualRadar(const EmuOptions& opt, const std::vector<EmuFrame>& frames)
+        : _opt(opt), _frames(frames), _rng(opt.seed) {}
+
+    ~VirtualRadar() {
+        if (_slave >= 0) close(_slave);
+        if (_master >= 0) close(_master);
+        if (!_opt.link.empty()) unlink(_opt.link.c_str());
+    }
+
+    bool open() {
+        _master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (_master < 0 || grantpt(_master) != 0 || unlockpt(_master) != 0) return false;
+        const char* name = ptsname(_master);
+        if (!name) return false;
+        _slaveName = name;
+
+        // Held open so output is never refused for want of a reader; raw so
+        // commands are not echoed back like a terminal would
+        _slave = ::open(name, O_RDWR | O_NOCTTY);
+        if (_slave < 0) return false;
+        termios tio;
+        tcgetattr(_slave, &tio);
+        cfmakeraw(&tio);
+        tcsetattr(_slave, TCSANOW, &tio);
+        fcntl(_master, F_SETFL, fcntl(_master, F_GETFL) | O_NONBLOCK);
+
+        if (!_opt.link.empty()) {
+            unlink(_opt.link.c_str());
+            if (symlink(name, _opt.link.c_str()) != 0) perror("symlink");
+        }
+        return true;
+    }
+
+    const std::string& slaveName() const { return _slaveName; }
+
+    void run(const std::atomic<bool>& stop) {
+        _start = Clock::now();
+        _multi = _opt.startMulti;
+        log("start: %s, %s mode, %.1f Hz, %zu frames", _slaveName.c_str(),
+            _multi ? "multi-target" : "single-target", _opt.rateHz, _frames.size());
+
+        std::vector<EmuFault> faults = _opt.faults;
+        std::exponential_distribution<double> nextFault(_opt.faultEvery > 0.0 ? 1.0 / _opt.faultEvery : 1.0);
+        double randomFault = _opt.faultEvery > 0.0 ? nextFault(_rng) : -1.0;
+        double period = 1.0 / _opt.rateHz;
+        double nextFrame = 0.0;
+
+        while (!stop) {
+            double now = elapsed();
+            if (_opt.seconds > 0.0 && now >= _opt.seconds) break;
+
+            // Scheduled and random faults
+            for (size_t i = 0; i < faults.size();) {
+                if (faults[i].at <= now) {
+                    inject(faults[i], now);
+                    faults.erase(faults.begin() + i);
+                } else {
+                    i++;
+                }
+            }
+            if (randomFault >= 0.0 && randomFault <= now) {
+                std::uniform_int_distribution<int> kind(0, 2);
+                std::uniform_int_distribution<uint32_t> ms(300, 3000);
+                std::uniform_int_distribution<uint32_t> bytes(8, 256);
+                EmuFault f;
+                f.at = now;
+                f.kind = (FaultKind)kind(_rng);
+                f.amount = f.kind == FAULT_SILENCE ? ms(_rng) : bytes(_rng);
+                inject(f, now);
+                randomFault = now + nextFault(_rng);
+            }
+
+            if (_booting && now >= _bootUntil) {
+                _booting = false;
+                log("booted: single-target mode");
+            }
+            if (_silent && now >= _silentUntil) {
+                _silent = false;
+                log("silence over");
+            }
+
+            // Frames keep their schedule through faults, like a radar that
+            // is measuring but not heard
+            while (nextFrame <= now) {
+                if (!_booting && !_silent && !_config) sendFrame(now);
+                else _framesSuppressed++;
+                nextFrame += period;
+            }
+
+            readCommands(now);
+            pumpLine(now);
+
+            // Sleep until the next frame or line tick, waking for commands
+            double wake = nextFrame;
+            if (!_line.empty()) wake = std::min(wake, now + EMU_TICK_SECONDS);
+            if (_booting) wake = std::min(wake, _bootUntil);
+            if (_silent) wake = std::min(wake, _silentUntil);
+            for (const EmuFault& f : faults) wake = std::min(wake, f.at);
+            double wait = std::max(0.0, wake - elapsed());
+            pollfd pfd = {_master, POLLIN, 0};
+            timespec ts = {(time_t)wait, (long)((wait - (time_t)wait) * 1e9)};
+            ppoll(&pfd, 1, &ts, nullptr);
+        }
+        summary();
+    }
+
+private:
+    const EmuOptions& _opt;
+    const std::vector<EmuFrame>& _frames;
+    std::mt19937 _rng;
+    int _master = -1;
+    int _slave = -1;
+    std::string _slaveName;
+    Clock::time_point _start;
+
+    // Radar state
+    bool _multi = false;
+    bool _config = false;
+    bool _booting = false;
+    double _bootUntil = 0.0;
+    bool _silent = false;
+    double _silentUntil = 0.0;
+    size_t _cursor = 0;
+    std::vector<EmuFault> _armed;  // Faults waiting for the next frame
+
+    // UART
+    std::deque<uint8_t> _line;     // Bytes waiting to go out
+    double _lineClock = 0.0;       // Time the next byte may start
+    std::vector<uint8_t> _rx;      // Command bytes received
+
+    // Recovery: reboot time while multi-target mode is lost
+    double _lostMultiAt = -1.0;
+    std::vector<double> _recoveries;
+
+    // Counters
+    uint64_t _framesSent = 0;
+    uint64_t _singleFrames = 0;
+    uint64_t _framesSuppressed = 0;
+    uint64_t _bytesSent = 0;
+    uint64_t _bytesUnread = 0;     // Dropped because the pty buffer was full
+    uint32_t _commands = 0;
+    uint32_t _naks = 0;
+    uint32_t _faultCount[3] = {0, 0, 0};
+
+    double elapsed() const {
+        return std::chrono::duration<double>(Clock::now() - _start).count();
+    }
+
+    void log(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, fmt);
+        fprintf(stderr, "[%9.3f] ", elapsed());
+        vfprintf(stderr, fmt, args);
+        fprintf(stderr, "\n");
+        va_end(args);
+    }
+
+    void queue(const uint8_t* data, size_t len) {
+        if (_line.empty() && _lineClock < elapsed()) _lineClock = elapsed();  // Idle line
+        _line.insert(_line.end(), data, data + len);
+    }
+
+    void sendFrame(double now) {
+        EmuFrame f = _frames[_cursor];
+        _cursor = (_cursor + 1) % _frames.size();
+        if (!_multi) {
+            memset(f.data() + 4 + RD03D_TARGET_DATA_SIZE, 0, 2 * RD03D_TARGET_DATA_SIZE);
+            _singleFrames++;
+        }
+        _framesSent++;
+        if (_armed.empty()) {
+            queue(f.data(), f.size());
+            return;
+        }
+
+        // An armed fault cuts the frame: garbage is spliced in, silence and
+        // reboot leave it unfinished
+        EmuFault fault = _armed.front();
+        _armed.erase(_armed.begin());
+        std::uniform_int_distribution<size_t> at(1, RD03D_FRAME_SIZE - 1);
+        size_t cut = at(_rng);
+        queue(f.data(), cut);
+        apply(fault, now);
+        if (fault.kind == FAULT_GARBAGE) queue(f.data() + cut, f.size() - cut);
+    }
+
+    /**
+     * @brief Write every byte whose slot on the 256000-baud line has come
+     */
+    void pumpLine(double now) {
+        if (_line.empty() || _lineClock > now) return;
+        size_t due = (size_t)((now - _lineClock) / EMU_BYTE_SECONDS) + 1;
+        if (due > _line.size()) due = _line.size();
+
+        uint8_t buf[1024];
+        size_t n = std::min(due, sizeof(buf));
+        std::copy(_line.begin(), _line.begin() + n, buf);
+        _line.erase(_line.begin(), _line.begin() + n);
+        _lineClock += n * EMU_BYTE_SECONDS;
+
+        // The radar never waits: bytes nobody reads are lost
+        ssize_t w = write(_master, buf, n);
+        size_t written = w > 0 ? (size_t)w : 0;
+        _bytesSent += written;
+        _bytesUnread += n - written;
+    }
+
+    /**
+     * @brief Start a fault; while frames flow it hits the next frame mid-way
+     */
+    void inject(const EmuFault& f, double now) {
+        _faultCount[f.kind]++;
+        if (!_booting && !_silent && !_config) {
+            _armed.push_back(f);
+        } else {
+            apply(f, now);
+        }
+    }
+
+    void apply(const EmuFault& f, double now) {
+        switch (f.kind) {
+            case FAULT_SILENCE:
+                _silent = true;
+                _silentUntil = now + f.amount / 1000.0;
+                log("fault: silence for %u ms", f.amount);
+                break;
+            case FAULT_REBOOT:
+                _booting = true;
+                _bootUntil = now + _opt.bootMs / 1000.0;
+                _config = false;
+                _rx.clear();
+                if (_multi && _lostMultiAt < 0.0) _lostMultiAt = now;
+                _multi = false;
+                log("fault: reboot (%u ms), back in single-target mode", _opt.bootMs);
+                break;
+            case FAULT_GARBAGE: {
+                std::uniform_int_distribution<int> byte(0, 255);
+                std::vector<uint8_t> junk(f.amount);
+                for (uint8_t& b : junk) b = (uint8_t)byte(_rng);
+                queue(junk.data(), junk.size());
+                log("fault: %u garbage bytes", f.amount);
+                break;
+            }
+        }
+    }
+
+    // ============== COMMANDS ==============
+    void readCommands(double now) {
+        uint8_t buf[256];
+        ssize_t n;
+        while ((n = read(_master, buf, sizeof(buf))) > 0) {
+            if (_booting) continue;             // Not listening yet
+            _rx.insert(_rx.end(), buf, buf + n);
+        }
+
+        static const uint8_t head[4] = {0xFD, 0xFC, 0xFB, 0xFA};
+        static const uint8_t tail[4] = {0x04, 0x03, 0x02, 0x01};
+        for (;;) {
+            // Drop bytes up to the next preamble
+            size_t start = 0;
+            while (start + 4 <= _rx.size() && memcmp(&_rx[start], head, 4) != 0) start++;
+            if (start > 0) {
+                if (start + 4 > _rx.size()) start = _rx.size() > 3 ? _rx.size() - 3 : 0;
+                _rx.erase(_rx.begin(), _rx.begin() + start);
+            }
+            if (_rx.size() < 6) return;
+
+            size_t len = _rx[4] | (_rx[5] << 8);
+            if (len < 2 || len > 64) {
+                log("command: bad length %zu, dropped", len);
+                _rx.erase(_rx.begin(), _rx.begin() + 4);
+                continue;
+            }
+            size_t total = 6 + len + 4;
+            if (_rx.size() < total) return;
+            if (memcmp(&_rx[6 + len], tail, 4) != 0) {
+                log("command: bad postamble, dropped");
+                _rx.erase(_rx.begin(), _rx.begin() + 4);
+                continue;
+            }
+            uint16_t cmd = _rx[6] | (_rx[7] << 8);
+            handleCommand(cmd, &_rx[8], len - 2, now);
+            _rx.erase(_rx.begin(), _rx.begin() + total);
+        }
+    }
+
+    void handleCommand(uint16_t cmd, const uint8_t* value, size_t valueLen, double now) {
+        (void)value;
+        (void)valueLen;
+        _commands++;
+        bool modeAllowed = _config || !_opt.strict;
+
+        switch (cmd) {
+            case 0x00FF: {
+                static const uint8_t info[4] = {0x01, 0x00, 0x40, 0x00};  // Protocol 1, buffer 64
+                _config = true;
+                ack(cmd, true, info, sizeof(info));
+                log("command 0x00FF: enable config -> ACK, frames paused");
+                break;
+            }
+            case 0x00FE:
+                _config = false;
+                ack(cmd, true);
+                log("command 0x00FE: end config -> ACK, frames resume");
+                break;
+            case 0x0080:
+            case 0x0090: {
+                bool multi = cmd == 0x0090;
+                const char* name = multi ? "multi-target" : "single-target";
+                if (!modeAllowed) {
+                    ack(cmd, false);
+                    log("command 0x%04X: %s outside config mode -> NAK", cmd, name);
+                    break;
+                }
+                ack(cmd, true);
+                if (multi && _lostMultiAt >= 0.0) {
+                    _recoveries.push_back(now - _lostMultiAt);
+                    log("command 0x0090: multi-target -> ACK, restored %.0f ms after reboot",
+                        (now - _lostMultiAt) * 1000.0);
+                    _lostMultiAt = -1.0;
+                } else {
+                    log("command 0x%04X: %s -> ACK%s", cmd, name, multi == _multi ? " (unchanged)" : "");
+                }
+                if (!multi && _multi) _lostMultiAt = -1.0;  // Host chose single mode
+                _multi = multi;
+                break;
+            }
+            default:
+                ack(cmd, false);
+                log("command 0x%04X: unknown -> NAK", cmd);
+                break;
+        }
+    }
+
+    void ack(uint16_t cmd, bool ok, const uint8_t* data = nullptr, size_t len = 0) {
+        if (!ok) _naks++;
+        uint8_t out[32];
+        size_t n = 0;
+        static const uint8_t head[4] = {0xFD, 0xFC, 0xFB, 0xFA};
+        static const uint8_t tail[4] = {0x04, 0x03, 0x02, 0x01};
+        memcpy(out, head, 4);
+        n = 4;
+        size_t body = 4 + len;
+        out[n++] = (uint8_t)body;
+        out[n++] = (uint8_t)(body >> 8);
+        out[n++] = (uint8_t)cmd;
+        out[n++] = (uint8_t)((cmd >> 8) | 0x01);    // ACK: command word with 0x0100 set
+        out[n++] = ok ? 0x00 : 0x01;
+        out[n++] = 0x00;
+        if (len > 0) memcpy(out + n, data, len);
+        n += len;
+        memcpy(out + n, tail, 4);
+        n += 4;
+        queue(out, n);
+    }
+
+    void summary() {
+        double t = elapsed();
+        log("stop");
+        fprintf(stderr, "frames sent %llu (%llu single-target), %llu suppressed by faults or config mode\n",
+                (unsigned long long)_framesSent, (unsigned long long)_singleFrames,
+                (unsigned long long)_framesSuppressed);
+        fprintf(stderr, "bytes sent %llu (%.0f B/s average, line max %.0f B/s), %llu unread\n",
+                (unsigned long long)_bytesSent, t > 0 ? _bytesSent / t : 0.0, 1.0 / EMU_BYTE_SECONDS,
+                (unsigned long long)_bytesUnread);
+        fprintf(stderr, "commands %u (%u NAK), faults: %u silence, %u reboot, %u garbage\n",
+                _commands, _naks, _faultCount[FAULT_SILENCE], _faultCount[FAULT_REBOOT],
+                _faultCount[FAULT_GARBAGE]);
+        if (!_recoveries.empty()) {
+            double sum = 0.0;
+            double worst = 0.0;
+            for (double r : _recoveries) {
+                sum += r;
+                worst = std::max(worst, r);
+            }
+            fprintf(stderr, "multi-target restored after %zu reboots: mean %.0f ms, max %.0f ms\n",
+                    _recoveries.size(), sum / _recoveries.size() * 1000.0, worst * 1000.0);
+        }
+        if (_lostMultiAt >= 0.0) {
+            fprintf(stderr, "multi-target NOT restored since the reboot at %.3f s\n", _lostMultiAt);
+        }
+    }
+
+public:
+    bool isMulti() const { return _multi; }
+    size_t recoveryCount() const { return _recoveries.size(); }
+};
+
+// ============== SELF-CHECK ==============
+static uint32_t g_checkFrames = 0;
+static uint32_t g_checkMultiFrames = 0;     // Frames with a target beyond slot 1
+static uint32_t g_checkLastFrame = 0;
+static bool g_checkResumed = false;
+
+static void checkOnFrame(RD03D_Target* targets, uint8_t count) {
+    (void)count;
+    uint32_t now = millis();
+    if (g_checkFrames > 0 && now - g_checkLastFrame > 300) g_checkResumed = true;
+    g_checkLastFrame = now;
+    g_checkFrames++;
+    if (targets[1].valid || targets[2].valid) g_checkMultiFrames++;
+}
+
+static bool findBytes(const std::vector<uint8_t>& hay, const uint8_t* needle, size_t len) {
+    return std::search(hay.begin(), hay.end(), needle, needle + len) != hay.end();
+}
+
+static int runCheck() {
+    EmuOptions opt;
+    opt.scene = "three_people";
+    opt.seconds = 5.0;
+    opt.faults.push_back({1.0, FAULT_GARBAGE, 5120});   // 0.2 s of line time, mid-frame
+    opt.faults.push_back({2.0, FAULT_REBOOT, 0});
+    opt.faults.push_back({3.5, FAULT_SILENCE, 400});
+
+    std::vector<EmuFrame> frames;
+    if (!loadFrames(opt, frames)) return 1;
+    // Start with the people in view
+    std::rotate(frames.begin(), frames.begin() + frames.size() / 2, frames.end());
+
+    VirtualRadar emu(opt, frames);
+    if (!emu.open()) {
+        perror("pty");
+        return 1;
+    }
+    int fd = open(emu.slaveName().c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) {
+        perror(emu.slaveName().c_str());
+        return 1;
+    }
+
+    std::atomic<bool> stop(false);
+    std::thread radarThread([&] { emu.run(stop); });
+
+    // The library on the other end of the "cable"
+    HardwareSerial port;
+    RD03D radar;
+    radar.begin(port, -1, -1);   // Queues the multi-target command
+    radar.onFrame(checkOnFrame);
+
+    std::vector<uint8_t> received;
+    std::vector<uint32_t> perWindow(64, 0);  // Bytes per 100 ms
+    uint8_t tx[64];
+    uint8_t buf[512];
+    uint32_t start = millis();
+    uint32_t multiBeforeReboot = 0;
+    uint32_t resends = 0;
+    while (millis() - start < 5000) {
+        size_t n = port.hostTakeTx(tx, sizeof(tx));
+        if (n > 0 && write(fd, tx, n) != (ssize_t)n) perror("write");
+
+        ssize_t got = read(fd, buf, sizeof(buf));
+        if (got > 0) {
+            received.insert(received.end(), buf, buf + got);
+            size_t w = (millis() - start) / 100;
+            if (w < perWindow.size()) perWindow[w] += got;
+            port.hostInject(buf, got);
+        }
+        radar.update();
+
+        // Recovery policy under test: re-enable when a stream resumes
+        if (g_checkResumed) {
+            g_checkResumed = false;
+            radar.enableMultiTarget();
+            resends++;
+        }
+        if (millis() - start < 2000) multiBeforeReboot = g_checkMultiFrames;
+        usleep(200);
+    }
+    stop = true;
+    radarThread.join();
+    close(fd);
+
+    static const uint8_t multiAck[14] = {0xFD, 0xFC, 0xFB, 0xFA, 0x04, 0x00, 0x90, 0x01,
+                                         0x00, 0x00, 0x04, 0x03, 0x02, 0x01};
+    uint32_t peak = *std::max_element(perWindow.begin(), perWindow.end()) * 10;
+    double line = 1.0 / EMU_BYTE_SECONDS;
+
+    bool ackSeen = findBytes(received, multiAck, sizeof(multiAck));
+    bool multiBefore = multiBeforeReboot > 0;
+    bool recovered = emu.recoveryCount() == 1 && emu.isMulti() && g_checkMultiFrames > multiBeforeReboot;
+    bool paced = peak <= line * 1.05 && peak >= line * 0.8;
+    bool errors = radar.getErrorCount() > 0;   // Garbage and cut frames must be noticed
+
+    printf("frames decoded %u (%u with 2+ targets), parse errors %u, re-enables %u\n",
+           g_checkFrames, g_checkMultiFrames, (unsigned)radar.getErrorCount(), resends);
+    printf("multi-target ACK after begin(): %s\n", ackSeen ? "yes" : "NO");
+    printf("multi-target frames before reboot: %s\n", multiBefore ? "yes" : "NO");
+    printf("multi-target restored after reboot: %s\n", recovered ? "yes" : "NO");
+    printf("peak byte rate %u B/s (line %.0f B/s): %s\n", peak, line, paced ? "paced" : "NOT paced");
+    printf("faults detected by the parser: %s\n", errors ? "yes" : "NO");
+
+    bool ok = ackSeen && multiBefore && recovered && paced && errors && g_checkFrames > 50;
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// ============== MAIN ==============
+static std::atomic<bool> g_stop(false);
+
+static void onSignal(int) { g_stop = true; }
+
+int main(int argc, char** argv) {
+    EmuOptions opt;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool more = i + 1 < argc;
+        if (a == "--check") {
+            return runCheck();
+        } else if (a == "-L" && more) {
+            opt.link = argv[++i];
+        } else if (a == "-r" && more) {
+            opt.rateHz = atof(argv[++i]);
+        } else if (a == "-s" && more) {
+            opt.scene = argv[++i];
+        } else if (a == "-d" && more) {
+            opt.seconds = atof(argv[++i]);
+        } else if (a == "--multi") {
+            opt.startMulti = true;
+        } else if (a == "--strict") {
+            opt.strict = true;
+        } else if (a == "--boot" && more) {
+            opt.bootMs = (uint32_t)atoi(argv[++i]);
+        } else if (a == "--fault" && more) {
+            EmuFault f;
+            if (!parseFault(argv[++i], f)) {
+                fprintf(stderr, "Bad fault '%s' (t:silence:ms, t:reboot, t:garbage:bytes)\n", argv[i]);
+                return 2;
+            }
+            opt.faults.push_back(f);
+        } else if (a == "--fault-every" && more) {
+            opt.faultEvery = atof(argv[++i]);
+        } else if (a == "--seed" && more) {
+            opt.seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (a[0] != '-') {
+            opt.captures.push_back(a);
+        } else {
+            fprintf(stderr, "usage: emulator [-L link] [-r hz] [-s scene] [-d seconds] [--multi] [--strict]\n"
+                            "                [--boot ms] [--fault t:kind[:n]]... [--fault-every s] [--seed n]\n"
+                            "                [capture.bin ...]\n"
+                            "       emulator --check\n");
+            return 2;
+        }
+    }
+    if (!(opt.rateHz > 0.0)) opt.rateHz = 20.0;
+
+    std::vector<EmuFrame> frames;
+    if (!loadFrames(opt, frames)) return 1;
+
+    VirtualRadar emu(opt, frames);
+    if (!emu.open()) {
+        perror("pty");
+        return 1;
+    }
+    printf("%s\n", emu.slaveName().c_str());
+    fflush(stdout);
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    emu.run(g_stop);
+    return 0;
+}
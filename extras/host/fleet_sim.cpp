@@ -0,0 +1,278 @@
+/**
+ * @file fleet_sim.cpp
+ * @brief Fleet load simulator: thousands of virtual sensors sending OSC over UDP
+ *
+ * Each virtual sensor replays a decoded capture or simulator scene and
+ * sends its frames through RD03D_OSCEncoder, exactly as a node would,
+ * to a UDP receiver (loopback by default). Sensors start at random
+ * phases and each frame is jittered, so the receiver sees realistic,
+ * uncorrelated arrivals. Achieved send rates are reported every second.
+ *
+ * Sources are decoded once up front and shared by all sensors; the send
+ * loop only encodes and sends.
+ *
+ * Build: see extras/host/README.md
+ *
+ * Usage:
+ *   ./fleet_sim [options] [capture.bin ...]
+ *     -n <sensors>    Virtual sensors (default 1000)
+ *     -r <hz>         Frame rate per sensor (default 20)
+ *     -j <ms>         Frame jitter, uniform +/- (default 5)
+ *     -d <seconds>    Run time (default 10)
+ *     -t <threads>    Sender threads (default 1)
+ *     -h <host>       Destination address (default 127.0.0.1)
+ *     -p <port>       Destination port (default 8000)
+ *     -b              Send one OSC bundle per frame instead of one datagram per message
+ *   Without captures, the built-in simulator scenes are used.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_OSC.h"
+#include "RD03D_Replay.h"
+#include "RD03D_Sim.h"
+
+// ============== SETTINGS ==============
+struct FleetOptions {
+    int sensors = 1000;
+    double rateHz = 20.0;
+    double jitterMs = 5.0;
+    double seconds = 10.0;
+    int threads = 1;
+    std::string host = "127.0.0.1";
+    int port = 8000;
+    bool bundle = false;
+    std::vector<std::string> captures;
+};
+
+// ============== STATISTICS ==============
+struct FleetStats {
+    std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> datagrams{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> sendErrors{0};
+    std::atomic<uint64_t> late{0};        // Sent more than 1 ms after schedule
+    std::atomic<uint64_t> maxLagUs{0};
+};
+
+typedef std::chrono::steady_clock Clock;
+
+// ============== VIRTUAL SENSOR ==============
+struct VirtualSensor {
+    int id;
+    const std::vector<ReplayFrame>* source;
+    size_t cursor;
+    RD03D_OSCEncoder encoder;
+    Clock::time_point phase;   // Nominal time of frame 0
+    uint64_t frame;            // Frames sent so far
+};
+
+struct ScheduledSend {
+    Clock::time_point when;
+    int sensor;
+    bool operator>(const ScheduledSend& o) const { return when > o.when; }
+};
+
+static void noteLag(FleetStats& stats, uint64_t lagUs) {
+    if (lagUs > 1000) stats.late++;
+    uint64_t prev = stats.maxLagUs.load();
+    while (lagUs > prev && !stats.maxLagUs.compare_exchange_weak(prev, lagUs)) {
+    }
+}
+
+static void senderThread(int threadIdx, const FleetOptions& opt,
+                         const std::vector<std::vector<ReplayFrame>>& sources,
+                         FleetStats& stats, Clock::time_point endTime) {
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) {
+        perror("socket");
+        return;
+    }
+    sockaddr_in dest = {};
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(opt.port);
+    inet_pton(AF_INET, opt.host.c_str(), &dest.sin_addr);
+
+    std::mt19937 rng(1234 + threadIdx);
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+    double periodUs = 1e6 / opt.rateHz;
+
+    // Sensors are sharded round-robin across threads
+    std::vector<VirtualSensor> sensors;
+    for (int id = threadIdx; id < opt.sensors; id += opt.threads) {
+        VirtualSensor s;
+        s.id = id;
+        s.source = &sources[id % sources.size()];
+        s.cursor = (size_t)(uni(rng) * s.source->size());
+        char prefix[RD03D_OSC_MAX_PREFIX];
+        snprintf(prefix, sizeof(prefix), "/node/%d/radar", id);
+        s.encoder.setPrefix(prefix);
+        sensors.push_back(s);
+    }
+
+    // Random start phase within one period
+    std::priority_queue<ScheduledSend, std::vector<ScheduledSend>, std::greater<ScheduledSend>> queue;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < sensors.size(); i++) {
+        sensors[i].phase = start + std::chrono::microseconds((int64_t)(uni(rng) * periodUs));
+        sensors[i].frame = 0;
+        queue.push({sensors[i].phase, (int)i});
+    }
+
+    uint8_t packet[RD03D_OSC_MAX_BUNDLE];
+    while (!queue.empty()) {
+        ScheduledSend next = queue.top();
+        if (next.when >= endTime) break;
+        queue.pop();
+
+        // Sleep for long waits, spin for the last stretch
+        Clock::time_point now = Clock::now();
+        if (next.when - now > std::chrono::microseconds(200)) {
+            std::this_thread::sleep_until(next.when - std::chrono::microseconds(100));
+        }
+        while ((now = Clock::now()) < next.when) {
+        }
+        noteLag(stats, (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(now - next.when).count());
+
+        VirtualSensor& s = sensors[next.sensor];
+        const ReplayFrame& f = (*s.source)[s.cursor];
+        s.cursor = (s.cursor + 1) % s.source->size();
+
+        auto send = [&](size_t len) {
+            if (len == 0) return;
+            if (sendto(sock, packet, len, 0, (sockaddr*)&dest, sizeof(dest)) < 0) {
+                stats.sendErrors++;
+            } else {
+                stats.datagrams++;
+                stats.bytes += len;
+            }
+        };
+
+        if (opt.bundle) {
+            send(s.encoder.encodeBundle(f.targets, packet, sizeof(packet)));
+        } else {
+            for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+                if (f.targets[i].valid) send(s.encoder.encodeTarget(i, f.targets[i], packet, sizeof(packet)));
+            }
+            send(s.encoder.encodeCount(f.count, packet, sizeof(packet)));
+        }
+        stats.frames++;
+
+        // Jitter around the nominal schedule, so it never drifts; frames stay in order
+        s.frame++;
+        double jitterUs = (uni(rng) * 2.0 - 1.0) * opt.jitterMs * 1000.0;
+        Clock::time_point when = s.phase + std::chrono::microseconds((int64_t)(s.frame * periodUs + jitterUs));
+        if (when < next.when) when = next.when;
+        queue.push({when, next.sensor});
+    }
+
+    close(sock);
+}
+
+// ============== MAIN ==============
+static bool parseArgs(int argc, char** argv, FleetOptions& opt) {
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (a == "-n" && hasValue) opt.sensors = atoi(argv[++i]);
+        else if (a == "-r" && hasValue) opt.rateHz = atof(argv[++i]);
+        else if (a == "-j" && hasValue) opt.jitterMs = atof(argv[++i]);
+        else if (a == "-d" && hasValue) opt.seconds = atof(argv[++i]);
+        else if (a == "-t" && hasValue) opt.threads = atoi(argv[++i]);
+        else if (a == "-h" && hasValue) opt.host = argv[++i];
+        else if (a == "-p" && hasValue) opt.port = atoi(argv[++i]);
+        else if (a == "-b") opt.bundle = true;
+        else if (a[0] == '-') return false;
+        else opt.captures.push_back(a);
+    }
+    return opt.sensors > 0 && opt.rateHz > 0 && opt.threads > 0;
+}
+
+int main(int argc, char** argv) {
+    FleetOptions opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "usage: fleet_sim [-n sensors] [-r hz] [-j ms] [-d s] [-t threads] "
+                        "[-h host] [-p port] [-b] [capture.bin ...]\n");
+        return 1;
+    }
+
+    // Decode every source once
+    std::vector<std::vector<ReplayFrame>> sources;
+    for (const std::string& path : opt.captures) {
+        std::vector<uint8_t> bytes;
+        if (!replayLoadFile(path, bytes)) {
+            fprintf(stderr, "Cannot read %s\n", path.c_str());
+            return 1;
+        }
+        sources.push_back(replayDecode(bytes));
+        printf("Capture %s: %zu frames\n", path.c_str(), sources.back().size());
+    }
+    if (sources.empty()) {
+        SimRadarModel model;
+        uint32_t seed = 1;
+        for (const SimScene& scene : rd03dSimScenes()) {
+            RD03D_Sim sim(scene, model, seed++);
+            sources.push_back(replayDecode(replaySimBytes(sim.run(opt.rateHz))));
+        }
+        printf("Using %zu simulator scenes\n", sources.size());
+    }
+    for (size_t i = 0; i < sources.size(); i++) {
+        if (sources[i].empty()) {
+            fprintf(stderr, "Source %zu decoded no frames\n", i);
+            return 1;
+        }
+    }
+
+    printf("%d sensors x %.1f Hz (+/-%.1f ms) -> %s:%d, %d thread(s), %s\n",
+           opt.sensors, opt.rateHz, opt.jitterMs, opt.host.c_str(), opt.port,
+           opt.threads, opt.bundle ? "bundles" : "messages");
+
+    FleetStats stats;
+    Clock::time_point endTime = Clock::now() + std::chrono::microseconds((int64_t)(opt.seconds * 1e6));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < opt.threads; t++) {
+        threads.emplace_back(senderThread, t, std::cref(opt), std::cref(sources), std::ref(stats), endTime);
+    }
+
+    // Report once per second
+    uint64_t lastFrames = 0, lastDatagrams = 0, lastBytes = 0;
+    double target = opt.sensors * opt.rateHz;
+    Clock::time_point start = Clock::now();
+    while (Clock::now() < endTime) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        uint64_t f = stats.frames, d = stats.datagrams, b = stats.bytes;
+        printf("[%5.1fs] frames/s %8llu (%5.1f%% of %.0f)  datagrams/s %8llu  MB/s %6.2f  late %llu  maxLag %llu us\n",
+               std::chrono::duration<double>(Clock::now() - start).count(),
+               (unsigned long long)(f - lastFrames), 100.0 * (f - lastFrames) / target, target,
+               (unsigned long long)(d - lastDatagrams), (b - lastBytes) / 1e6,
+               (unsigned long long)stats.late.load(), (unsigned long long)stats.maxLagUs.load());
+        fflush(stdout);
+        lastFrames = f;
+        lastDatagrams = d;
+        lastBytes = b;
+    }
+    for (std::thread& t : threads) t.join();
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    printf("\nTotal: %llu frames, %llu datagrams, %.2f MB, %llu send errors\n",
+           (unsigned long long)stats.frames.load(), (unsigned long long)stats.datagrams.load(),
+           stats.bytes / 1e6, (unsigned long long)stats.sendErrors.load());
+    printf("Average: %.0f frames/s (target %.0f), %.0f datagrams/s\n",
+           stats.frames / elapsed, target, stats.datagrams / elapsed);
+    return 0;
+}
@@ -0,0 +1,937 @@
+/**
+ * @file heatmap.cpp
+ * @brief Render occupancy heatmaps and trajectory trails as RGBA images
+ *
+ * Decodes raw or CSV captures (MultiTargetCallback format), bins every
+ * detection into an occupancy grid, rasterises the tracker's trajectories
+ * into a trail grid and colour maps both into PNG images, one pair per
+ * capture (`<name>_heat.png`, `<name>_trails.png`).
+ *
+ * Coordinates follow extras/processing/RadarVisualization.pde: the
+ * sensor sits at the top centre looking down (--unflipped puts it at the
+ * bottom looking up), the 8 m range spans 0.42 of the image width, and
+ * detections beyond the range or outside the ±60° beam are dropped.
+ * --grid draws the visualiser's background, range rings and beam edges
+ * under the data; without it pixels without data are transparent, for
+ * overlaying on a floor plan.
+ *
+ * Point binning, trail rasterisation, the vertical blur pass and the
+ * colour map work on four values at a time with SSE2 when the compiler
+ * targets it (any x86-64 build); --scalar selects the plain C++ path,
+ * which produces the same images bit for bit. Trails are traced in
+ * fixed-size chunks spread over -j threads (default: all cores).
+ *
+ * --sim renders a day of simulated frames (the built-in scenes back to
+ * back, people in view all day unless --busy gives a fraction) and
+ * reports the time of every stage. --check tests the mapping
+ * against the visualiser's formulas and compares the SSE2 and scalar
+ * paths.
+ *
+ * Build: see extras/host/README.md
+ *
+ * Usage:
+ *   ./heatmap [-s 1400x700] [-r range_mm] [-b blur_px] [-j threads] [--unflipped] [--grid] [--scalar] [-o dir] capture.bin|capture.csv ...
+ *   ./heatmap --sim [hours] [--busy fraction] [-o dir] [options]
+ *   ./heatmap --check
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define HEATMAP_SSE2 1
+#endif
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_Config.h"
+#include "RD03D_Replay.h"
+#include "RD03D_Tracker.h"
+
+#define HEATMAP_FRAME_MS   50      // Frame interval assumed for raw captures
+#define HEATMAP_TRAIL_GAP  1000    // ms without frames that breaks a trail
+#define HEATMAP_BEAM_DEG   60.0f   // Beam half-angle, as in the visualiser
+#define HEATMAP_CHUNK_FRAMES  36000  // Frames per trail chunk; fixed, so output does not depend on -j
+#define HEATMAP_WARMUP_FRAMES 40     // Frames tracked before a chunk without drawing
+
+static bool g_simd = true;         // false = scalar path (--scalar)
+
+// ============== VIEW ==============
+/**
+ * @brief Mapping from radar mm to image pixels, as RadarVisualization.pde draws it
+ */
+struct View {
+    int w, h;
+    float ox, oy;      // Sensor position in pixels
+    float sx, sy;      // Pixels per mm; the signs carry the flip
+    float range2;      // Detection gate: range squared (mm²)
+    float tan2;        // Detection gate: tan² of the beam half-angle
+};
+
+static View makeView(int w, int h, bool flipped, float rangeMm) {
+    View v;
+    v.w = w;
+    v.h = h;
+    float scale = w * 0.42f / rangeMm;   // radarRadius = width * 0.42
+    v.ox = w / 2.0f;
+    v.oy = flipped ? h * 0.08f : h * 0.92f;
+    v.sx = flipped ? -scale : scale;     // Sensor at top: negate X to correct mirroring
+    v.sy = flipped ? scale : -scale;
+    v.range2 = rangeMm * rangeMm;
+    float t = tanf(HEATMAP_BEAM_DEG * (float)M_PI / 180.0f);
+    v.tan2 = t * t;
+    return v;
+}
+
+static bool inBeam(const View& v, float x, float y) {
+    return y > 0.0f && x * x <= v.tan2 * (y * y) && x * x + y * y <= v.range2;
+}
+
+// ============== KERNELS ==============
+// Each kernel has a scalar version and an SSE2 version doing the same
+// float operations in the same order, so both give identical results.
+
+static void binPointsScalar(const float* xs, const float* ys, size_t n, const View& v, uint32_t* grid) {
+    for (size_t i = 0; i < n; i++) {
+        float x = xs[i], y = ys[i];
+        if (!inBeam(v, x, y)) continue;
+        float px = v.ox + v.sx * x;
+        float py = v.oy + v.sy * y;
+        if (!(px >= 0.0f && px < (float)v.w && py >= 0.0f && py < (float)v.h)) continue;
+        grid[(int)py * v.w + (int)px]++;
+    }
+}
+
+static void rasterSegmentScalar(float x0, float y0, float x1, float y1, const View& v, uint32_t* grid) {
+    // One sample per pixel step, end point excluded so joined segments count it once
+    float dx = x1 - x0, dy = y1 - y0;
+    int steps = (int)ceilf(fmaxf(fabsf(dx), fabsf(dy)));
+    if (steps < 1) steps = 1;
+    float inv = 1.0f / steps;
+    for (int i = 0; i < steps; i++) {
+        float t = (float)i * inv;
+        float px = x0 + dx * t;
+        float py = y0 + dy * t;
+        if (!(px >= 0.0f && px < (float)v.w && py >= 0.0f && py < (float)v.h)) continue;
+        grid[(int)py * v.w + (int)px]++;
+    }
+}
+
+static void addRowsScalar(uint32_t* acc, const uint32_t* add, const uint32_t* sub, int w) {
+    for (int x = 0; x < w; x++) {
+        if (add) acc[x] += add[x];
+        if (sub) acc[x] -= sub[x];
+    }
+}
+
+static uint32_t gridMaxScalar(const uint32_t* grid, size_t n) {
+    uint32_t m = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (grid[i] > m) m = grid[i];
+    }
+    return m;
+}
+
+static void colormapScalar(const uint32_t* grid, size_t n, float scale, const uint32_t* lut, uint32_t* rgba) {
+    for (size_t i = 0; i < n; i++) {
+        // Square root stretches the low end, so rarely visited cells still show
+        float f = fminf(sqrtf((float)(int32_t)grid[i] * scale) * 255.0f, 255.0f);
+        int idx = (int)f;
+        if (grid[i] != 0 && idx < 1) idx = 1;   // Entry 0 is reserved for empty cells
+        rgba[i] = lut[idx];
+    }
+}
+
+#ifdef HEATMAP_SSE2
+static void binPointsSse2(const float* xs, const float* ys, size_t n, const View& v, uint32_t* grid) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 ox = _mm_set1_ps(v.ox), oy = _mm_set1_ps(v.oy);
+    const __m128 sx = _mm_set1_ps(v.sx), sy = _mm_set1_ps(v.sy);
+    const __m128 wf = _mm_set1_ps((float)v.w), hf = _mm_set1_ps((float)v.h);
+    const __m128 range2 = _mm_set1_ps(v.range2), tan2 = _mm_set1_ps(v.tan2);
+    alignas(16) int32_t ix[4], iy[4];
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+        __m128 x2 = _mm_mul_ps(x, x);
+        __m128 y2 = _mm_mul_ps(y, y);
+        __m128 ok = _mm_cmpgt_ps(y, zero);
+        ok = _mm_and_ps(ok, _mm_cmple_ps(x2, _mm_mul_ps(tan2, y2)));
+        ok = _mm_and_ps(ok, _mm_cmple_ps(_mm_add_ps(x2, y2), range2));
+        __m128 px = _mm_add_ps(ox, _mm_mul_ps(sx, x));
+        __m128 py = _mm_add_ps(oy, _mm_mul_ps(sy, y));
+        ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmpge_ps(px, zero), _mm_cmplt_ps(px, wf)));
+        ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmpge_ps(py, zero), _mm_cmplt_ps(py, hf)));
+        int mask = _mm_movemask_ps(ok);
+        if (!mask) continue;
+        _mm_store_si128((__m128i*)ix, _mm_cvttps_epi32(px));
+        _mm_store_si128((__m128i*)iy, _mm_cvttps_epi32(py));
+        for (int k = 0; k < 4; k++) {
+            if (mask & (1 << k)) grid[iy[k] * v.w + ix[k]]++;
+        }
+    }
+    binPointsScalar(xs + i, ys + i, n - i, v, grid);
+}
+
+static void rasterSegmentSse2(float x0, float y0, float x1, float y1, const View& v, uint32_t* grid) {
+    float dx = x1 - x0, dy = y1 - y0;
+    int steps = (int)ceilf(fmaxf(fabsf(dx), fabsf(dy)));
+    if (steps < 1) steps = 1;
+    float inv = 1.0f / steps;
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 wf = _mm_set1_ps((float)v.w), hf = _mm_set1_ps((float)v.h);
+    const __m128 vx0 = _mm_set1_ps(x0), vy0 = _mm_set1_ps(y0);
+    const __m128 vdx = _mm_set1_ps(dx), vdy = _mm_set1_ps(dy);
+    const __m128 vinv = _mm_set1_ps(inv);
+    __m128i step = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i four = _mm_set1_epi32(4);
+    alignas(16) int32_t ix[4], iy[4];
+
+    int i = 0;
+    for (; i + 4 <= steps; i += 4) {
+        __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(step), vinv);
+        step = _mm_add_epi32(step, four);
+        __m128 px = _mm_add_ps(vx0, _mm_mul_ps(vdx, t));
+        __m128 py = _mm_add_ps(vy0, _mm_mul_ps(vdy, t));
+        __m128 ok = _mm_and_ps(_mm_cmpge_ps(px, zero), _mm_cmplt_ps(px, wf));
+        ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmpge_ps(py, zero), _mm_cmplt_ps(py, hf)));
+        int mask = _mm_movemask_ps(ok);
+        if (!mask) continue;
+        _mm_store_si128((__m128i*)ix, _mm_cvttps_epi32(px));
+        _mm_store_si128((__m128i*)iy, _mm_cvttps_epi32(py));
+        for (int k = 0; k < 4; k++) {
+            if (mask & (1 << k)) grid[iy[k] * v.w + ix[k]]++;
+        }
+    }
+    for (; i < steps; i++) {
+        float t = (float)i * inv;
+        float px = x0 + dx * t;
+        float py = y0 + dy * t;
+        if (!(px >= 0.0f && px < (float)v.w && py >= 0.0f && py < (float)v.h)) continue;
+        grid[(int)py * v.w + (int)px]++;
+    }
+}
+
+static void addRowsSse2(uint32_t* acc, const uint32_t* add, const uint32_t* sub, int w) {
+    int x = 0;
+    for (; x + 4 <= w; x += 4) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(acc + x));
+        if (add) a = _mm_add_epi32(a, _mm_loadu_si128((const __m128i*)(add + x)));
+        if (sub) a = _mm_sub_epi32(a, _mm_loadu_si128((const __m128i*)(sub + x)));
+        _mm_storeu_si128((__m128i*)(acc + x), a);
+    }
+    addRowsScalar(acc + x, add ? add + x : nullptr, sub ? sub + x : nullptr, w - x);
+}
+
+static uint32_t gridMaxSse2(const uint32_t* grid, size_t n) {
+    // Counts stay below 2^31, so the signed compare is enough
+    __m128i m = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i g = _mm_loadu_si128((const __m128i*)(grid + i));
+        __m128i gt = _mm_cmpgt_epi32(g, m);
+        m = _mm_or_si128(_mm_and_si128(gt, g), _mm_andnot_si128(gt, m));
+    }
+    alignas(16) uint32_t lanes[4];
+    _mm_store_si128((__m128i*)lanes, m);
+    uint32_t best = gridMaxScalar(grid + i, n - i);
+    for (int k = 0; k < 4; k++) {
+        if (lanes[k] > best) best = lanes[k];
+    }
+    return best;
+}
+
+static void colormapSse2(const uint32_t* grid, size_t n, float scale, const uint32_t* lut, uint32_t* rgba) {
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 v255 = _mm_set1_ps(255.0f);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+    alignas(16) int32_t idx[4];
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i g = _mm_loadu_si128((const __m128i*)(grid + i));
+        __m128 f = _mm_mul_ps(_mm_sqrt_ps(_mm_mul_ps(_mm_cvtepi32_ps(g), vscale)), v255);
+        __m128i k = _mm_cvttps_epi32(_mm_min_ps(f, v255));
+        // Indices fit in 16 bits, so a 16-bit max raises non-empty cells to 1
+        __m128i nonzero = _mm_andnot_si128(_mm_cmpeq_epi32(g, zero), one);
+        _mm_store_si128((__m128i*)idx, _mm_max_epi16(k, nonzero));
+        rgba[i] = lut[idx[0]];
+        rgba[i + 1] = lut[idx[1]];
+        rgba[i + 2] = lut[idx[2]];
+        rgba[i + 3] = lut[idx[3]];
+    }
+    colormapScalar(grid + i, n - i, scale, lut, rgba + i);
+}
+#endif
+
+static void binPoints(const float* xs, const float* ys, size_t n, const View& v, uint32_t* grid) {
+#ifdef HEATMAP_SSE2
+    if (g_simd) return binPointsSse2(xs, ys, n, v, grid);
+#endif
+    binPointsScalar(xs, ys, n, v, grid);
+}
+
+static void rasterSegment(float x0, float y0, float x1, float y1, const View& v, uint32_t* grid) {
+#ifdef HEATMAP_SSE2
+    if (g_simd) return rasterSegmentSse2(x0, y0, x1, y1, v, grid);
+#endif
+    rasterSegmentScalar(x0, y0, x1, y1, v, grid);
+}
+
+static void addRows(uint32_t* acc, const uint32_t* add, const uint32_t* sub, int w) {
+#ifdef HEATMAP_SSE2
+    if (g_simd) return addRowsSse2(acc, add, sub, w);
+#endif
+    addRowsScalar(acc, add, sub, w);
+}
+
+static uint32_t gridMax(const uint32_t* grid, size_t n) {
+#ifdef HEATMAP_SSE2
+    if (g_simd) return gridMaxSse2(grid, n);
+#endif
+    return gridMaxScalar(grid, n);
+}
+
+static void colormap(const uint32_t* grid, size_t n, uint32_t maxCount, const uint32_t* lut, uint32_t* rgba) {
+    float scale = maxCount ? 1.0f / maxCount : 0.0f;
+#ifdef HEATMAP_SSE2
+    if (g_simd) return colormapSse2(grid, n, scale, lut, rgba);
+#endif
+    colormapScalar(grid, n, scale, lut, rgba);
+}
+
+/**
+ * @brief Box blur of radius r in place (sums, not averages: the colour map normalises)
+ */
+static void boxBlur(std::vector<uint32_t>& grid, int w, int h, int r) {
+    if (r <= 0) return;
+    std::vector<uint32_t> out(grid.size());
+    std::vector<uint32_t> acc(w, 0);
+
+    // Vertical: a running sum of whole rows, four columns per instruction
+    for (int y = 0; y < r && y < h; y++) addRows(acc.data(), &grid[(size_t)y * w], nullptr, w);
+    for (int y = 0; y < h; y++) {
+        const uint32_t* add = (y + r < h) ? &grid[(size_t)(y + r) * w] : nullptr;
+        const uint32_t* sub = (y - r - 1 >= 0) ? &grid[(size_t)(y - r - 1) * w] : nullptr;
+        addRows(acc.data(), add, sub, w);
+        memcpy(&out[(size_t)y * w], acc.data(), w * sizeof(uint32_t));
+    }
+
+    // Horizontal: a running sum along each row
+    for (int y = 0; y < h; y++) {
+        const uint32_t* in = &out[(size_t)y * w];
+        uint32_t* row = &grid[(size_t)y * w];
+        uint32_t sum = 0;
+        for (int x = 0; x < r && x < w; x++) sum += in[x];
+        for (int x = 0; x < w; x++) {
+            if (x + r < w) sum += in[x + r];
+            if (x - r - 1 >= 0) sum -= in[x - r - 1];
+            row[x] = sum;
+        }
+    }
+}
+
+// ============== COLOURS ==============
+static uint32_t rgba(int r, int g, int b, int a) {
+    return (uint32_t)r | ((uint32_t)g << 8) | ((uint32_t)b << 16) | ((uint32_t)a << 24);
+}
+
+struct ColorStop {
+    float at;
+    int r, g, b, a;
+};
+
+/**
+ * @brief 256-entry lookup table; entry 0 (empty) is transparent
+ */
+static void buildLut(const ColorStop* stops, int count, uint32_t* lut) {
+    lut[0] = 0;
+    for (int i = 1; i < 256; i++) {
+        float t = (i - 1) / 254.0f;
+        int k = 0;
+        while (k + 2 < count && t > stops[k + 1].at) k++;
+        const ColorStop& a = stops[k];
+        const ColorStop& b = stops[k + 1];
+        float u = (t - a.at) / (b.at - a.at);
+        if (u < 0.0f) u = 0.0f;
+        if (u > 1.0f) u = 1.0f;
+        lut[i] = rgba((int)lroundf(a.r + (b.r - a.r) * u), (int)lroundf(a.g + (b.g - a.g) * u),
+                      (int)lroundf(a.b + (b.b - a.b) * u), (int)lroundf(a.a + (b.a - a.a) * u));
+    }
+}
+
+// Dark purple through red and orange to pale yellow, fading in from transparent
+static const ColorStop HEAT_STOPS[] = {
+    {0.00f, 40, 11, 84, 96}, {0.35f, 187, 55, 84, 210}, {0.70f, 249, 142, 9, 245}, {1.00f, 252, 255, 164, 255}};
+
+// Teal to white, like the visualiser's target trails
+static const ColorStop TRAIL_STOPS[] = {
+    {0.00f, 0, 90, 110, 110}, {0.50f, 0, 200, 220, 230}, {1.00f, 230, 255, 255, 255}};
+
+/**
+ * @brief Visualiser background with range rings every metre and the beam edges
+ */
+static void drawGrid(const View& v, float rangeMm, std::vector<uint32_t>& out) {
+    const uint32_t background = rgba(10, 20, 30, 255);
+    const uint32_t line = rgba(60, 100, 80, 255);
+    float mmPerPixel = 1.0f / fabsf(v.sx);
+    float half = 0.5f * mmPerPixel;
+    float edgeSin = sinf(HEATMAP_BEAM_DEG * (float)M_PI / 180.0f);
+    float edgeCos = cosf(HEATMAP_BEAM_DEG * (float)M_PI / 180.0f);
+
+    out.assign((size_t)v.w * v.h, background);
+    for (int py = 0; py < v.h; py++) {
+        for (int px = 0; px < v.w; px++) {
+            float x = (px + 0.5f - v.ox) / v.sx;
+            float y = (py + 0.5f - v.oy) / v.sy;
+            float r = sqrtf(x * x + y * y);
+            if (y <= 0.0f || r > rangeMm + half) continue;
+            bool ring = fabsf(x) <= sqrtf(v.tan2) * y + half &&
+                        fabsf(r - 1000.0f * roundf(r / 1000.0f)) < half;
+            bool edge = fabsf(fabsf(x) * edgeCos - y * edgeSin) < half;
+            if (ring || edge) out[(size_t)py * v.w + px] = line;
+        }
+    }
+}
+
+/**
+ * @brief Draw image over an opaque background
+ */
+static void composite(std::vector<uint32_t>& image, const std::vector<uint32_t>& background) {
+    for (size_t i = 0; i < image.size(); i++) {
+        uint32_t s = image[i], d = background[i];
+        uint32_t a = s >> 24;
+        uint32_t out = 0xFF000000u;
+        for (int c = 0; c < 24; c += 8) {
+            uint32_t sc = (s >> c) & 0xFF, dc = (d >> c) & 0xFF;
+            out |= ((sc * a + dc * (255 - a) + 127) / 255) << c;
+        }
+        image[i] = out;
+    }
+}
+
+// ============== PNG ==============
+static void putBE32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back((uint8_t)(v >> 24));
+    out.push_back((uint8_t)(v >> 16));
+    out.push_back((uint8_t)(v >> 8));
+    out.push_back((uint8_t)v);
+}
+
+static void putChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t len) {
+    putBE32(out, (uint32_t)len);
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + len);
+    putBE32(out, RD03D_ConfigBlob::crc32(&out[start], len + 4));
+}
+
+/**
+ * @brief Write 8-bit RGBA pixels (R in the low byte) as a PNG with stored (uncompressed) deflate blocks
+ */
+static bool writePng(const std::string& path, const std::vector<uint32_t>& pixels, int w, int h) {
+    // Scanlines: filter byte 0, then RGBA
+    size_t stride = (size_t)w * 4 + 1;
+    std::vector<uint8_t> raw(stride * h);
+    for (int y = 0; y < h; y++) {
+        uint8_t* row = &raw[(size_t)y * stride];
+        row[0] = 0;
+        for (int x = 0; x < w; x++) {
+            uint32_t p = pixels[(size_t)y * w + x];
+            row[1 + x * 4] = (uint8_t)p;
+            row[2 + x * 4] = (uint8_t)(p >> 8);
+            row[3 + x * 4] = (uint8_t)(p >> 16);
+            row[4 + x * 4] = (uint8_t)(p >> 24);
+        }
+    }
+
+    // zlib stream of stored blocks
+    std::vector<uint8_t> z;
+    z.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    z.push_back(0x78);
+    z.push_back(0x01);
+    for (size_t pos = 0; pos < raw.size();) {
+        size_t n = raw.size() - pos;
+        if (n > 65535) n = 65535;
+        z.push_back(pos + n == raw.size() ? 1 : 0);
+        z.push_back((uint8_t)n);
+        z.push_back((uint8_t)(n >> 8));
+        z.push_back((uint8_t)~n);
+        z.push_back((uint8_t)(~n >> 8));
+        z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + n);
+        pos += n;
+    }
+    uint32_t a = 1, b = 0;
+    for (size_t pos = 0; pos < raw.size();) {
+        size_t end = pos + 5552 < raw.size() ? pos + 5552 : raw.size();   // Largest run without overflow
+        for (; pos < end; pos++) {
+            a += raw[pos];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    putBE32(z, (b << 16) | a);
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    uint8_t ihdr[13];
+    std::vector<uint8_t> hdr;
+    putBE32(hdr, (uint32_t)w);
+    putBE32(hdr, (uint32_t)h);
+    memcpy(ihdr, hdr.data(), 8);
+    ihdr[8] = 8;     // Bit depth
+    ihdr[9] = 6;     // RGBA
+    ihdr[10] = 0;
+    ihdr[11] = 0;
+    ihdr[12] = 0;
+    putChunk(png, "IHDR", ihdr, sizeof(ihdr));
+    putChunk(png, "IDAT", z.data(), z.size());
+    putChunk(png, "IEND", nullptr, 0);
+
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(png.data(), 1, png.size(), f) == png.size();
+    return fclose(f) == 0 && ok;
+}
+
+// ============== CAPTURES ==============
+struct Sequence {
+    std::string name;
+    std::vector<ReplayFrame> frames;
+    std::vector<uint32_t> ms;   // Frame times; empty = HEATMAP_FRAME_MS apart
+};
+
+static bool loadCsv(const char* path, Sequence& seq) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+
+        double v[2 + 5 * RD03D_MAX_TARGETS];
+        int n = 0;
+        char* save = nullptr;
+        for (char* tok = strtok_r(line, ",", &save); tok && n < (int)(sizeof(v) / sizeof(v[0]));
+             tok = strtok_r(nullptr, ",", &save)) {
+            v[n++] = atof(tok);
+        }
+        if (n < 2 + 5 * RD03D_MAX_TARGETS) continue;
+
+        ReplayFrame frame;
+        frame.count = 0;
+        for (int i = 0; i < RD03D_MAX_TARGETS; i++) {
+            RD03D_Target& t = frame.targets[i];
+            t.clear();
+            t.x = (int16_t)v[2 + i * 5];
+            t.y = (int16_t)v[3 + i * 5];
+            t.distance = (float)v[4 + i * 5];
+            t.angle = (float)v[5 + i * 5];
+            t.speed = (int16_t)v[6 + i * 5];
+            t.valid = (t.x != 0 || t.y != 0);
+            if (t.valid) frame.count++;
+        }
+        seq.frames.push_back(frame);
+        seq.ms.push_back((uint32_t)v[0]);
+    }
+    fclose(f);
+    return true;
+}
+
+static bool loadCapture(const std::string& path, Sequence& seq) {
+    size_t slash = path.find_last_of('/');
+    std::string base = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    size_t dot = base.find_last_of('.');
+    std::string ext = (dot == std::string::npos) ? "" : base.substr(dot);
+    seq.name = (dot == std::string::npos) ? base : base.substr(0, dot);
+
+    if (ext == ".csv") return loadCsv(path.c_str(), seq);
+    std::vector<uint8_t> bytes;
+    if (!replayLoadFile(path, bytes)) return false;
+    seq.frames = replayDecode(bytes);
+    return true;
+}
+
+/**
+ * @brief Simulated scenes until hours of frames are collected
+ * @param busy Fraction of the time with people in view; empty frames fill the rest
+ */
+static void simulateDay(double hours, double busy, Sequence& seq) {
+    seq.name = "sim";
+    size_t wanted = (size_t)(hours * 3600.0 * 1000.0 / HEATMAP_FRAME_MS);
+    std::vector<SimScene> scenes = rd03dSimScenes();
+    SimRadarModel model;
+    ReplayFrame empty;
+    for (int i = 0; i < RD03D_MAX_TARGETS; i++) empty.targets[i].clear();
+    empty.count = 0;
+
+    seq.frames.reserve(wanted);
+    for (uint32_t seed = 1; seq.frames.size() < wanted; seed++) {
+        const SimScene& scene = scenes[seed % scenes.size()];
+        std::vector<SimFrame> frames = RD03D_Sim(scene, model, seed).run(1000.0 / HEATMAP_FRAME_MS);
+        std::vector<ReplayFrame> decoded = replayDecode(replaySimBytes(frames));
+        size_t n = decoded.size();
+        if (n > wanted - seq.frames.size()) n = wanted - seq.frames.size();
+        seq.frames.insert(seq.frames.end(), decoded.begin(), decoded.begin() + n);
+
+        size_t idle = (size_t)(decoded.size() * (1.0 - busy) / busy);
+        if (idle > wanted - seq.frames.size()) idle = wanted - seq.frames.size();
+        seq.frames.insert(seq.frames.end(), idle, empty);
+    }
+}
+
+// ============== RENDERER ==============
+struct Options {
+    int w = 1400;
+    int h = 700;
+    float rangeMm = 8000.0f;
+    int blur = 3;
+    bool flipped = true;
+    bool grid = false;
+    int threads = (int)std::thread::hardware_concurrency();
+};
+
+struct Rendered {
+    std::vector<uint32_t> heatCounts, trailCounts;
+    std::vector<uint32_t> heat, trails;     // RGBA
+    size_t points = 0, segments = 0;
+    double pointsMs = 0, binMs = 0, trailMs = 0, blurMs = 0, colourMs = 0;
+};
+
+static double msSince(std::chrono::steady_clock::time_point& t0) {
+    auto t1 = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    t0 = t1;
+    return ms;
+}
+
+/**
+ * @brief Rasterise the tracks of frames [begin, end) into grid
+ *
+ * The tracker first runs over the frames before begin without drawing,
+ * so tracks already exist at the start and chunks join without a gap.
+ * @return Number of segments drawn
+ */
+static size_t traceTrails(const Sequence& seq, const View& v, float rangeMm, size_t begin, size_t end, uint32_t* grid) {
+    RD03D_Tracker tracker;
+    RD03D_TrackerConfig config = tracker.getConfig();
+    config.maxRangeCm = rangeMm / 10.0f;
+    config.maxAngleDeg = HEATMAP_BEAM_DEG;
+    tracker.setConfig(config);
+
+    uint16_t lastId[RD03D_MAX_TRACKS] = {0};
+    float last[RD03D_MAX_TRACKS][2] = {};
+    uint32_t lastMs = 0;
+    bool tracking = false;
+    size_t drawn = 0;
+    size_t start = begin > HEATMAP_WARMUP_FRAMES ? begin - HEATMAP_WARMUP_FRAMES : 0;
+    for (size_t k = start; k < end; k++) {
+        const ReplayFrame& f = seq.frames[k];
+        uint32_t ms = seq.ms.empty() ? (uint32_t)(k * HEATMAP_FRAME_MS) : seq.ms[k];
+        if (k > start && ms - lastMs > HEATMAP_TRAIL_GAP) {
+            tracker.reset();
+            memset(lastId, 0, sizeof(lastId));
+            tracking = false;
+        }
+        lastMs = ms;
+
+        // Most of a day is empty: with no tracks and no detections update() would change nothing
+        bool detections = false;
+        for (int j = 0; j < RD03D_MAX_TARGETS; j++) detections |= f.targets[j].valid;
+        if (!tracking && !detections) continue;
+
+        tracker.update(f.targets, ms);
+        tracking = false;
+        for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+            const RD03D_Track* t = tracker.getTrack(i);
+            tracking |= t->active;
+            if (!t->isValid() || !inBeam(v, t->x, t->y)) {
+                lastId[i] = 0;
+                continue;
+            }
+            float px = v.ox + v.sx * t->x;
+            float py = v.oy + v.sy * t->y;
+            if (lastId[i] == t->id && k >= begin) {
+                rasterSegment(last[i][0], last[i][1], px, py, v, grid);
+                drawn++;
+            }
+            lastId[i] = t->id;
+            last[i][0] = px;
+            last[i][1] = py;
+        }
+    }
+    return drawn;
+}
+
+static void render(const Sequence& seq, const Options& o, Rendered& out) {
+    View v = makeView(o.w, o.h, o.flipped, o.rangeMm);
+    size_t pixels = (size_t)o.w * o.h;
+    auto t0 = std::chrono::steady_clock::now();
+
+    // Detections as flat coordinate arrays
+    std::vector<float> xs, ys;
+    xs.reserve(seq.frames.size() * 2);
+    ys.reserve(seq.frames.size() * 2);
+    for (const ReplayFrame& f : seq.frames) {
+        for (int i = 0; i < RD03D_MAX_TARGETS; i++) {
+            if (!f.targets[i].valid) continue;
+            xs.push_back(f.targets[i].x);
+            ys.push_back(f.targets[i].y);
+        }
+    }
+    out.points = xs.size();
+    out.pointsMs = msSince(t0);
+
+    out.heatCounts.assign(pixels, 0);
+    binPoints(xs.data(), ys.data(), xs.size(), v, out.heatCounts.data());
+    out.binMs = msSince(t0);
+
+    // Trails: chunks traced in parallel, each into its own grid, then summed
+    size_t chunks = (seq.frames.size() + HEATMAP_CHUNK_FRAMES - 1) / HEATMAP_CHUNK_FRAMES;
+    int workers = o.threads < 1 ? 1 : o.threads;
+    if ((size_t)workers > chunks) workers = chunks ? (int)chunks : 1;
+    std::vector<std::vector<uint32_t>> grids(workers);
+    std::vector<size_t> segments(workers, 0);
+    std::atomic<size_t> next(0);
+    auto worker = [&](int w) {
+        grids[w].assign(pixels, 0);
+        for (size_t c; (c = next++) < chunks;) {
+            size_t begin = c * HEATMAP_CHUNK_FRAMES;
+            size_t end = begin + HEATMAP_CHUNK_FRAMES < seq.frames.size() ? begin + HEATMAP_CHUNK_FRAMES : seq.frames.size();
+            segments[w] += traceTrails(seq, v, o.rangeMm, begin, end, grids[w].data());
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int w = 1; w < workers; w++) pool.emplace_back(worker, w);
+    worker(0);
+    for (std::thread& t : pool) t.join();
+    out.trailCounts.swap(grids[0]);
+    for (int w = 1; w < workers; w++) addRows(out.trailCounts.data(), grids[w].data(), nullptr, (int)pixels);
+    for (size_t n : segments) out.segments += n;
+    out.trailMs = msSince(t0);
+
+    boxBlur(out.heatCounts, o.w, o.h, o.blur);
+    out.blurMs = msSince(t0);
+
+    uint32_t heatLut[256], trailLut[256];
+    buildLut(HEAT_STOPS, sizeof(HEAT_STOPS) / sizeof(HEAT_STOPS[0]), heatLut);
+    buildLut(TRAIL_STOPS, sizeof(TRAIL_STOPS) / sizeof(TRAIL_STOPS[0]), trailLut);
+    out.heat.resize(pixels);
+    out.trails.resize(pixels);
+    colormap(out.heatCounts.data(), pixels, gridMax(out.heatCounts.data(), pixels), heatLut, out.heat.data());
+    colormap(out.trailCounts.data(), pixels, gridMax(out.trailCounts.data(), pixels), trailLut, out.trails.data());
+    out.colourMs = msSince(t0);
+}
+
+static bool renderAndWrite(const Sequence& seq, const Options& o, const std::string& dir, bool write) {
+    Rendered r;
+    render(seq, o, r);
+    double total = r.pointsMs + r.binMs + r.trailMs + r.blurMs + r.colourMs;
+    double hours = seq.frames.size() * (double)HEATMAP_FRAME_MS / 3600000.0;
+    if (!seq.ms.empty() && seq.ms.size() > 1) hours = (seq.ms.back() - seq.ms.front()) / 3600000.0;
+    printf("%s: %zu frames (%.1f h), %zu detections, %zu trail segments\n",
+           seq.name.c_str(), seq.frames.size(), hours, r.points, r.segments);
+    printf("  render %.1f ms (%s): points %.1f, bin %.1f, trails %.1f, blur %.1f, colour %.1f\n",
+           total, g_simd ? "SSE2" : "scalar", r.pointsMs, r.binMs, r.trailMs, r.blurMs, r.colourMs);
+    if (!write) return true;
+
+    auto t0 = std::chrono::steady_clock::now();
+    View v = makeView(o.w, o.h, o.flipped, o.rangeMm);
+    if (o.grid) {
+        std::vector<uint32_t> background;
+        drawGrid(v, o.rangeMm, background);
+        composite(r.heat, background);
+        composite(r.trails, background);
+    }
+    std::string prefix = (dir.empty() ? "" : dir + "/") + seq.name;
+    if (!writePng(prefix + "_heat.png", r.heat, o.w, o.h) ||
+        !writePng(prefix + "_trails.png", r.trails, o.w, o.h)) {
+        fprintf(stderr, "Cannot write %s_*.png\n", prefix.c_str());
+        return false;
+    }
+    printf("  wrote %s_heat.png, %s_trails.png (%.1f ms)\n", prefix.c_str(), prefix.c_str(), msSince(t0));
+    return true;
+}
+
+// ============== SELF CHECK ==============
+static bool near(float a, float b) {
+    return fabsf(a - b) < 1e-3f;
+}
+
+static int runCheck() {
+    bool ok = true;
+
+    // Mapping against the visualiser: map(-x, -R, R, -radius, radius) + width/2, etc.
+    const float R = 8000.0f, radius = 1400 * 0.42f;
+    View top = makeView(1400, 700, true, R);
+    View bottom = makeView(1400, 700, false, R);
+    const float pts[][2] = {{0, 4000}, {1000, 2000}, {-2500, 6000}, {3000, 500}};
+    bool mapOk = true;
+    for (const auto& p : pts) {
+        float tx = -p[0] / R * radius + 700.0f, ty = p[1] / R * radius + 700 * 0.08f;
+        float bx = p[0] / R * radius + 700.0f, by = -p[1] / R * radius + 700 * 0.92f;
+        mapOk &= near(top.ox + top.sx * p[0], tx) && near(top.oy + top.sy * p[1], ty);
+        mapOk &= near(bottom.ox + bottom.sx * p[0], bx) && near(bottom.oy + bottom.sy * p[1], by);
+    }
+    mapOk &= top.ox + top.sx * 1000.0f < 700.0f;   // Flipped: +x is drawn on the left
+    printf("mapping matches RadarVisualization.pde: %s\n", mapOk ? "yes" : "NO");
+    ok &= mapOk;
+
+    bool gateOk = inBeam(top, 0, 7900) && !inBeam(top, 0, 8100) && inBeam(top, 3400, 2000) &&
+                  !inBeam(top, 3600, 2000) && !inBeam(top, 0, -100) && !inBeam(top, 0, 0);
+    printf("range and beam gate: %s\n", gateOk ? "yes" : "NO");
+    ok &= gateOk;
+
+#ifdef HEATMAP_SSE2
+    // Random points, including off-image and outside the beam, and an odd count for the tails
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> ux(-9000.0f, 9000.0f), uy(-500.0f, 9000.0f);
+    std::vector<float> xs(100003), ys(100003);
+    for (size_t i = 0; i < xs.size(); i++) {
+        xs[i] = roundf(ux(rng));
+        ys[i] = roundf(uy(rng));
+    }
+    View small = makeView(640, 200, false, R);
+    std::vector<uint32_t> a(640 * 200, 0), b(640 * 200, 0);
+    binPointsScalar(xs.data(), ys.data(), xs.size(), small, a.data());
+    binPointsSse2(xs.data(), ys.data(), xs.size(), small, b.data());
+    for (size_t i = 0; i + 1 < xs.size(); i += 2) {
+        float x0 = small.ox + small.sx * xs[i], y0 = small.oy + small.sy * ys[i];
+        float x1 = small.ox + small.sx * xs[i + 1], y1 = small.oy + small.sy * ys[i + 1];
+        rasterSegmentScalar(x0, y0, x1, y1, small, a.data());
+        rasterSegmentSse2(x0, y0, x1, y1, small, b.data());
+    }
+    bool kernelsOk = a == b && gridMaxScalar(a.data(), a.size()) == gridMaxSse2(b.data(), b.size());
+    printf("SSE2 and scalar kernels agree on random input: %s\n", kernelsOk ? "yes" : "NO");
+    ok &= kernelsOk;
+
+    // Whole renders of an hour of simulated data, both orientations
+    Sequence seq;
+    simulateDay(1.0, 1.0, seq);
+    for (int flip = 0; flip < 2; flip++) {
+        Options o;
+        o.flipped = flip == 1;
+        Rendered simd, scalar;
+        g_simd = true;
+        render(seq, o, simd);
+        g_simd = false;
+        render(seq, o, scalar);
+        g_simd = true;
+        bool same = simd.heat == scalar.heat && simd.trails == scalar.trails &&
+                    simd.heatCounts == scalar.heatCounts && simd.trailCounts == scalar.trailCounts;
+        size_t painted = 0;
+        for (uint32_t p : simd.heat) painted += (p >> 24) != 0;
+        printf("%s render identical with SSE2 and scalar: %s (%zu heat pixels)\n",
+               o.flipped ? "flipped" : "unflipped", same ? "yes" : "NO", painted);
+        ok &= same && painted > 0;
+    }
+
+    // Trail chunks and their warm-up must not depend on the thread count
+    Options one, three;
+    one.threads = 1;
+    three.threads = 3;
+    Rendered r1, r3;
+    render(seq, one, r1);
+    render(seq, three, r3);
+    bool threadsOk = r1.trails == r3.trails && r1.segments == r3.segments;
+    printf("trails identical with 1 and 3 threads: %s (%zu segments)\n", threadsOk ? "yes" : "NO", r1.segments);
+    ok &= threadsOk;
+#else
+    printf("SSE2 not available in this build: scalar path only\n");
+#endif
+
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// ============== MAIN ==============
+static void usage() {
+    fprintf(stderr, "usage: heatmap [-s WxH] [-r range_mm] [-b blur_px] [-j threads] [--unflipped] [--grid] [--scalar] [-o dir] capture.bin|capture.csv ...\n"
+                    "       heatmap --sim [hours] [--busy fraction] [-o dir] [options]\n"
+                    "       heatmap --check\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "--check") == 0) return runCheck();
+
+    Options o;
+    std::string dir;
+    bool sim = false;
+    double simHours = 24.0;
+    double simBusy = 1.0;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "-s" && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &o.w, &o.h) != 2 || o.w < 16 || o.h < 16 || (size_t)o.w * o.h > (1u << 24)) {
+                fprintf(stderr, "Bad size %s\n", argv[i]);
+                return 2;
+            }
+        } else if (a == "-r" && hasValue) {
+            o.rangeMm = (float)atof(argv[++i]);
+        } else if (a == "-b" && hasValue) {
+            o.blur = atoi(argv[++i]);
+        } else if (a == "-j" && hasValue) {
+            o.threads = atoi(argv[++i]);
+        } else if (a == "-o" && hasValue) {
+            dir = argv[++i];
+        } else if (a == "--busy" && hasValue) {
+            simBusy = atof(argv[++i]);
+        } else if (a == "--unflipped") {
+            o.flipped = false;
+        } else if (a == "--grid") {
+            o.grid = true;
+        } else if (a == "--scalar") {
+            g_simd = false;
+        } else if (a == "--sim") {
+            sim = true;
+            if (hasValue && argv[i + 1][0] != '-') simHours = atof(argv[++i]);
+        } else if (a[0] == '-') {
+            usage();
+            return 2;
+        } else {
+            inputs.push_back(a);
+        }
+    }
+    if (o.rangeMm <= 0.0f || simBusy <= 0.0 || simBusy > 1.0 || (!sim && inputs.empty())) {
+        usage();
+        return 2;
+    }
+#ifndef HEATMAP_SSE2
+    g_simd = false;
+#endif
+
+    if (sim) {
+        auto t0 = std::chrono::steady_clock::now();
+        Sequence seq;
+        simulateDay(simHours, simBusy, seq);
+        printf("Simulated and decoded %.1f h (%.0f%% busy) in %.0f ms\n", simHours, simBusy * 100.0, msSince(t0));
+        return renderAndWrite(seq, o, dir, !dir.empty()) ? 0 : 1;
+    }
+
+    for (const std::string& path : inputs) {
+        auto t0 = std::chrono::steady_clock::now();
+        Sequence seq;
+        if (!loadCapture(path, seq)) {
+            fprintf(stderr, "Cannot read %s\n", path.c_str());
+            return 1;
+        }
+        printf("Loaded %s in %.0f ms\n", path.c_str(), msSince(t0));
+        if (!renderAndWrite(seq, o, dir, true)) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file mkconfig.cpp
+ * @brief Compile a text site configuration into an RD03D config blob
+ *
+ * All text parsing happens here, on the host. The device only validates
+ * the resulting blob and reads it in place (see src/RD03D_Config.h).
+ *
+ * Input format, one setting per line, '#' starts a comment:
+ *
+ *   version      7                  # site revision reported by getVersion()
+ *   timeout_ms   100
+ *   pose         1500 0 -30         # x_mm y_mm theta_deg
+ *   range_cm     600                # any tracker setting enables tracker config
+ *   angle_deg    55
+ *   gate_mm      500
+ *   coast        5
+ *   confirm      2
+ *   alpha        0.6
+ *   beta         0.2
+ *   zone         1  -1000 500 1000 2500     # id x0 y0 x1 y1 (mm)
+ *   tripwire     2  -1500 3000 1500 3000
+ *
+ * Build: see extras/host/README.md
+ *
+ * Usage:
+ *   ./mkconfig site.txt [-o site.bin] [-c site_config.h [-n arrayName]]
+ *   ./mkconfig --dump site.bin
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_Config.h"
+#include "RD03D_Replay.h"
+
+static int usage() {
+    fprintf(stderr, "usage: mkconfig site.txt [-o site.bin] [-c site_config.h [-n arrayName]]\n"
+                    "       mkconfig --dump site.bin\n");
+    return 1;
+}
+
+static const char* errorName(RD03D_ConfigError e) {
+    switch (e) {
+        case RD03D_CONFIG_OK: return "ok";
+        case RD03D_CONFIG_ERR_ALIGN: return "misaligned";
+        case RD03D_CONFIG_ERR_SIZE: return "bad size";
+        case RD03D_CONFIG_ERR_MAGIC: return "bad magic";
+        case RD03D_CONFIG_ERR_FORMAT: return "unsupported format";
+        case RD03D_CONFIG_ERR_LAYOUT: return "bad layout";
+        case RD03D_CONFIG_ERR_CRC: return "CRC mismatch";
+        case RD03D_CONFIG_ERR_BUSY: return "update pending";
+    }
+    return "?";
+}
+
+// ============== TEXT INPUT ==============
+static bool parseText(const char* path, RD03D_ConfigSettings& s,
+                      std::vector<RD03D_ConfigRegion>& regions, uint32_t& version) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "Cannot read %s\n", path);
+        return false;
+    }
+
+    RD03D_TrackerConfig tc;
+    tc.setDefaults();
+    memset(&s, 0, sizeof(s));
+    s.maxRangeCm = tc.maxRangeCm;
+    s.maxAngleDeg = tc.maxAngleDeg;
+    s.gateMm = tc.gateMm;
+    s.coastFrames = tc.coastFrames;
+    s.confirmFrames = tc.confirmFrames;
+    s.alpha = tc.alpha;
+    s.beta = tc.beta;
+
+    char line[256];
+    int lineNo = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f)) {
+        lineNo++;
+        char* hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+
+        char key[32];
+        double v[5];
+        int n = sscanf(line, "%31s %lf %lf %lf %lf %lf", key, &v[0], &v[1], &v[2], &v[3], &v[4]);
+        if (n <= 0) continue;
+        int args = n - 1;
+        std::string k = key;
+
+        if (k == "version" && args == 1) version = (uint32_t)v[0];
+        else if (k == "timeout_ms" && args == 1) s.timeoutMs = (uint16_t)v[0];
+        else if (k == "pose" && args == 3) {
+            s.poseX = (float)v[0];
+            s.poseY = (float)v[1];
+            s.poseTheta = (float)v[2];
+            s.flags |= RD03D_CONFIG_FLAG_POSE;
+        } else if ((k == "zone" || k == "tripwire") && args == 5) {
+            RD03D_ConfigRegion r;
+            memset(&r, 0, sizeof(r));
+            r.type = (k == "zone") ? RD03D_REGION_ZONE : RD03D_REGION_TRIPWIRE;
+            r.id = (uint8_t)v[0];
+            r.x0 = (int16_t)v[1];
+            r.y0 = (int16_t)v[2];
+            r.x1 = (int16_t)v[3];
+            r.y1 = (int16_t)v[4];
+            regions.push_back(r);
+        } else if (args == 1) {
+            if (k == "range_cm") s.maxRangeCm = (float)v[0];
+            else if (k == "angle_deg") s.maxAngleDeg = (float)v[0];
+            else if (k == "gate_mm") s.gateMm = (float)v[0];
+            else if (k == "coast") s.coastFrames = (uint8_t)v[0];
+            else if (k == "confirm") s.confirmFrames = (uint8_t)v[0];
+            else if (k == "alpha") s.alpha = (float)v[0];
+            else if (k == "beta") s.beta = (float)v[0];
+            else ok = false;
+            if (ok) s.flags |= RD03D_CONFIG_FLAG_TRACKER;
+        } else {
+            ok = false;
+        }
+        if (!ok) fprintf(stderr, "%s:%d: cannot parse '%s' with %d values\n", path, lineNo, key, args);
+    }
+    fclose(f);
+    return ok;
+}
+
+// ============== OUTPUT ==============
+static bool writeHeader(const char* path, const char* name, const uint8_t* blob, size_t size, uint32_t version) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "// Generated by extras/host/mkconfig - site revision %u, %zu bytes\n", version, size);
+    fprintf(f, "#pragma once\n\n#include <stdint.h>\n\n");
+    fprintf(f, "alignas(4) static const uint8_t %s[%zu] = {", name, size);
+    for (size_t i = 0; i < size; i++) {
+        fprintf(f, "%s0x%02X%s", (i % 12 == 0) ? "\n    " : "", blob[i], (i + 1 < size) ? ", " : "");
+    }
+    fprintf(f, "\n};\n");
+    fclose(f);
+    return true;
+}
+
+static void dump(const RD03D_ConfigBlob& config, size_t size) {
+    const RD03D_ConfigSettings* s = config.getSettings();
+    printf("Config revision %u, %zu bytes\n", config.getVersion(), size);
+    printf("  timeout_ms  %u%s\n", s->timeoutMs, s->timeoutMs ? "" : " (unchanged)");
+    RD03D_Pose pose;
+    if (config.getPose(pose)) printf("  pose        %.1f %.1f %.2f\n", pose.x, pose.y, pose.theta);
+    RD03D_TrackerConfig tc;
+    if (config.getTrackerConfig(tc)) {
+        printf("  tracker     range %.0f cm, angle %.0f deg, gate %.0f mm, coast %u, confirm %u, alpha %.2f, beta %.2f\n",
+               tc.maxRangeCm, tc.maxAngleDeg, tc.gateMm, tc.coastFrames, tc.confirmFrames, tc.alpha, tc.beta);
+    }
+    for (uint16_t i = 0; i < config.getRegionCount(); i++) {
+        const RD03D_ConfigRegion* r = config.getRegion(i);
+        printf("  %-11s %u  %d %d %d %d\n", r->type == RD03D_REGION_ZONE ? "zone" : "tripwire",
+               r->id, r->x0, r->y0, r->x1, r->y1);
+    }
+}
+
+// ============== MAIN ==============
+int main(int argc, char** argv) {
+    if (argc == 3 && strcmp(argv[1], "--dump") == 0) {
+        std::vector<uint8_t> bytes;
+        if (!replayLoadFile(argv[2], bytes)) {
+            fprintf(stderr, "Cannot read %s\n", argv[2]);
+            return 1;
+        }
+        RD03D_ConfigBlob config;
+        RD03D_ConfigError e = config.load(bytes.data(), bytes.size());
+        if (e != RD03D_CONFIG_OK) {
+            fprintf(stderr, "Invalid blob: %s\n", errorName(e));
+            return 1;
+        }
+        dump(config, bytes.size());
+        return 0;
+    }
+
+    const char* input = nullptr;
+    const char* binPath = nullptr;
+    const char* headerPath = nullptr;
+    const char* arrayName = "siteConfig";
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = (i + 1 < argc);
+        if (strcmp(argv[i], "-o") == 0 && hasValue) binPath = argv[++i];
+        else if (strcmp(argv[i], "-c") == 0 && hasValue) headerPath = argv[++i];
+        else if (strcmp(argv[i], "-n") == 0 && hasValue) arrayName = argv[++i];
+        else if (argv[i][0] != '-' && !input) input = argv[i];
+        else return usage();
+    }
+    if (!input) return usage();
+
+    RD03D_ConfigSettings settings;
+    std::vector<RD03D_ConfigRegion> regions;
+    uint32_t version = 1;
+    if (!parseText(input, settings, regions, version)) return 1;
+
+    std::vector<uint8_t> blob(sizeof(RD03D_ConfigHeader) + sizeof(RD03D_ConfigSettings) +
+                              regions.size() * sizeof(RD03D_ConfigRegion));
+    size_t size = RD03D_ConfigBlob::build(settings, regions.data(), (uint16_t)regions.size(),
+                                          version, blob.data(), blob.size());
+    if (size == 0) {
+        fprintf(stderr, "Too many regions\n");
+        return 1;
+    }
+
+    // Round-trip through the device-side loader before writing anything
+    RD03D_ConfigBlob config;
+    RD03D_ConfigError e = config.load(blob.data(), size);
+    if (e != RD03D_CONFIG_OK) {
+        fprintf(stderr, "Generated blob failed validation: %s\n", errorName(e));
+        return 1;
+    }
+    dump(config, size);
+
+    if (binPath) {
+        FILE* f = fopen(binPath, "wb");
+        if (!f || fwrite(blob.data(), 1, size, f) != size) {
+            fprintf(stderr, "Cannot write %s\n", binPath);
+            if (f) fclose(f);
+            return 1;
+        }
+        fclose(f);
+        printf("Wrote %s\n", binPath);
+    }
+    if (headerPath) {
+        if (!writeHeader(headerPath, arrayName, blob.data(), size, version)) {
+            fprintf(stderr, "Cannot write %s\n", headerPath);
+            return 1;
+        }
+        printf("Wrote %s\n", headerPath);
+    }
+    return 0;
+}
@@ -0,0 +1,524 @@
+/**
+ * @file noalloc.cpp
+ * @brief Fails if the steady-state path touches the heap
+ *
+ * Replaces malloc/calloc/realloc and every operator new with counting
+ * versions, sets up a radar with the tracker (and its warm-restart
+ * saves, gesture recognizer, rolling windows and speed sketch), black
+ * box, OSC encoder, config hot-swap, scheduler, pipelines, UART
+ * tunnel (sender and receiver) and calibration, then arms the counter and streams frames through
+ * update(), update(maxBytes, maxMicros), update(source) and feed() on a
+ * virtual clock. The stream includes corrupt and truncated frames,
+ * garbage, silences, a frozen sensor, empty rooms (idle level),
+ * black-box triggers and config swaps, so the error and recovery paths
+ * are covered as well as the happy path.
+ *
+ * Any allocation after initialisation is a failure; the report names the
+ * stage that made it. Everything the harness itself needs is allocated
+ * before arming.
+ *
+ * Build: see extras/host/README.md
+ *
+ * Usage:
+ *   ./noalloc [-n frames]
+ *   Exit code 0 = no allocations, 1 = failure.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_BlackBox.h"
+#include "RD03D_Calibration.h"
+#include "RD03D_Config.h"
+#include "RD03D_Gesture.h"
+#include "RD03D_Input.h"
+#include "RD03D_OSC.h"
+#include "RD03D_Pipeline.h"
+#include "RD03D_Scheduler.h"
+#include "RD03D_Sim.h"
+#include "RD03D_Sketch.h"
+#include "RD03D_Tracker.h"
+#include "RD03D_Tunnel.h"
+
+// ============== ALLOCATION COUNTER ==============
+enum Phase {
+    PHASE_HARNESS,
+    PHASE_UPDATE,
+    PHASE_BOUNDED_UPDATE,
+    PHASE_FEED,
+    PHASE_SOURCE,
+    PHASE_CALLBACK,
+    PHASE_BLACKBOX,
+    PHASE_CONFIG,
+    PHASE_DEFERRED,
+    PHASE_CALIBRATION,
+    PHASE_COUNT
+};
+
+static const char* PHASE_NAMES[PHASE_COUNT] = {
+    "harness",
+    "update()",
+    "update(maxBytes, maxMicros)",
+    "feed()",
+    "update(source)",
+    "frame callback (tracker, scheduler, pipelines, OSC)",
+    "black box service()",
+    "config stage/swap",
+    "scheduler runDeferred()",
+    "calibration"
+};
+
+static volatile bool g_armed = false;
+static volatile int g_phase = PHASE_HARNESS;
+static volatile unsigned long g_allocs[PHASE_COUNT];
+
+static inline void noteAlloc() {
+    if (g_armed) g_allocs[g_phase]++;
+}
+
+#ifdef __GLIBC__
+// glibc lets the executable interpose the allocator; forward to the real one
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* p, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* p);
+
+void* malloc(size_t size) {
+    noteAlloc();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size) {
+    noteAlloc();
+    return __libc_calloc(n, size);
+}
+
+void* realloc(void* p, size_t size) {
+    noteAlloc();
+    return __libc_realloc(p, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    noteAlloc();
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    noteAlloc();
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    noteAlloc();
+    void* p = __libc_memalign(alignment, size);
+    if (!p) return 12;  // ENOMEM
+    *out = p;
+    return 0;
+}
+
+void free(void* p) {
+    __libc_free(p);
+}
+}
+
+static void* rawAlloc(size_t size) { return __libc_malloc(size ? size : 1); }
+static void* rawAlignedAlloc(size_t size, size_t alignment) { return __libc_memalign(alignment, size ? size : 1); }
+static void rawFree(void* p) { __libc_free(p); }
+#else
+// Elsewhere only operator new is counted
+static void* rawAlloc(size_t size) { return malloc(size ? size : 1); }
+static void* rawAlignedAlloc(size_t size, size_t alignment) {
+    void* p = nullptr;
+    return posix_memalign(&p, alignment < sizeof(void*) ? sizeof(void*) : alignment, size ? size : 1) == 0 ? p : nullptr;
+}
+static void rawFree(void* p) { free(p); }
+#endif
+
+void* operator new(size_t size) {
+    noteAlloc();
+    void* p = rawAlloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    noteAlloc();
+    void* p = rawAlloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    noteAlloc();
+    return rawAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    noteAlloc();
+    return rawAlloc(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    noteAlloc();
+    void* p = rawAlignedAlloc(size, (size_t)alignment);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    noteAlloc();
+    void* p = rawAlignedAlloc(size, (size_t)alignment);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { rawFree(p); }
+void operator delete[](void* p) noexcept { rawFree(p); }
+void operator delete(void* p, size_t) noexcept { rawFree(p); }
+void operator delete[](void* p, size_t) noexcept { rawFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { rawFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { rawFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { rawFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { rawFree(p); }
+
+static unsigned long totalAllocs() {
+    unsigned long total = 0;
+    for (int i = 0; i < PHASE_COUNT; i++) total += g_allocs[i];
+    return total;
+}
+
+// ============== LIBRARY UNDER TEST ==============
+#define NOALLOC_BLACKBOX_FRAMES 32
+#define NOALLOC_POST_TRIGGER    8
+#define NOALLOC_CAL_PAIRS       64
+#define NOALLOC_CONFIG_SIZE     256
+
+static HardwareSerial g_port;
+static RD03D g_radar;
+static RD03D g_radarB;     // Fed directly or from a ring, for feed() and calibration
+static uint8_t g_ringStorage[101];  // Odd size so frames straddle the wrap
+static RD03D_RingSource g_ring(g_ringStorage, sizeof(g_ringStorage));
+static RD03D_Tunnel g_tunnel(1);     // Forwards g_radarB's ring bytes to g_radarC
+static RD03D_TunnelReceiver g_tunnelRx;
+static RD03D g_radarC;
+
+static RD03D_Tracker g_tracker;
+static RD03D_GestureRecognizer g_gestures;
+static RD03D_QuantileSketch g_speeds(50, 5000);
+static RD03D_QuantileSketch g_shipped(50, 5000);
+static uint8_t g_sketchBlob[RD03D_SKETCH_MAX_SIZE];
+static RD03D_BlackBoxEntry g_bbStorage[NOALLOC_BLACKBOX_FRAMES];
+static RD03D_BlackBox g_blackBox(g_bbStorage, NOALLOC_BLACKBOX_FRAMES, NOALLOC_POST_TRIGGER);
+
+static RD03D_OSCEncoder g_osc;
+static uint8_t g_oscPacket[RD03D_OSC_MAX_BUNDLE];
+
+static uint32_t g_configA[NOALLOC_CONFIG_SIZE / 4];
+static uint32_t g_configB[NOALLOC_CONFIG_SIZE / 4];
+static uint32_t g_configSource[NOALLOC_CONFIG_SIZE / 4];
+static size_t g_configLen = 0;
+static RD03D_ConfigShadow g_shadow(g_radar, (uint8_t*)g_configA, (uint8_t*)g_configB, NOALLOC_CONFIG_SIZE);
+
+static RD03D_Scheduler g_scheduler;
+
+static RD03D_Tracker g_pipeTracker;
+static RD03D_Pose g_pose;
+static RD03D_ValidateStage g_validate(600, 60);
+static RD03D_PoseStage g_poseStage(g_pose);
+static RD03D_TrackStage g_track(g_pipeTracker);
+static RD03D_Pipeline<RD03D_ValidateStage, RD03D_PoseStage, RD03D_TrackStage>
+    g_pipeline(g_validate, g_poseStage, g_track);
+
+static RD03D_Tracker g_dynTracker;
+static RD03D_TrackStage g_dynTrack(g_dynTracker);
+static RD03D_DynamicPipeline g_dynPipeline;
+
+static RD03D_CalibrationPair g_calStorage[NOALLOC_CAL_PAIRS];
+static RD03D_Calibration g_calibration(g_calStorage, NOALLOC_CAL_PAIRS);
+
+static RD03D_Target g_targetsB[RD03D_MAX_TARGETS];
+static uint32_t g_sink = 0;    // Keeps encoder output observable
+
+// ============== STAGES AND CALLBACKS ==============
+static uint8_t g_trackerState[RD03D_TRACKER_STATE_SIZE];
+static RD03D_TrackSample g_samples[RD03D_MAX_TRACKS];
+
+static void trackStage(RD03D_Target* targets, uint8_t count) {
+    (void)count;
+    g_tracker.update(targets, millis());
+    g_sink += g_tracker.saveState(g_trackerState, sizeof(g_trackerState), millis(), millis());
+    g_sink += g_gestures.update(g_tracker, millis());
+    g_sink += g_tracker.sampleAt(millis() - 50, g_samples);
+
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        const RD03D_Track* t = g_tracker.getTrack(i);
+        if (t->isValid()) g_speeds.add(g_tracker.getWindow(i)->getLatest(RD03D_WINDOW_SPEED));
+    }
+    size_t len = g_speeds.serialize(g_sketchBlob, sizeof(g_sketchBlob));
+    g_sink += g_shipped.deserialize(g_sketchBlob, len);
+    g_shipped.merge(g_speeds);
+}
+
+static void oscStage(RD03D_Target* targets, uint8_t count) {
+    for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+        if (targets[i].valid) {
+            g_sink += g_osc.encodeTarget(i, targets[i], g_oscPacket, sizeof(g_oscPacket));
+        }
+    }
+    g_sink += g_osc.encodeCount(count, g_oscPacket, sizeof(g_oscPacket));
+    g_sink += g_osc.encodeBundle(targets, g_oscPacket, sizeof(g_oscPacket));
+}
+
+static void slowStage(RD03D_Target* targets, uint8_t count) {
+    (void)targets;
+    (void)count;
+    hostAdvanceMicros(90000);  // Too slow to fit the frame, so it gets deferred
+}
+
+static void onFrame(RD03D_Target* targets, uint8_t count) {
+    int phase = g_phase;
+    g_phase = PHASE_CALLBACK;
+    g_scheduler.runFrame(targets, count);
+    g_pipeline.process(targets, count);
+    g_dynPipeline.process(targets, count);
+    g_phase = phase;
+}
+
+static void onFrameB(RD03D_Target* targets, uint8_t count) {
+    (void)count;
+    for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+        g_targetsB[i] = targets[i];
+    }
+}
+
+static bool onFlush(const RD03D_BlackBoxEntry& entry, uint16_t index, uint16_t total) {
+    g_sink += entry.timestamp + index + total;
+    return true;
+}
+
+static bool onTunnelSend(const uint8_t* datagram, size_t len) {
+    return g_tunnelRx.receive(datagram, len, g_radarC) != RD03D_TUNNEL_INVALID;
+}
+
+static void onFrozen(bool frozen) { g_sink += frozen; }
+static void onLevel(uint8_t level) { g_sink += level; }
+
+// ============== STREAM ==============
+/**
+ * @brief Build the frame for step n (one walker, empty every so often)
+ */
+static void buildFrame(uint32_t n, bool empty, uint8_t* out) {
+    static const uint8_t header[4] = {0xAA, 0xFF, 0x03, 0x00};
+    memcpy(out, header, 4);
+    memset(out + 4, 0, 24);
+    if (!empty) {
+        int phase = (int)(n % 200);
+        int x = (phase < 100 ? phase : 200 - phase) * 30 - 1500;
+        rd03dSimEncodeTarget(x, 2000 + (int)(n % 7) * 10, 40, out + 4);
+        rd03dSimEncodeTarget(-x / 2, 3500, -20, out + 12);
+    }
+    out[28] = 0x55;
+    out[29] = 0xCC;
+}
+
+static bool setup(size_t rxBuffer) {
+    hostUseVirtualClock(true);
+    hostSetMicros(1000000);
+
+    if (!g_radar.begin(g_port, -1, -1, rxBuffer)) return false;
+    g_radar.onFrame(onFrame);
+    g_gestures.addDefaultGestures();
+    g_radar.attachBlackBox(&g_blackBox);
+    g_radar.onFrozen(onFrozen);
+    g_radar.setIdleTimeout(2000);
+    g_radar.onLevelChange(onLevel);
+    g_radar.setOverloadControl(true);
+    g_blackBox.onFlush(onFlush);
+    g_blackBox.setErrorTrigger(3, 1000);
+
+    g_radarB.onFrame(onFrameB);
+    g_radarB.attachTunnel(&g_tunnel, true);
+    g_tunnel.onSend(onTunnelSend);
+
+    g_scheduler.addStage("track", trackStage, true);
+    g_scheduler.addStage("osc", oscStage, true);
+    g_scheduler.addStage("slow", slowStage, false, 50);
+
+    g_dynPipeline.add(&g_validate);
+    g_dynPipeline.add(&g_dynTrack);
+
+    g_osc.setPrefix("/room/radar");
+
+    RD03D_ConfigSettings settings;
+    memset(&settings, 0, sizeof(settings));
+    settings.timeoutMs = 1000;
+    settings.flags = RD03D_CONFIG_FLAG_POSE;
+    settings.poseX = 100;
+    settings.poseTheta = 5;
+    g_configLen = RD03D_ConfigBlob::build(settings, nullptr, 0, 1, (uint8_t*)g_configSource, sizeof(g_configSource));
+    return g_configLen > 0;
+}
+
+static void run(uint32_t frames) {
+    uint8_t frame[RD03D_SIM_FRAME_SIZE];
+    uint8_t frozen[RD03D_SIM_FRAME_SIZE];
+    static const uint8_t garbage[11] = {0x13, 0xAA, 0x00, 0xFF, 0x55, 0xCC, 0xAA, 0xFF, 0x03, 0x00, 0x42};
+    buildFrame(12345, false, frozen);
+
+    for (uint32_t n = 0; n < frames; n++) {
+        uint32_t step = n % 1000;
+        bool empty = (n / 1000) % 5 == 4;       // Empty room every fifth block (idle level)
+        bool freeze = step >= 500 && step < 580 && (n / 1000) % 5 == 1;
+
+        g_phase = PHASE_HARNESS;
+        if (freeze) {
+            memcpy(frame, frozen, sizeof(frame));
+        } else {
+            buildFrame(n, empty, frame);
+        }
+
+        // Faults
+        if (step == 100) {
+            frame[10] ^= 0x5A;
+            frame[29] = 0x00;                    // Bad tail
+        } else if (step == 200) {
+            g_port.hostInject(frame, 17);         // Truncated frame
+        } else if (step == 300) {
+            g_port.hostInject(garbage, sizeof(garbage));
+        } else if (step == 700) {
+            hostAdvanceMicros(3000000);          // Silence past the timeout
+        }
+        g_port.hostInject(frame, sizeof(frame));
+        hostAdvanceMicros(100000);
+
+        if (n % 3 == 0) {
+            g_phase = PHASE_BOUNDED_UPDATE;
+            while (g_radar.update(RD03D_READ_CHUNK, 500)) {}
+        } else {
+            g_phase = PHASE_UPDATE;
+            g_radar.update();
+        }
+
+        buildFrame(n + 50, empty, frame);
+        if (n % 2 == 0) {
+            g_phase = PHASE_FEED;
+            g_radarB.feed(frame, 13);
+            g_radarB.feed(frame + 13, sizeof(frame) - 13);
+        } else {
+            g_phase = PHASE_SOURCE;
+            g_ring.write(frame, sizeof(frame));
+            g_radarB.update(g_ring);
+        }
+
+        g_phase = PHASE_CALIBRATION;
+        g_calibration.addFrames(g_radar.getTargets(), g_targetsB);
+        if (g_calibration.getCount() >= NOALLOC_CAL_PAIRS) {
+            RD03D_Pose pose;
+            g_calibration.solve(pose);
+            g_calibration.clear();
+        }
+
+        g_phase = PHASE_DEFERRED;
+        g_scheduler.runDeferred();
+
+        g_phase = PHASE_BLACKBOX;
+        if (step == 400) g_blackBox.trigger();
+        g_blackBox.service();
+
+        g_phase = PHASE_CONFIG;
+        if (step == 600) {
+            uint8_t* buffer = g_shadow.getBuffer();
+            if (buffer) {
+                memcpy(buffer, g_configSource, g_configLen);
+                g_shadow.commit(g_configLen);
+            }
+        } else if (step == 800) {
+            g_shadow.stage((const uint8_t*)g_configSource, g_configLen);
+        }
+    }
+    g_phase = PHASE_HARNESS;
+}
+
+// ============== MAIN ==============
+int main(int argc, char** argv) {
+    uint32_t frames = 100000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            frames = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "Usage: %s [-n frames]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Prove the interceptor is live; otherwise a pass means nothing
+    g_armed = true;
+    void* volatile probe = malloc(32);
+    free(probe);
+    int* volatile probeNew = new int(1);
+    delete probeNew;
+    g_armed = false;
+#ifdef __GLIBC__
+    unsigned long expected = 2;
+#else
+    unsigned long expected = 1;  // malloc() itself is not intercepted
+#endif
+    if (g_allocs[PHASE_HARNESS] < expected) {
+        printf("FAIL: allocation interceptor not active\n");
+        return 1;
+    }
+    g_allocs[PHASE_HARNESS] = 0;
+
+    // stdio buffers and anything lazily created on first use
+    printf("noalloc: %u frames\n", (unsigned)frames);
+    fflush(stdout);
+    if (!setup(8192)) {
+        printf("FAIL: setup\n");
+        return 1;
+    }
+    run(1000);
+
+    uint32_t before = g_radar.getFrameCount();
+    g_armed = true;
+    run(frames);
+    g_armed = false;
+
+    printf("frames %u, errors %u, frozen %u, conflated %u, config swaps %u, idle skipped %u\n",
+           (unsigned)(g_radar.getFrameCount() - before),
+           (unsigned)g_radar.getErrorCount(),
+           (unsigned)g_radar.getFrozenCount(),
+           (unsigned)g_radar.getConflatedCount(),
+           (unsigned)g_radar.getConfigSwapCount(),
+           (unsigned)g_radar.getIdleSkippedCount());
+    printf("ring frames %u, ring overflow %u, tunnel datagrams %u, tunnelled frames %u\n",
+           (unsigned)g_radarB.getFrameCount(),
+           (unsigned)g_ring.getOverflowCount(),
+           (unsigned)g_tunnelRx.getReceivedCount(),
+           (unsigned)g_radarC.getFrameCount());
+    printf("tracks %u, gestures %u, black box triggers %u, deferred %u, skipped %u, pipeline runs %u/%u\n",
+           (unsigned)g_tracker.getTrackCount(),
+           (unsigned)g_gestures.getEventCount(),
+           (unsigned)g_blackBox.getTriggerCount(),
+           (unsigned)g_scheduler.getDeferredCount(),
+           (unsigned)g_scheduler.getSkippedCount(),
+           (unsigned)g_pipeline.getTiming(2)->runs,
+           (unsigned)g_dynPipeline.getTiming(1)->runs);
+
+    unsigned long total = totalAllocs();
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        if (g_allocs[i] > 0) {
+            printf("FAIL: %lu allocations in %s\n", g_allocs[i], PHASE_NAMES[i]);
+        }
+    }
+    if (total > 0 || g_sink == 0) {
+        if (total == 0) printf("FAIL: encoders produced no output\n");
+        return 1;
+    }
+    printf("PASS: no heap allocations after initialisation\n");
+    return 0;
+}
@@ -0,0 +1,602 @@
+/**
+ * @file pipeline.cpp
+ * @brief Multithreaded host processing pipeline with per-stage queues
+ *
+ * Processes many sensors in parallel in five stages:
+ *
+ *   ingest -> decode[shard] -> track[shard] -> fuse -> publish
+ *
+ * Sensors are sharded by ID across the decode and track threads. Stages
+ * are connected by bounded lock-free SPSC queues (one per shard edge),
+ * so there are no locks on the data path and back-pressure is explicit.
+ *
+ * Output order is deterministic regardless of shard count or thread
+ * timing: ingest stamps every chunk with a tick number and closes each
+ * tick with a marker on every shard; fuse only releases a tick once all
+ * shards have passed it, then emits it sorted by sensor. The publish
+ * stage hashes its output so runs can be compared (-s 1 vs -s 8 must
+ * print the same hash).
+ *
+ * Decode uses RD03D::feed(), track uses RD03D_Tracker, fuse moves tracks
+ * into a common frame with RD03D_Pose and merges duplicates seen by
+ * overlapping sensors, publish encodes OSC with RD03D_OSCEncoder (and
+ * sends it if -u is given).
+ *
+ * Build: see extras/host/README.md (link with -pthread)
+ *
+ * Usage:
+ *   ./pipeline [-n sensors] [-s shards] [-f frames] [-r tickHz] [-u port] [--pin]
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_OSC.h"
+#include "RD03D_Pose.h"
+#include "RD03D_Sim.h"
+#include "RD03D_SpscQueue.h"
+#include "RD03D_Tracker.h"
+
+// ============== CONFIGURATION ==============
+#define PIPE_MAX_SHARDS     32
+#define PIPE_CHUNK_MAX      64
+#define PIPE_QUEUE_DEPTH    1024
+#define PIPE_TICK_MS        50       // Virtual time per tick (one frame at 20 Hz)
+#define PIPE_SENSOR_SPACING 3000.0f  // Sensors mounted in a row, 3 m apart
+#define PIPE_MERGE_MM       400.0f   // Tracks closer than this from different sensors are one person
+
+enum ItemKind : uint8_t {
+    ITEM_DATA,
+    ITEM_TICK,   // All data for this tick has been sent on this shard
+    ITEM_END
+};
+
+struct ChunkItem {
+    ItemKind kind;
+    uint16_t sensor;
+    uint32_t tick;
+    uint64_t ingestNs;
+    uint8_t len;
+    uint8_t bytes[PIPE_CHUNK_MAX];
+};
+
+struct FrameItem {
+    ItemKind kind;
+    uint16_t sensor;
+    uint32_t tick;
+    uint64_t ingestNs;
+    RD03D_Target targets[RD03D_MAX_TARGETS];
+};
+
+struct TrackSnapshot {
+    uint16_t id;
+    float x, y;
+};
+
+struct TrackItem {
+    ItemKind kind;
+    uint16_t sensor;
+    uint32_t tick;
+    uint64_t ingestNs;
+    uint8_t count;
+    TrackSnapshot tracks[RD03D_MAX_TRACKS];
+};
+
+struct FusedItem {
+    ItemKind kind;
+    uint32_t tick;
+    uint64_t ingestNs;   // Oldest contribution
+    uint16_t sensor;     // Sensor that first saw the object
+    uint16_t trackId;
+    uint8_t sensors;     // Number of sensors that saw it
+    float x, y;          // Common frame (mm)
+};
+
+typedef RD03D_SpscQueue<ChunkItem, PIPE_QUEUE_DEPTH> ChunkQueue;
+typedef RD03D_SpscQueue<FrameItem, PIPE_QUEUE_DEPTH> FrameQueue;
+typedef RD03D_SpscQueue<TrackItem, PIPE_QUEUE_DEPTH> TrackQueue;
+typedef RD03D_SpscQueue<FusedItem, PIPE_QUEUE_DEPTH * 4> FusedQueue;
+
+// ============== METRICS ==============
+static uint64_t nowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Per-thread stage statistics (log2 latency histogram)
+ */
+struct StageMetrics {
+    uint64_t items = 0;
+    uint64_t busyNs = 0;
+    uint64_t waits = 0;      // Back-pressure: pushes that found the next queue full
+    uint64_t maxLatencyNs = 0;
+    uint64_t buckets[64] = {0};
+
+    void record(uint64_t ingestNs, uint64_t startNs, uint64_t endNs) {
+        busyNs += endNs - startNs;
+        recordLatency(ingestNs, endNs);
+    }
+
+    void recordLatency(uint64_t ingestNs, uint64_t endNs) {
+        items++;
+        uint64_t lat = endNs - ingestNs;
+        if (lat > maxLatencyNs) maxLatencyNs = lat;
+        buckets[lat ? 63 - __builtin_clzll(lat) : 0]++;
+    }
+
+    void merge(const StageMetrics& o) {
+        items += o.items;
+        busyNs += o.busyNs;
+        waits += o.waits;
+        if (o.maxLatencyNs > maxLatencyNs) maxLatencyNs = o.maxLatencyNs;
+        for (int i = 0; i < 64; i++) buckets[i] += o.buckets[i];
+    }
+
+    uint64_t percentileNs(double p) const {
+        uint64_t target = (uint64_t)(items * p);
+        uint64_t seen = 0;
+        for (int i = 0; i < 64; i++) {
+            seen += buckets[i];
+            if (seen > target) return std::min(2ULL << i, (unsigned long long)maxLatencyNs);  // Bucket upper bound
+        }
+        return maxLatencyNs;
+    }
+};
+
+// ============== PIPELINE STATE ==============
+struct PipelineOptions {
+    int sensors = 64;
+    int shards = 4;
+    int frames = 2000;
+    double tickHz = 0.0;   // 0 = as fast as possible
+    int udpPort = 0;
+    bool pin = false;
+};
+
+struct Pipeline {
+    PipelineOptions opt;
+    std::vector<std::vector<uint8_t>> streams;   // Raw bytes per sensor
+    std::vector<RD03D_Pose> poses;
+
+    ChunkQueue* chunkQueues[PIPE_MAX_SHARDS];
+    FrameQueue* frameQueues[PIPE_MAX_SHARDS];
+    TrackQueue* trackQueues[PIPE_MAX_SHARDS];
+    FusedQueue* fusedQueue;
+
+    StageMetrics ingestMetrics;
+    StageMetrics decodeMetrics[PIPE_MAX_SHARDS];
+    StageMetrics trackMetrics[PIPE_MAX_SHARDS];
+    StageMetrics fuseMetrics;
+    StageMetrics publishMetrics;
+
+    uint64_t outputHash = 1469598103934665603ULL;
+    uint64_t outputRecords = 0;
+};
+
+/**
+ * @brief Pin the calling stage thread to one CPU (Linux only)
+ *
+ * main() clears --pin on other platforms, so this is a no-op there.
+ */
+static void pinThread(const Pipeline& p, int cpu) {
+    if (!p.opt.pin) return;
+#ifdef __linux__
+    int ncpu = (int)std::thread::hardware_concurrency();
+    if (ncpu <= 0) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % ncpu, &set);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (err != 0) {
+        fprintf(stderr, "warning: could not pin thread to CPU %d: %s\n", cpu % ncpu, strerror(err));
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+// ============== INGEST ==============
+static void ingestStage(Pipeline& p) {
+    pinThread(p, 0);
+    std::vector<size_t> cursor(p.opt.sensors, 0);
+    uint64_t periodNs = p.opt.tickHz > 0 ? (uint64_t)(1e9 / p.opt.tickHz) : 0;
+    uint64_t nextTick = nowNs();
+
+    for (uint32_t tick = 0; ; tick++) {
+        if (periodNs) {
+            while (nowNs() < nextTick) std::this_thread::yield();
+            nextTick += periodNs;
+        }
+
+        bool any = false;
+        for (int s = 0; s < p.opt.sensors; s++) {
+            const std::vector<uint8_t>& stream = p.streams[s];
+            if (cursor[s] >= stream.size()) continue;
+            any = true;
+
+            // UART reads rarely line up with frames: vary the chunk size
+            size_t len = 20 + ((tick * 7 + s * 13) % 21);
+            if (len > stream.size() - cursor[s]) len = stream.size() - cursor[s];
+
+            uint64_t t0 = nowNs();
+            ChunkItem c;
+            c.kind = ITEM_DATA;
+            c.sensor = (uint16_t)s;
+            c.tick = tick;
+            c.ingestNs = t0;
+            c.len = (uint8_t)len;
+            memcpy(c.bytes, stream.data() + cursor[s], len);
+            cursor[s] += len;
+
+            p.ingestMetrics.waits += p.chunkQueues[s % p.opt.shards]->push(c);
+            p.ingestMetrics.record(t0, t0, nowNs());
+        }
+
+        ChunkItem marker;
+        marker.kind = any ? ITEM_TICK : ITEM_END;
+        marker.tick = tick;
+        marker.ingestNs = nowNs();
+        for (int sh = 0; sh < p.opt.shards; sh++) {
+            p.chunkQueues[sh]->push(marker);
+        }
+        if (!any) break;
+    }
+}
+
+// ============== DECODE ==============
+struct DecodeContext {
+    Pipeline* p;
+    int shard;
+    const ChunkItem* chunk;
+};
+
+static thread_local DecodeContext* tls_decode = nullptr;
+
+static void onDecodedFrame(RD03D_Target* targets, uint8_t count) {
+    (void)count;
+    DecodeContext* ctx = tls_decode;
+    FrameItem f;
+    f.kind = ITEM_DATA;
+    f.sensor = ctx->chunk->sensor;
+    f.tick = ctx->chunk->tick;
+    f.ingestNs = ctx->chunk->ingestNs;
+    for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) f.targets[i] = targets[i];
+    ctx->p->decodeMetrics[ctx->shard].waits += ctx->p->frameQueues[ctx->shard]->push(f);
+}
+
+static void decodeStage(Pipeline& p, int shard) {
+    pinThread(p, 1 + shard);
+    // One parser per sensor in this shard
+    std::vector<RD03D*> parsers(p.opt.sensors, nullptr);
+    for (int s = shard; s < p.opt.sensors; s += p.opt.shards) {
+        parsers[s] = new RD03D();
+        parsers[s]->onFrame(onDecodedFrame);
+        parsers[s]->setOverloadControl(false);   // Output must not depend on host timing
+    }
+
+    DecodeContext ctx = {&p, shard, nullptr};
+    tls_decode = &ctx;
+    StageMetrics& m = p.decodeMetrics[shard];
+
+    while (true) {
+        ChunkItem c;
+        p.chunkQueues[shard]->pop(c);
+        if (c.kind != ITEM_DATA) {
+            FrameItem marker;
+            marker.kind = c.kind;
+            marker.tick = c.tick;
+            marker.ingestNs = c.ingestNs;
+            p.frameQueues[shard]->push(marker);
+            if (c.kind == ITEM_END) break;
+            continue;
+        }
+        uint64_t t0 = nowNs();
+        ctx.chunk = &c;
+        parsers[c.sensor]->feed(c.bytes, c.len);
+        m.record(c.ingestNs, t0, nowNs());
+    }
+
+    for (RD03D* r : parsers) delete r;
+}
+
+// ============== TRACK ==============
+static void trackStage(Pipeline& p, int shard) {
+    pinThread(p, 1 + p.opt.shards + shard);
+    std::vector<RD03D_Tracker*> trackers(p.opt.sensors, nullptr);
+    for (int s = shard; s < p.opt.sensors; s += p.opt.shards) {
+        trackers[s] = new RD03D_Tracker();
+    }
+    StageMetrics& m = p.trackMetrics[shard];
+
+    while (true) {
+        FrameItem f;
+        p.frameQueues[shard]->pop(f);
+        TrackItem out;
+        out.kind = f.kind;
+        out.tick = f.tick;
+        out.ingestNs = f.ingestNs;
+        out.sensor = f.sensor;
+        out.count = 0;
+
+        if (f.kind == ITEM_DATA) {
+            uint64_t t0 = nowNs();
+            // Tick-based time keeps tracker output deterministic
+            RD03D_Tracker* tracker = trackers[f.sensor];
+            tracker->update(f.targets, f.tick * PIPE_TICK_MS);
+            for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+                RD03D_Track* t = tracker->getTrack(i);
+                if (!t->isValid()) continue;
+                out.tracks[out.count++] = {t->id, t->x, t->y};
+            }
+            m.waits += p.trackQueues[shard]->push(out);
+            m.record(f.ingestNs, t0, nowNs());
+        } else {
+            p.trackQueues[shard]->push(out);
+            if (f.kind == ITEM_END) break;
+        }
+    }
+
+    for (RD03D_Tracker* t : trackers) delete t;
+}
+
+// ============== FUSE ==============
+static void fuseTick(Pipeline& p, std::vector<TrackItem>& items, std::vector<FusedItem>& fused) {
+    fused.clear();
+    for (const TrackItem& it : items) {
+        for (uint8_t i = 0; i < it.count; i++) {
+            float x, y;
+            p.poses[it.sensor].apply(it.tracks[i].x, it.tracks[i].y, x, y);
+
+            // Merge with an object already seen by another sensor this tick
+            FusedItem* match = nullptr;
+            for (FusedItem& f : fused) {
+                if (f.sensor != it.sensor && hypotf(f.x - x, f.y - y) < PIPE_MERGE_MM) {
+                    match = &f;
+                    break;
+                }
+            }
+            if (match) {
+                match->x = (match->x * match->sensors + x) / (match->sensors + 1);
+                match->y = (match->y * match->sensors + y) / (match->sensors + 1);
+                match->sensors++;
+                if (it.ingestNs < match->ingestNs) match->ingestNs = it.ingestNs;
+                continue;
+            }
+
+            FusedItem f;
+            f.kind = ITEM_DATA;
+            f.tick = it.tick;
+            f.ingestNs = it.ingestNs;
+            f.sensor = it.sensor;
+            f.trackId = it.tracks[i].id;
+            f.sensors = 1;
+            f.x = x;
+            f.y = y;
+            fused.push_back(f);
+        }
+    }
+}
+
+static void fuseStage(Pipeline& p) {
+    pinThread(p, 1 + 2 * p.opt.shards);
+    std::vector<int64_t> doneTick(p.opt.shards, -1);
+    std::vector<bool> ended(p.opt.shards, false);
+    std::vector<TrackItem> pending;
+    std::vector<TrackItem> tickItems;
+    std::vector<FusedItem> fused;
+    int endedCount = 0;
+
+    while (endedCount < p.opt.shards) {
+        // Drain every shard queue without blocking on any one of them
+        bool progress = false;
+        for (int sh = 0; sh < p.opt.shards; sh++) {
+            TrackItem it;
+            while (!ended[sh] && p.trackQueues[sh]->tryPop(it)) {
+                progress = true;
+                if (it.kind == ITEM_DATA) {
+                    pending.push_back(it);
+                } else if (it.kind == ITEM_TICK) {
+                    doneTick[sh] = it.tick;
+                } else {
+                    ended[sh] = true;
+                    doneTick[sh] = INT64_MAX;
+                    endedCount++;
+                }
+            }
+        }
+        if (!progress) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Release every tick all shards have completed, in (tick, sensor) order.
+        // Stable sort: a sensor can finish two frames in one tick, and those
+        // arrive in order from the same shard
+        int64_t watermark = *std::min_element(doneTick.begin(), doneTick.end());
+        if (pending.empty()) continue;
+        std::stable_sort(pending.begin(), pending.end(), [](const TrackItem& a, const TrackItem& b) {
+            return a.tick != b.tick ? a.tick < b.tick : a.sensor < b.sensor;
+        });
+
+        size_t i = 0;
+        while (i < pending.size() && (int64_t)pending[i].tick <= watermark) {
+            uint64_t t0 = nowNs();
+            uint32_t tick = pending[i].tick;
+            tickItems.clear();
+            while (i < pending.size() && pending[i].tick == tick) {
+                tickItems.push_back(pending[i++]);
+            }
+            fuseTick(p, tickItems, fused);
+            p.fuseMetrics.busyNs += nowNs() - t0;
+            for (const FusedItem& f : fused) {
+                p.fuseMetrics.waits += p.fusedQueue->push(f);
+                p.fuseMetrics.recordLatency(f.ingestNs, nowNs());
+            }
+        }
+        pending.erase(pending.begin(), pending.begin() + i);
+    }
+
+    FusedItem end;
+    end.kind = ITEM_END;
+    p.fusedQueue->push(end);
+}
+
+// ============== PUBLISH ==============
+static void publishStage(Pipeline& p) {
+    pinThread(p, 2 + 2 * p.opt.shards);
+    int sock = -1;
+    sockaddr_in dest = {};
+    if (p.opt.udpPort) {
+        sock = socket(AF_INET, SOCK_DGRAM, 0);
+        dest.sin_family = AF_INET;
+        dest.sin_port = htons(p.opt.udpPort);
+        inet_pton(AF_INET, "127.0.0.1", &dest.sin_addr);
+    }
+
+    RD03D_OSCEncoder osc;
+    osc.setPrefix("/fused");
+    uint8_t packet[RD03D_OSC_MAX_MESSAGE];
+
+    while (true) {
+        FusedItem f;
+        p.fusedQueue->pop(f);
+        if (f.kind == ITEM_END) break;
+
+        uint64_t t0 = nowNs();
+        RD03D_Target t;
+        t.clear();
+        t.valid = true;
+        t.x = (int16_t)lroundf(constrain(f.x, -32767.0f, 32767.0f));
+        t.y = (int16_t)lroundf(constrain(f.y, -32767.0f, 32767.0f));
+        t.distance = hypotf(f.x, f.y) / 10.0f;
+        t.angle = atan2f(f.x, f.y) * 180.0f / PI;
+        size_t len = osc.encodeTarget(0, t, packet, sizeof(packet));
+        if (sock >= 0) {
+            sendto(sock, packet, len, 0, (sockaddr*)&dest, sizeof(dest));
+        }
+
+        // FNV-1a over the ordered output
+        uint32_t fields[5] = {f.tick, f.sensor, f.trackId, (uint32_t)(uint16_t)t.x, (uint32_t)(uint16_t)t.y};
+        const uint8_t* bytes = (const uint8_t*)fields;
+        for (size_t i = 0; i < sizeof(fields); i++) {
+            p.outputHash = (p.outputHash ^ bytes[i]) * 1099511628211ULL;
+        }
+        p.outputRecords++;
+        p.publishMetrics.record(f.ingestNs, t0, nowNs());
+    }
+
+    if (sock >= 0) close(sock);
+}
+
+// ============== MAIN ==============
+static void printStage(const char* name, const StageMetrics& m, double seconds) {
+    printf("%-8s %10llu %10.0f %8.2f %9.1f %9.1f %9.1f %8llu\n",
+           name, (unsigned long long)m.items, m.items / seconds,
+           m.items ? (double)m.busyNs / m.items / 1000.0 : 0.0,
+           m.percentileNs(0.5) / 1000.0, m.percentileNs(0.99) / 1000.0,
+           m.maxLatencyNs / 1000.0, (unsigned long long)m.waits);
+}
+
+int main(int argc, char** argv) {
+    Pipeline* p = new Pipeline();
+    PipelineOptions& opt = p->opt;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (a == "-n" && hasValue) opt.sensors = atoi(argv[++i]);
+        else if (a == "-s" && hasValue) opt.shards = atoi(argv[++i]);
+        else if (a == "-f" && hasValue) opt.frames = atoi(argv[++i]);
+        else if (a == "-r" && hasValue) opt.tickHz = atof(argv[++i]);
+        else if (a == "-u" && hasValue) opt.udpPort = atoi(argv[++i]);
+        else if (a == "--pin") opt.pin = true;
+        else {
+            fprintf(stderr, "usage: pipeline [-n sensors] [-s shards] [-f frames] [-r tickHz] [-u port] [--pin]\n");
+            return 1;
+        }
+    }
+    if (opt.shards < 1 || opt.shards > PIPE_MAX_SHARDS || opt.sensors < 1 || opt.sensors > 65535) {
+        fprintf(stderr, "shards must be 1-%d, sensors 1-65535\n", PIPE_MAX_SHARDS);
+        return 1;
+    }
+#ifndef __linux__
+    if (opt.pin) {
+        fprintf(stderr, "warning: --pin is only supported on Linux, running unpinned\n");
+        opt.pin = false;
+    }
+#endif
+
+    // Each sensor replays a simulator scene with its own seed
+    std::vector<SimScene> scenes = rd03dSimScenes();
+    SimRadarModel model;
+    for (int s = 0; s < opt.sensors; s++) {
+        RD03D_Sim sim(scenes[s % scenes.size()], model, 100 + s);
+        std::vector<SimFrame> frames = sim.run(1000.0 / PIPE_TICK_MS);
+        std::vector<uint8_t> bytes;
+        for (int k = 0; k < opt.frames; k++) {
+            const SimFrame& f = frames[k % frames.size()];
+            bytes.insert(bytes.end(), f.bytes, f.bytes + RD03D_SIM_FRAME_SIZE);
+        }
+        p->streams.push_back(bytes);
+
+        RD03D_Pose pose = {s * PIPE_SENSOR_SPACING, 0.0f, 0.0f};
+        p->poses.push_back(pose);
+    }
+
+    for (int sh = 0; sh < opt.shards; sh++) {
+        p->chunkQueues[sh] = new ChunkQueue();
+        p->frameQueues[sh] = new FrameQueue();
+        p->trackQueues[sh] = new TrackQueue();
+    }
+    p->fusedQueue = new FusedQueue();
+
+    printf("Pipeline: %d sensors, %d shards, %d frames/sensor, %s%s\n\n",
+           opt.sensors, opt.shards, opt.frames,
+           opt.tickHz > 0 ? "paced" : "unpaced", opt.pin ? ", pinned" : "");
+
+    uint64_t start = nowNs();
+    std::vector<std::thread> threads;
+    threads.emplace_back(publishStage, std::ref(*p));
+    threads.emplace_back(fuseStage, std::ref(*p));
+    for (int sh = 0; sh < opt.shards; sh++) {
+        threads.emplace_back(trackStage, std::ref(*p), sh);
+        threads.emplace_back(decodeStage, std::ref(*p), sh);
+    }
+    threads.emplace_back(ingestStage, std::ref(*p));
+    for (std::thread& t : threads) t.join();
+    double seconds = (nowNs() - start) / 1e9;
+
+    StageMetrics decode, track;
+    for (int sh = 0; sh < opt.shards; sh++) {
+        decode.merge(p->decodeMetrics[sh]);
+        track.merge(p->trackMetrics[sh]);
+    }
+
+    printf("%-8s %10s %10s %8s %9s %9s %9s %8s\n",
+           "stage", "items", "items/s", "busy us", "p50 us", "p99 us", "max us", "waits");
+    printStage("ingest", p->ingestMetrics, seconds);
+    printStage("decode", decode, seconds);
+    printStage("track", track, seconds);
+    printStage("fuse", p->fuseMetrics, seconds);
+    printStage("publish", p->publishMetrics, seconds);
+    printf("\n(latency = time since ingest when the stage finished the item)\n");
+    printf("\n%.2f s, %.0f sensor-frames/s, %llu output records, output hash %016llx\n",
+           seconds, track.items / seconds, (unsigned long long)p->outputRecords,
+           (unsigned long long)p->outputHash);
+    return 0;
+}
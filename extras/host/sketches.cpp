@@ -0,0 +1,260 @@
+/**
+ * @file sketches.cpp
+ * @brief Merge quantile sketches shipped by devices and report quantiles
+ *
+ * Reads device logs containing `sketch,<name>,<hex>` lines (the format
+ * printed by the Sketches example) and/or binary files of concatenated
+ * RD03D_QuantileSketch::serialize() blobs, merges all sketches with the
+ * same name (binary files are named after the file) and prints count,
+ * mean, min, the requested quantiles and max for each. -o writes the
+ * merged sketches back out as sketch lines, so hourly sketches can be
+ * rolled up into days and days into months.
+ *
+ * --check splits a synthetic walking-speed sample into shards, sketches
+ * each shard, round-trips and merges them, and compares the quantiles
+ * with the exact ones.
+ *
+ * Build: see extras/host/README.md
+ *
+ * Usage:
+ *   ./sketches [-q 0.5,0.95,0.99] [-o merged.txt] log_or_bin...
+ *   ./sketches --check [shards]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "RD03D_Sketch.h"
+
+struct Merged {
+    RD03D_QuantileSketch sketch;
+    unsigned parts;
+    bool valid;
+
+    Merged() : sketch(1.0f, 2.0f), parts(0), valid(true) {}
+};
+
+static std::map<std::string, Merged> g_merged;
+static unsigned g_rejected = 0;
+
+static void addSketch(const std::string& name, const uint8_t* blob, size_t len, size_t* used) {
+    RD03D_QuantileSketch s(1.0f, 2.0f);
+    size_t n = s.deserialize(blob, len);
+    if (used) *used = n;
+    if (n == 0) {
+        g_rejected++;
+        return;
+    }
+
+    Merged& m = g_merged[name];
+    if (m.parts == 0) {
+        m.sketch = s;
+    } else if (!m.sketch.merge(s)) {
+        fprintf(stderr, "%s: sketches with different ranges, not merged\n", name.c_str());
+        m.valid = false;
+    }
+    m.parts++;
+}
+
+// ============== INPUT ==============
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool loadFile(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    std::vector<uint8_t> data;
+    uint8_t buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.insert(data.end(), buf, buf + n);
+    fclose(f);
+
+    // Binary: concatenated blobs starting with the "RD3Q" magic
+    if (data.size() >= 4 && memcmp(data.data(), "RD3Q", 4) == 0) {
+        std::string name = path;
+        size_t slash = name.find_last_of('/');
+        if (slash != std::string::npos) name = name.substr(slash + 1);
+        size_t offset = 0;
+        while (offset < data.size()) {
+            size_t used = 0;
+            addSketch(name, data.data() + offset, data.size() - offset, &used);
+            if (used == 0) break;
+            offset += used;
+        }
+        return true;
+    }
+
+    // Text: sketch,<name>,<hex> lines; everything else is ignored
+    std::string text(data.begin(), data.end());
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(pos, end - pos);
+        pos = end + 1;
+
+        if (line.compare(0, 7, "sketch,") != 0) continue;
+        size_t comma = line.find(',', 7);
+        if (comma == std::string::npos) continue;
+        std::string name = line.substr(7, comma - 7);
+
+        std::vector<uint8_t> blob;
+        for (size_t i = comma + 1; i + 1 < line.size(); i += 2) {
+            int hi = hexDigit(line[i]);
+            int lo = hexDigit(line[i + 1]);
+            if (hi < 0 || lo < 0) break;
+            blob.push_back((uint8_t)(hi * 16 + lo));
+        }
+        addSketch(name, blob.data(), blob.size(), nullptr);
+    }
+    return true;
+}
+
+// ============== OUTPUT ==============
+static void printTable(const std::vector<float>& qs) {
+    printf("%-16s %6s %9s %9s %9s", "name", "parts", "count", "mean", "min");
+    for (float q : qs) printf("     p%-4g", q * 100.0f);
+    printf(" %9s\n", "max");
+
+    for (auto& it : g_merged) {
+        const Merged& m = it.second;
+        if (!m.valid) continue;
+        const RD03D_QuantileSketch& s = m.sketch;
+        printf("%-16s %6u %9u %9.1f %9.1f", it.first.c_str(), m.parts, (unsigned)s.getCount(),
+               s.getMean(), s.getMin());
+        for (float q : qs) printf(" %9.1f", s.quantile(q));
+        printf(" %9.1f\n", s.getMax());
+    }
+}
+
+static bool writeMerged(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    for (auto& it : g_merged) {
+        if (!it.second.valid) continue;
+        uint8_t blob[RD03D_SKETCH_MAX_SIZE];
+        size_t len = it.second.sketch.serialize(blob, sizeof(blob));
+        fprintf(f, "sketch,%s,", it.first.c_str());
+        for (size_t i = 0; i < len; i++) fprintf(f, "%02x", blob[i]);
+        fprintf(f, "\n");
+    }
+    fclose(f);
+    return true;
+}
+
+// ============== SELF-CHECK ==============
+static int runCheck(int shards) {
+    // Walking speeds (mm/s): log-normal around 1.2 m/s plus people standing
+    std::mt19937 rng(7);
+    std::lognormal_distribution<double> walk(log(1200.0), 0.35);
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+
+    const int samples = 2000000;
+    std::vector<float> all;
+    all.reserve(samples);
+    std::vector<RD03D_QuantileSketch> parts(shards, RD03D_QuantileSketch(50.0f, 5000.0f));
+    RD03D_QuantileSketch single(50.0f, 5000.0f);
+    for (int i = 0; i < samples; i++) {
+        float v = (uni(rng) < 0.1) ? (float)(uni(rng) * 40.0) : (float)walk(rng);
+        all.push_back(v);
+        parts[i % shards].add(v);
+        single.add(v);
+    }
+
+    // Ship every shard through serialize()/deserialize() and merge
+    RD03D_QuantileSketch merged(50.0f, 5000.0f);
+    size_t bytes = 0;
+    for (RD03D_QuantileSketch& p : parts) {
+        uint8_t blob[RD03D_SKETCH_MAX_SIZE];
+        size_t len = p.serialize(blob, sizeof(blob));
+        RD03D_QuantileSketch copy(1.0f, 2.0f);
+        if (len == 0 || copy.deserialize(blob, len) != len || !merged.merge(copy)) {
+            fprintf(stderr, "FAIL: round trip\n");
+            return 1;
+        }
+        bytes += len;
+    }
+
+    std::sort(all.begin(), all.end());
+    const float qs[] = {0.05f, 0.25f, 0.5f, 0.75f, 0.95f, 0.99f};
+    printf("%d values in %d shards, %zu bytes shipped (raw floats: %zu), bound %.2f%%\n",
+           samples, shards, bytes, all.size() * sizeof(float), merged.getRelativeError() * 100.0f);
+    printf("%6s %10s %10s %10s %8s\n", "q", "exact", "merged", "single", "error");
+
+    bool ok = merged.getCount() == (uint32_t)samples;
+    for (float q : qs) {
+        float exact = all[(size_t)(q * (all.size() - 1))];
+        float est = merged.quantile(q);
+        float err = fabsf(est - exact) / exact;
+        bool inRange = exact >= 50.0f && exact < 5000.0f;
+        if (est != single.quantile(q)) ok = false;
+        if (inRange && err > merged.getRelativeError() * 1.01f) ok = false;
+        if (inRange) {
+            printf("%6.2f %10.1f %10.1f %10.1f %7.2f%%\n", q, exact, est, single.quantile(q), err * 100.0f);
+        } else {
+            printf("%6.2f %10.1f %10.1f %10.1f  outside range\n", q, exact, est, single.quantile(q));
+        }
+    }
+    printf("%s\n", ok ? "PASS: merged sketch equals a single sketch and is within the bound"
+                      : "FAIL");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "--check") == 0) {
+        int shards = (argc >= 3) ? atoi(argv[2]) : 24;
+        return runCheck(shards > 0 ? shards : 1);
+    }
+
+    std::vector<float> qs = {0.5f, 0.95f};
+    const char* out = nullptr;
+    std::vector<const char*> inputs;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0 && i + 1 < argc) {
+            qs.clear();
+            char* save = nullptr;
+            for (char* tok = strtok_r(argv[++i], ",", &save); tok; tok = strtok_r(nullptr, ",", &save)) {
+                qs.push_back((float)atof(tok));
+            }
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out = argv[++i];
+        } else {
+            inputs.push_back(argv[i]);
+        }
+    }
+    if (inputs.empty()) {
+        fprintf(stderr, "usage: sketches [-q 0.5,0.95,0.99] [-o merged.txt] log_or_bin...\n"
+                        "       sketches --check [shards]\n");
+        return 2;
+    }
+
+    for (const char* path : inputs) {
+        if (!loadFile(path)) {
+            fprintf(stderr, "Cannot read %s\n", path);
+            return 1;
+        }
+    }
+    if (g_rejected > 0) fprintf(stderr, "%u damaged or incompatible sketches skipped\n", g_rejected);
+    if (g_merged.empty()) {
+        fprintf(stderr, "No sketches found\n");
+        return 1;
+    }
+
+    printTable(qs);
+    if (out && !writeMerged(out)) {
+        fprintf(stderr, "Cannot write %s\n", out);
+        return 1;
+    }
+    return 0;
+}
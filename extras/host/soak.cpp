@@ -0,0 +1,386 @@
+/**
+ * @file soak.cpp
+ * @brief Long-duration soak harness with an accelerated virtual clock
+ *
+ * Runs the full pipeline (parser, tracker, black box) for months of
+ * virtual time in minutes. The clock starts just before the 32-bit
+ * millis() wrap and keeps going through further wraps (every ~49.7 days;
+ * micros() wraps every ~71 minutes). Faults are injected on a schedule:
+ * corrupt tails, truncated frames, garbage bytes, short silences, frozen
+ * sensors repeating one frame, and one silence longer than the millis()
+ * wrap.
+ *
+ * Checked throughout:
+ * - Frame and error counters advance by exactly the expected amounts
+ * - isConnected() is true while streaming and false after each silence
+ * - isFrozen() catches every injected freeze and nothing else
+ * - Live heap blocks do not grow after warm-up
+ * - The 99.99th percentile of update() time stays under the latency bound
+ *   (a percentile, so a host preempting the odd call can't fail the run;
+ *   the wall-clock maximum is reported for information)
+ * - Tracks stay sane (finite positions, non-zero IDs)
+ * - Every black-box trigger flushes completely
+ *
+ * Build: see extras/host/README.md
+ *
+ * Usage:
+ *   ./soak [-d days] [-r hz] [-l maxLatencyUs] [-p percentile] [-s startMs] [--no-long-silence]
+ *   Exit code 0 = pass, 1 = failure.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_BlackBox.h"
+#include "RD03D_Sim.h"
+#include "RD03D_Tracker.h"
+
+// ============== SETTINGS ==============
+#define SOAK_BLACKBOX_FRAMES 32
+#define SOAK_POST_TRIGGER    8
+#define SOAK_LATENCY_BUCKETS 65536  // 1 us buckets; the last one collects everything longer
+
+static const uint64_t US_PER_MS = 1000ULL;
+static const uint64_t US_PER_DAY = 86400ULL * 1000000ULL;
+static const uint64_t MILLIS_WRAP_US = 4294967296ULL * US_PER_MS;
+
+// ============== PIPELINE STATE ==============
+static RD03D_Tracker g_tracker;
+static RD03D_BlackBoxEntry g_bbStorage[SOAK_BLACKBOX_FRAMES];
+static RD03D_BlackBox g_blackBox(g_bbStorage, SOAK_BLACKBOX_FRAMES, SOAK_POST_TRIGGER);
+static uint64_t g_flushed = 0;
+static uint64_t g_failures = 0;
+
+static void fail(const char* what, double day) {
+    g_failures++;
+    if (g_failures <= 20) {
+        printf("FAIL day %.3f: %s\n", day, what);
+    }
+}
+
+static void onFrame(RD03D_Target* targets, uint8_t count) {
+    (void)count;
+    g_tracker.update(targets, millis());
+}
+
+static bool onFlush(const RD03D_BlackBoxEntry& entry, uint16_t index, uint16_t total) {
+    (void)entry;
+    (void)index;
+    (void)total;
+    g_flushed++;
+    return true;
+}
+
+// ============== HEAP ==============
+// Counts live operator new blocks (the library itself never calls
+// malloc); portable, unlike glibc's mallinfo2()
+static volatile long g_liveBlocks = 0;
+
+void* operator new(size_t size) {
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    g_liveBlocks++;
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    g_liveBlocks--;
+    free(p);
+}
+
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+
+static size_t heapInUse() {
+    return (size_t)g_liveBlocks;
+}
+
+// ============== LATENCY ==============
+static uint32_t g_dayLatency[SOAK_LATENCY_BUCKETS];
+
+/**
+ * @brief Upper edge in us of the bucket holding the given percentile
+ */
+static uint64_t latencyPercentileUs(const uint32_t* hist, uint64_t total, double percentile) {
+    uint64_t rank = (uint64_t)(total * percentile / 100.0);
+    uint64_t seen = 0;
+    for (uint64_t b = 0; b < SOAK_LATENCY_BUCKETS; b++) {
+        seen += hist[b];
+        if (seen > rank) return b + 1;
+    }
+    return SOAK_LATENCY_BUCKETS;
+}
+
+// ============== MAIN ==============
+int main(int argc, char** argv) {
+    double days = 60.0;
+    double rateHz = 20.0;
+    uint64_t maxLatencyUs = 10000;
+    double percentile = 99.99;
+    uint64_t startMs = 4294967296ULL - 10ULL * 60ULL * 1000ULL;  // 10 min before wrap
+    bool longSilence = true;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (a == "-d" && hasValue) days = atof(argv[++i]);
+        else if (a == "-r" && hasValue) rateHz = atof(argv[++i]);
+        else if (a == "-l" && hasValue) maxLatencyUs = strtoull(argv[++i], nullptr, 10);
+        else if (a == "-p" && hasValue) percentile = atof(argv[++i]);
+        else if (a == "-s" && hasValue) startMs = strtoull(argv[++i], nullptr, 10);
+        else if (a == "--no-long-silence") longSilence = false;
+        else {
+            fprintf(stderr, "usage: soak [-d days] [-r hz] [-l maxLatencyUs] [-p percentile] [-s startMs] [--no-long-silence]\n");
+            return 1;
+        }
+    }
+
+    // One scene, looped for the whole run
+    SimScene scene = rd03dSimScenes()[2];
+    SimRadarModel model;
+    RD03D_Sim sim(scene, model, 7);
+    std::vector<SimFrame> frames = sim.run(rateHz);
+
+    hostUseVirtualClock(true);
+    hostSetMicros(startMs * US_PER_MS);
+
+    HardwareSerial port;
+    RD03D radar;
+    radar.begin(port, -1, -1);
+    radar.onFrame(onFrame);
+    radar.attachBlackBox(&g_blackBox);
+    g_blackBox.onFlush(onFlush);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> faultPick(0, 999);
+    const uint64_t periodUs = (uint64_t)(1e6 / rateHz);
+    const uint64_t startUs = hostMicros64();
+    uint64_t endUs = startUs + (uint64_t)(days * US_PER_DAY);
+    const uint64_t longSilenceAt = startUs + (endUs - startUs) / 2;
+    bool longSilenceDone = !longSilence;
+
+    uint64_t expectedFrames = 0;
+    uint64_t expectedErrors = 0;
+    uint64_t expectedFlushed = 0;
+    uint64_t triggers = 0;
+    uint64_t faults = 0;
+    uint64_t silences = 0;
+    uint64_t freezes = 0;
+    uint64_t updates = 0;
+    uint64_t maxUpdateNs = 0;
+    uint64_t dayMaxUpdateNs = 0;
+    uint64_t dayUpdates = 0;
+    uint64_t worstPercentileUs = 0;
+    uint64_t nextDayUs = startUs + US_PER_DAY;
+    uint64_t nextTriggerUs = startUs + 3600ULL * 1000000ULL;
+    uint64_t wrapsSeen = 0;
+    uint32_t lastMillis = millis();
+    size_t frameIdx = 0;
+    size_t heapBaseline = 0;
+    bool heapSet = false;
+    bool connectedExpected = false;
+
+    // Step the clock, calling update() as a sketch loop would
+    auto runFor = [&](uint64_t us, uint64_t stepUs) {
+        uint64_t until = hostMicros64() + us;
+        while (hostMicros64() < until) {
+            hostAdvanceMicros(stepUs);
+            auto t0 = std::chrono::steady_clock::now();
+            radar.update();
+            g_blackBox.service();
+            auto t1 = std::chrono::steady_clock::now();
+            uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+            if (ns > dayMaxUpdateNs) dayMaxUpdateNs = ns;
+            uint64_t bucket = ns / 1000;
+            g_dayLatency[bucket < SOAK_LATENCY_BUCKETS ? bucket : SOAK_LATENCY_BUCKETS - 1]++;
+            dayUpdates++;
+            updates++;
+
+            uint32_t m = millis();
+            if (m < lastMillis) wrapsSeen++;
+            lastMillis = m;
+        }
+    };
+
+    auto dayNow = [&]() { return (double)(hostMicros64() - startUs) / (double)US_PER_DAY; };
+
+    auto silence = [&](uint64_t us, uint64_t stepUs) {
+        runFor(us, stepUs);
+        silences++;
+        if (radar.isConnected()) fail("isConnected() true after silence", dayNow());
+        connectedExpected = false;
+    };
+
+    printf("RD03D soak: %.1f days at %.1f Hz, start millis %llu, latency bound %llu us at p%g\n",
+           days, rateHz, (unsigned long long)startMs, (unsigned long long)maxLatencyUs, percentile);
+
+    auto nonEmpty = [](const SimFrame& f) {
+        for (int i = RD03D_FRAME_HEADER_SIZE; i < RD03D_SIM_FRAME_SIZE - 2; i++) {
+            if (f.bytes[i] != 0) return true;
+        }
+        return false;
+    };
+
+    uint32_t frameBase = radar.getFrameCount();
+    uint32_t errorBase = radar.getErrorCount();
+
+    while (hostMicros64() < endUs) {
+        const SimFrame& f = frames[frameIdx];
+        frameIdx = (frameIdx + 1) % frames.size();
+
+        int fault = faultPick(rng);
+        if (fault == 0) {
+            // Corrupt tail: one error, no frame
+            uint8_t bad[RD03D_SIM_FRAME_SIZE];
+            memcpy(bad, f.bytes, sizeof(bad));
+            bad[29] ^= 0xFF;
+            port.hostInject(bad, sizeof(bad));
+            expectedErrors++;
+            faults++;
+        } else if (fault == 1) {
+            // Truncated frame then a gap: timeout error
+            port.hostInject(f.bytes, 15);
+            runFor(periodUs, periodUs);
+            runFor(RD03D_DEFAULT_TIMEOUT * US_PER_MS + periodUs, periodUs);
+            expectedErrors++;
+            faults++;
+            continue;
+        } else if (fault == 2) {
+            // Line noise without header bytes is skipped silently
+            uint8_t noise[16];
+            for (uint8_t& b : noise) b = (uint8_t)(rng() % 0xA0);
+            port.hostInject(noise, sizeof(noise));
+            port.hostInject(f.bytes, sizeof(f.bytes));
+            expectedFrames++;
+            faults++;
+        } else if (fault == 3 && faultPick(rng) < 50) {
+            // Short silence (radar glitch / power dip)
+            silence(5ULL * 1000000ULL, 10000);
+            continue;
+        } else if (fault == 4 && faultPick(rng) < 50 && nonEmpty(f)) {
+            // Frozen sensor: the same frame repeated past the timeout
+            uint64_t repeats = (RD03D_FROZEN_TIMEOUT + 1000ULL) * US_PER_MS / periodUs;
+            for (uint64_t i = 0; i < repeats; i++) {
+                port.hostInject(f.bytes, sizeof(f.bytes));
+                expectedFrames++;
+                runFor(periodUs, periodUs);
+            }
+            if (!radar.isFrozen()) fail("isFrozen() missed a frozen sensor", dayNow());
+            freezes++;
+            faults++;
+            continue;
+        } else {
+            port.hostInject(f.bytes, sizeof(f.bytes));
+            expectedFrames++;
+        }
+
+        runFor(periodUs, periodUs);
+
+        // A corrupt frame delivers nothing, so a freeze just before it still stands
+        if (fault != 1 && fault != 0) {
+            if (!radar.isConnected()) fail("isConnected() false while streaming", dayNow());
+            if (radar.isFrozen()) fail("isFrozen() true on a live sensor", dayNow());
+            connectedExpected = true;
+        }
+
+        // Tracks must stay sane
+        for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+            RD03D_Track* t = g_tracker.getTrack(i);
+            if (!t->active) continue;
+            if (t->id == 0 || !isfinite(t->x) || !isfinite(t->y) || !isfinite(t->vx) || !isfinite(t->vy)) {
+                fail("insane track state", dayNow());
+            }
+        }
+
+        // Hourly black-box trigger; the previous one must have flushed by now
+        if (hostMicros64() >= nextTriggerUs) {
+            nextTriggerUs += 3600ULL * 1000000ULL;
+            if (g_blackBox.getState() != RD03D_BB_ARMED) fail("black box still busy after an hour", dayNow());
+            if (g_blackBox.trigger(RD03D_TRIGGER_MANUAL)) {
+                triggers++;
+                expectedFlushed += (g_blackBox.getCount() + SOAK_POST_TRIGGER > SOAK_BLACKBOX_FRAMES)
+                                   ? SOAK_BLACKBOX_FRAMES
+                                   : g_blackBox.getCount() + SOAK_POST_TRIGGER;
+            }
+        }
+
+        // Silence longer than the millis() wrap
+        if (!longSilenceDone && hostMicros64() >= longSilenceAt) {
+            longSilenceDone = true;
+            printf("Long silence: %.1f days from day %.2f\n", (double)(MILLIS_WRAP_US + 30ULL * 1000000ULL) / US_PER_DAY, dayNow());
+            silence(MILLIS_WRAP_US + 30ULL * 1000000ULL, 100000);
+            endUs += MILLIS_WRAP_US + 30ULL * 1000000ULL;
+            nextTriggerUs = hostMicros64() + 3600ULL * 1000000ULL;
+            nextDayUs = hostMicros64() + US_PER_DAY;
+        }
+
+        // Daily checkpoint
+        if (hostMicros64() >= nextDayUs) {
+            nextDayUs += US_PER_DAY;
+
+            uint32_t gotFrames = radar.getFrameCount() - frameBase;
+            uint32_t gotErrors = radar.getErrorCount() - errorBase;
+            if (gotFrames != (uint32_t)expectedFrames) fail("frame count mismatch", dayNow());
+            if (gotErrors != (uint32_t)expectedErrors) fail("error count mismatch", dayNow());
+
+            size_t heap = heapInUse();
+            if (!heapSet) {
+                heapBaseline = heap;
+                heapSet = true;
+            } else if (heap > heapBaseline) {
+                fail("heap grew", dayNow());
+            }
+
+            // Gate on the percentile; the maximum includes host preemption
+            uint64_t pUs = latencyPercentileUs(g_dayLatency, dayUpdates, percentile);
+            if (pUs > worstPercentileUs) worstPercentileUs = pUs;
+            if (dayMaxUpdateNs > maxUpdateNs) maxUpdateNs = dayMaxUpdateNs;
+            if (pUs > maxLatencyUs) fail("update() percentile exceeded latency bound", dayNow());
+
+            printf("day %6.2f  millis %10lu  frames %10lu  errors %6lu  tracks %u  flushed %8llu  "
+                   "heap blocks %zu  p%g update <%llu us  max %6.1f us\n",
+                   dayNow(), (unsigned long)millis(), (unsigned long)gotFrames, (unsigned long)gotErrors,
+                   g_tracker.getTrackCount(), (unsigned long long)g_flushed, heap, percentile,
+                   (unsigned long long)pUs, dayMaxUpdateNs / 1000.0);
+            fflush(stdout);
+            dayMaxUpdateNs = 0;
+            dayUpdates = 0;
+            memset(g_dayLatency, 0, sizeof(g_dayLatency));
+        }
+    }
+
+    // Stream long enough for the last trigger to capture and flush
+    for (int i = 0; i < 4 * SOAK_POST_TRIGGER; i++) {
+        port.hostInject(frames[frameIdx].bytes, RD03D_SIM_FRAME_SIZE);
+        frameIdx = (frameIdx + 1) % frames.size();
+        runFor(periodUs, periodUs);
+    }
+    runFor(10ULL * 1000000ULL, periodUs);
+    if (g_flushed != expectedFlushed) fail("black-box flushed entry count mismatch", dayNow());
+    if (connectedExpected && radar.isConnected()) fail("isConnected() true after final silence", dayNow());
+    if (wrapsSeen == 0) fail("run did not cross a millis() wrap", dayNow());
+    if (radar.getFrozenCount() != freezes) fail("frozen count mismatch", dayNow());
+
+    printf("\n%llu updates, %llu frames, %llu injected faults, %llu silences, %llu freezes, %llu triggers, %llu millis() wraps\n",
+           (unsigned long long)updates, (unsigned long long)expectedFrames, (unsigned long long)faults,
+           (unsigned long long)silences, (unsigned long long)freezes, (unsigned long long)triggers,
+           (unsigned long long)wrapsSeen);
+    printf("Worst daily p%g update(): <%llu us (bound %llu us); wall-clock max %.1f us (information only)\n",
+           percentile, (unsigned long long)worstPercentileUs, (unsigned long long)maxLatencyUs, maxUpdateNs / 1000.0);
+    printf("%s (%llu failures)\n", g_failures ? "FAILED" : "PASSED", (unsigned long long)g_failures);
+    return g_failures ? 1 : 0;
+}
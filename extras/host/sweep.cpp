@@ -0,0 +1,322 @@
+/**
+ * @file sweep.cpp
+ * @brief Parallel parameter sweep for RD03D_Tracker tuning
+ *
+ * Decodes the input once (simulator scenes or captures, through the real
+ * RD03D parser) into one shared in-memory copy, then replays it through
+ * RD03D_Tracker for every combination in a parameter grid, spreading the
+ * configurations across all cores. Results are ranked by accuracy, with
+ * tracker cost (ns per frame) alongside.
+ *
+ * With simulator scenes, accuracy is CLEAR-MOT MOTA against ground truth.
+ * Captures have no ground truth, so they are ranked by proxy metrics:
+ * tracks started per minute (ID churn, lower is better), coverage of
+ * frames with detections, and jitter of confirmed tracks.
+ *
+ * Build: see extras/host/README.md (link with -pthread)
+ *
+ * Usage:
+ *   ./sweep [-g name=v1,v2,...] [-j threads] [-k top] [-o results.csv] [capture.bin ...]
+ *   Grid names: gate, coast, confirm, alpha, beta, range
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_Metrics.h"
+#include "RD03D_Replay.h"
+#include "RD03D_Sim.h"
+#include "RD03D_Tracker.h"
+
+#define SWEEP_FRAME_MS 50
+
+// ============== DATA SET ==============
+struct Sequence {
+    std::string name;
+    std::vector<ReplayFrame> frames;
+    std::vector<std::vector<SimTruth>> truth;   // Empty for captures
+};
+
+// ============== GRID ==============
+typedef std::map<std::string, std::vector<float>> Grid;
+
+static Grid defaultGrid() {
+    Grid g;
+    g["gate"] = {300, 450, 600, 800};
+    g["coast"] = {0, 2, 5, 8, 12};
+    g["confirm"] = {1, 2, 3};
+    g["alpha"] = {0.35f, 0.5f, 0.6f, 0.8f};
+    g["beta"] = {0.05f, 0.1f, 0.2f, 0.4f};
+    return g;
+}
+
+static bool applyParam(RD03D_TrackerConfig& c, const std::string& name, float v) {
+    if (name == "gate") c.gateMm = v;
+    else if (name == "coast") c.coastFrames = (uint8_t)v;
+    else if (name == "confirm") c.confirmFrames = (uint8_t)v;
+    else if (name == "alpha") c.alpha = v;
+    else if (name == "beta") c.beta = v;
+    else if (name == "range") c.maxRangeCm = v;
+    else return false;
+    return true;
+}
+
+static std::vector<RD03D_TrackerConfig> expandGrid(const Grid& grid) {
+    std::vector<RD03D_TrackerConfig> configs(1);
+    configs[0].setDefaults();
+    for (const auto& axis : grid) {
+        std::vector<RD03D_TrackerConfig> next;
+        for (const RD03D_TrackerConfig& base : configs) {
+            for (float v : axis.second) {
+                RD03D_TrackerConfig c = base;
+                applyParam(c, axis.first, v);
+                next.push_back(c);
+            }
+        }
+        configs.swap(next);
+    }
+    return configs;
+}
+
+// ============== EVALUATION ==============
+struct Result {
+    RD03D_TrackerConfig config;
+    double score = 0.0;       // Higher is better
+    double mota = 0.0;
+    double rmse = 0.0;
+    uint64_t idSwitches = 0;
+    double churnPerMin = 0.0;
+    double coverage = 0.0;
+    double jitterMm = 0.0;
+    double nsPerFrame = 0.0;
+};
+
+static Result evaluate(const RD03D_TrackerConfig& config, const std::vector<Sequence>& data) {
+    Result r;
+    r.config = config;
+    MotAccumulator mot;   // Summed over sequences
+    bool hasTruth = false;
+    uint64_t frames = 0, framesWithDetections = 0, coveredFrames = 0, tracksStarted = 0;
+    double jitterSq = 0.0;
+    uint64_t jitterN = 0;
+    uint64_t trackerNs = 0;
+
+    for (const Sequence& seq : data) {
+        RD03D_Tracker tracker;
+        tracker.setConfig(config);
+        uint16_t lastId[RD03D_MAX_TRACKS] = {0};
+        float prev[RD03D_MAX_TRACKS][2][2] = {};   // Last two positions per slot
+        uint16_t history[RD03D_MAX_TRACKS] = {0};
+        std::vector<MotHypothesis> hyps;
+        // Truth and track IDs restart with each sequence
+        MotAccumulator seqMot;
+
+        for (size_t k = 0; k < seq.frames.size(); k++) {
+            const ReplayFrame& f = seq.frames[k];
+            auto t0 = std::chrono::steady_clock::now();
+            tracker.update(f.targets, (uint32_t)(k * SWEEP_FRAME_MS));
+            auto t1 = std::chrono::steady_clock::now();
+            trackerNs += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+            frames++;
+
+            hyps.clear();
+            for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+                RD03D_Track* t = tracker.getTrack(i);
+                if (!t->active) {
+                    history[i] = 0;
+                    continue;
+                }
+                if (t->id != lastId[i]) {
+                    lastId[i] = t->id;
+                    tracksStarted++;
+                    history[i] = 0;
+                }
+                if (!t->isValid()) continue;
+                hyps.push_back({t->id, t->x, t->y});
+
+                // Jitter: second difference of the filtered position
+                if (history[i] >= 2) {
+                    double ax = t->x - 2 * prev[i][1][0] + prev[i][0][0];
+                    double ay = t->y - 2 * prev[i][1][1] + prev[i][0][1];
+                    jitterSq += ax * ax + ay * ay;
+                    jitterN++;
+                }
+                prev[i][0][0] = prev[i][1][0];
+                prev[i][0][1] = prev[i][1][1];
+                prev[i][1][0] = t->x;
+                prev[i][1][1] = t->y;
+                if (history[i] < 2) history[i]++;
+            }
+
+            if (f.count > 0) {
+                framesWithDetections++;
+                if (!hyps.empty()) coveredFrames++;
+            }
+            if (!seq.truth.empty()) {
+                hasTruth = true;
+                seqMot.addFrame(seq.truth[k], hyps);
+            }
+        }
+        mot.merge(seqMot);
+    }
+
+    double minutes = frames * SWEEP_FRAME_MS / 60000.0;
+    r.churnPerMin = minutes > 0 ? tracksStarted / minutes : 0.0;
+    r.coverage = framesWithDetections ? (double)coveredFrames / framesWithDetections : 1.0;
+    r.jitterMm = jitterN ? sqrt(jitterSq / jitterN) : 0.0;
+    r.nsPerFrame = frames ? (double)trackerNs / frames : 0.0;
+
+    if (hasTruth) {
+        r.mota = mot.mota();
+        r.rmse = mot.rmse();
+        r.idSwitches = mot.idSwitches;
+        r.score = r.mota - r.rmse * 1e-4;   // RMSE only breaks near-ties
+    } else {
+        // Proxy: keep frames covered, penalise churn and jitter
+        r.score = r.coverage - 0.01 * r.churnPerMin - 0.001 * r.jitterMm;
+    }
+    return r;
+}
+
+// ============== MAIN ==============
+int main(int argc, char** argv) {
+    Grid grid;
+    int threads = (int)std::thread::hardware_concurrency();
+    int top = 15;
+    std::string csvPath;
+    std::vector<std::string> captures;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (a == "-g" && hasValue) {
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            if (eq == std::string::npos) {
+                fprintf(stderr, "Bad grid spec: %s\n", spec.c_str());
+                return 1;
+            }
+            std::string name = spec.substr(0, eq);
+            RD03D_TrackerConfig probe;
+            if (!applyParam(probe, name, 0)) {
+                fprintf(stderr, "Unknown parameter: %s\n", name.c_str());
+                return 1;
+            }
+            std::vector<float>& values = grid[name];
+            values.clear();
+            std::string list = spec.substr(eq + 1);
+            char* save = nullptr;
+            for (char* tok = strtok_r(&list[0], ",", &save); tok; tok = strtok_r(nullptr, ",", &save)) {
+                values.push_back((float)atof(tok));
+            }
+        } else if (a == "-j" && hasValue) threads = atoi(argv[++i]);
+        else if (a == "-k" && hasValue) top = atoi(argv[++i]);
+        else if (a == "-o" && hasValue) csvPath = argv[++i];
+        else if (a[0] == '-') {
+            fprintf(stderr, "usage: sweep [-g name=v1,v2,...] [-j threads] [-k top] [-o results.csv] [capture.bin ...]\n");
+            return 1;
+        } else captures.push_back(a);
+    }
+    if (grid.empty()) grid = defaultGrid();
+    if (threads < 1) threads = 1;
+
+    // Decode once; every configuration shares this copy
+    auto d0 = std::chrono::steady_clock::now();
+    std::vector<Sequence> data;
+    for (const std::string& path : captures) {
+        std::vector<uint8_t> bytes;
+        if (!replayLoadFile(path, bytes)) {
+            fprintf(stderr, "Cannot read %s\n", path.c_str());
+            return 1;
+        }
+        data.push_back({path, replayDecode(bytes), {}});
+    }
+    if (data.empty()) {
+        SimRadarModel model;
+        for (const SimScene& scene : rd03dSimScenes()) {
+            RD03D_Sim sim(scene, model, 1);
+            std::vector<SimFrame> frames = sim.run(1000.0 / SWEEP_FRAME_MS);
+            Sequence seq;
+            seq.name = scene.name;
+            seq.frames = replayDecode(replaySimBytes(frames));
+            for (const SimFrame& f : frames) seq.truth.push_back(f.truth);
+            if (seq.frames.size() != seq.truth.size()) {
+                fprintf(stderr, "Decoded frame count mismatch in %s\n", scene.name.c_str());
+                return 1;
+            }
+            data.push_back(seq);
+        }
+    }
+    size_t totalFrames = 0;
+    for (const Sequence& s : data) totalFrames += s.frames.size();
+    double decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - d0).count();
+
+    std::vector<RD03D_TrackerConfig> configs = expandGrid(grid);
+    printf("Decoded %zu sequences, %zu frames once in %.1f ms\n", data.size(), totalFrames, decodeMs);
+    printf("Sweeping %zu configurations on %d threads (%s)\n\n", configs.size(), threads,
+           data[0].truth.empty() ? "proxy metrics, no ground truth" : "MOTA vs ground truth");
+
+    // Work-stealing over a shared index
+    std::vector<Result> results(configs.size());
+    std::atomic<size_t> nextIdx(0);
+    auto s0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&]() {
+            size_t i;
+            while ((i = nextIdx++) < configs.size()) {
+                results[i] = evaluate(configs[i], data);
+            }
+        });
+    }
+    for (std::thread& t : pool) t.join();
+    double sweepS = std::chrono::duration<double>(std::chrono::steady_clock::now() - s0).count();
+
+    std::sort(results.begin(), results.end(), [](const Result& a, const Result& b) {
+        return a.score != b.score ? a.score > b.score : a.nsPerFrame < b.nsPerFrame;
+    });
+
+    printf("%4s %6s %5s %7s %5s %5s %8s %5s %8s %8s %7s %8s %8s\n",
+           "rank", "gate", "coast", "confirm", "alpha", "beta", "MOTA", "IDSW", "RMSE mm",
+           "churn/m", "cover", "jitter", "ns/frame");
+    for (int i = 0; i < top && i < (int)results.size(); i++) {
+        const Result& r = results[i];
+        printf("%4d %6.0f %5u %7u %5.2f %5.2f %8.4f %5llu %8.1f %8.1f %7.3f %8.1f %8.0f\n",
+               i + 1, r.config.gateMm, r.config.coastFrames, r.config.confirmFrames,
+               r.config.alpha, r.config.beta, r.mota, (unsigned long long)r.idSwitches, r.rmse,
+               r.churnPerMin, r.coverage, r.jitterMm, r.nsPerFrame);
+    }
+    printf("\n%.2f s sweep, %.0f configuration-frames/s\n", sweepS,
+           configs.size() * (double)totalFrames / sweepS);
+
+    if (!csvPath.empty()) {
+        FILE* f = fopen(csvPath.c_str(), "w");
+        if (!f) {
+            fprintf(stderr, "Cannot write %s\n", csvPath.c_str());
+            return 1;
+        }
+        fprintf(f, "rank,gate,coast,confirm,alpha,beta,range,score,mota,idsw,rmse,churn_per_min,coverage,jitter,ns_per_frame\n");
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            fprintf(f, "%zu,%.0f,%u,%u,%.3f,%.3f,%.0f,%.6f,%.6f,%llu,%.2f,%.3f,%.4f,%.2f,%.1f\n",
+                    i + 1, r.config.gateMm, r.config.coastFrames, r.config.confirmFrames,
+                    r.config.alpha, r.config.beta, r.config.maxRangeCm, r.score, r.mota,
+                    (unsigned long long)r.idSwitches, r.rmse, r.churnPerMin, r.coverage,
+                    r.jitterMm, r.nsPerFrame);
+        }
+        fclose(f);
+        printf("Wrote %s\n", csvPath.c_str());
+    }
+    return 0;
+}
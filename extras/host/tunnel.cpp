@@ -0,0 +1,491 @@
+/**
+ * @file tunnel.cpp
+ * @brief Central parser for nodes that tunnel raw radar bytes over UDP
+ *
+ * Listens for RD03D_Tunnel datagrams and feeds each sensor's bytes into
+ * its own RD03D parser through RD03D_TunnelReceiver, as if every radar
+ * were a local tty. Decoded frames are printed in the MultiTargetCallback
+ * CSV format prefixed with the sensor id, or written to one CSV per
+ * sensor with -o (readable by calibrate and sweep). Timestamps are the
+ * node's arrival time of the frame's last bytes, in ms.
+ *
+ * --pty also creates a pseudo terminal per sensor carrying the raw byte
+ * stream, so tools written for a serial port can open it instead.
+ *
+ * Lost, late and invalid datagrams, sender restarts, parse errors and
+ * delivery jitter (spread of host receive time minus node arrival time)
+ * are reported per sensor every few seconds.
+ *
+ * --check runs simulator scenes through a node (RD03D + RD03D_Tunnel,
+ * forwarding only) over loopback UDP into the receiver, once clean, once
+ * with datagram loss and a node restart, and once with a restart after
+ * a thousand datagrams whose first datagram is lost, and compares the
+ * frames with decoding the bytes locally.
+ *
+ * Build: see extras/host/README.md (needs -pthread)
+ *
+ * Usage:
+ *   ./tunnel [-p port] [-o dir] [--pty] [-q] [-s seconds]
+ *   ./tunnel --check
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "RD03D.h"
+#include "RD03D_Replay.h"
+#include "RD03D_Sim.h"
+#include "RD03D_Tunnel.h"
+
+// ============== SETTINGS ==============
+struct TunnelOptions {
+    int port = 9000;
+    std::string outDir;
+    bool pty = false;
+    bool quiet = false;
+    int statsSeconds = 10;
+};
+
+// ============== SENSORS ==============
+struct TunnelSensor {
+    uint16_t id = 0;
+    RD03D radar;
+    RD03D_TunnelReceiver receiver;
+    FILE* csv = nullptr;
+    int ptyMaster = -1;
+    int ptySlave = -1;          // Held open so writes never fail for want of a reader
+    uint64_t frames = 0;
+    uint64_t ptyDropped = 0;
+    bool jitterValid = false;   // Delay spread over the current stats interval
+    uint32_t minDelay = 0;
+    uint32_t maxDelay = 0;
+};
+
+static TunnelOptions g_opt;
+static std::map<uint16_t, std::unique_ptr<TunnelSensor>> g_sensors;
+static TunnelSensor* g_current = nullptr;       // Sensor whose datagram is being fed
+
+static void printFrame(FILE* out, const TunnelSensor& s, RD03D_Target* targets, uint8_t count) {
+    if (out == stdout) fprintf(out, "%u,", s.id);
+    fprintf(out, "%u,%u", (unsigned)(s.receiver.getArrivalMicros() / 1000), count);
+    for (int i = 0; i < RD03D_MAX_TARGETS; i++) {
+        const RD03D_Target& t = targets[i];
+        if (t.valid) {
+            fprintf(out, ",%d,%d,%.1f,%.1f,%d", t.x, t.y, t.distance, t.angle, t.speed);
+        } else {
+            fprintf(out, ",0,0,0,0,0");
+        }
+    }
+    fprintf(out, "\n");
+}
+
+static void onSensorFrame(RD03D_Target* targets, uint8_t count) {
+    TunnelSensor* s = g_current;
+    s->frames++;
+    if (s->csv) {
+        printFrame(s->csv, *s, targets, count);
+    } else if (!g_opt.quiet) {
+        printFrame(stdout, *s, targets, count);
+    }
+}
+
+static bool openPty(TunnelSensor& s) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) return false;
+    const char* name = ptsname(master);
+    int slave = name ? open(name, O_RDWR | O_NOCTTY) : -1;
+    if (slave < 0) {
+        close(master);
+        return false;
+    }
+
+    // Raw bytes, exactly as a radar tty at 256000 baud would deliver them
+    termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+    s.ptyMaster = master;
+    s.ptySlave = slave;
+    fprintf(stderr, "sensor %u: %s\n", s.id, name);
+    return true;
+}
+
+static TunnelSensor* sensorFor(uint16_t id) {
+    std::unique_ptr<TunnelSensor>& slot = g_sensors[id];
+    if (slot) return slot.get();
+
+    slot.reset(new TunnelSensor());
+    TunnelSensor* s = slot.get();
+    s->id = id;
+    s->radar.onFrame(onSensorFrame);
+    s->radar.setOverloadControl(false);   // Every tunnelled frame reaches the CSV
+    if (!g_opt.outDir.empty()) {
+        std::string path = g_opt.outDir + "/sensor_" + std::to_string(id) + ".csv";
+        s->csv = fopen(path.c_str(), "w");
+        if (!s->csv) fprintf(stderr, "Cannot write %s\n", path.c_str());
+    }
+    if (g_opt.pty && !openPty(*s)) fprintf(stderr, "sensor %u: cannot create pty\n", id);
+    fprintf(stderr, "sensor %u: first datagram\n", id);
+    return s;
+}
+
+static void forwardToPty(TunnelSensor& s, const uint8_t* datagram, size_t len) {
+    RD03D_TunnelHeader h;
+    RD03D_TunnelReceiver::parseHeader(datagram, len, &h);
+    size_t pos = sizeof(h);
+    for (uint16_t i = 0; i < h.records; i++) {
+        size_t n = datagram[pos + 2] | (datagram[pos + 3] << 8);
+        pos += RD03D_TUNNEL_RECORD_SIZE;
+        ssize_t w = write(s.ptyMaster, datagram + pos, n);
+        if (w < (ssize_t)n) s.ptyDropped += n - (w > 0 ? w : 0);
+        pos += n;
+    }
+}
+
+/**
+ * @brief Handle one datagram; returns the receiver's verdict
+ */
+static RD03D_TunnelResult handleDatagram(const uint8_t* datagram, size_t len, uint32_t hostMicros) {
+    RD03D_TunnelHeader h;
+    if (!RD03D_TunnelReceiver::parseHeader(datagram, len, &h)) return RD03D_TUNNEL_INVALID;
+
+    TunnelSensor* s = sensorFor(h.sensorId);
+    g_current = s;
+    RD03D_TunnelResult result = s->receiver.receive(datagram, len, s->radar);
+    g_current = nullptr;
+    if (result == RD03D_TUNNEL_LATE || result == RD03D_TUNNEL_INVALID) return result;
+
+    if (s->ptyMaster >= 0) forwardToPty(*s, datagram, len);
+
+    // Clock offset is unknown; the spread of (receive - arrival) is the jitter
+    uint32_t delay = hostMicros - h.baseMicros;
+    if (!s->jitterValid || (int32_t)(delay - s->minDelay) < 0) s->minDelay = delay;
+    if (!s->jitterValid || (int32_t)(delay - s->maxDelay) > 0) s->maxDelay = delay;
+    s->jitterValid = true;
+    return result;
+}
+
+static void printStats() {
+    for (auto& it : g_sensors) {
+        TunnelSensor& s = *it.second;
+        const RD03D_TunnelReceiver& r = s.receiver;
+        fprintf(stderr, "sensor %u: %u datagrams, %u lost, %u late, %u restarts, %llu frames, "
+                        "%u parse errors, jitter %.1f ms",
+                s.id, (unsigned)r.getReceivedCount(), (unsigned)r.getLostCount(),
+                (unsigned)r.getLateCount(), (unsigned)r.getRestartCount(),
+                (unsigned long long)s.frames, (unsigned)s.radar.getErrorCount(),
+                s.jitterValid ? (s.maxDelay - s.minDelay) / 1000.0 : 0.0);
+        if (s.ptyDropped > 0) fprintf(stderr, ", %llu pty bytes dropped", (unsigned long long)s.ptyDropped);
+        fprintf(stderr, "\n");
+        s.jitterValid = false;
+        if (s.csv) fflush(s.csv);
+    }
+    fflush(stdout);
+}
+
+static int runDaemon() {
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) {
+        perror("socket");
+        return 1;
+    }
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(g_opt.port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(sock, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        perror("bind");
+        return 1;
+    }
+    timeval tv = {1, 0};
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    fprintf(stderr, "Listening on UDP port %d\n", g_opt.port);
+
+    uint32_t invalid = 0;
+    uint32_t lastStats = millis();
+    uint8_t datagram[65536];
+    for (;;) {
+        ssize_t n = recv(sock, datagram, sizeof(datagram), 0);
+        if (n > 0 && handleDatagram(datagram, (size_t)n, micros()) == RD03D_TUNNEL_INVALID) {
+            if (invalid++ == 0) fprintf(stderr, "Ignoring datagrams that are not tunnel datagrams\n");
+        }
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            perror("recv");
+            return 1;
+        }
+        if (millis() - lastStats >= (uint32_t)g_opt.statsSeconds * 1000) {
+            lastStats = millis();
+            printStats();
+        }
+    }
+}
+
+// ============== SELF-CHECK ==============
+static int g_checkSock = -1;
+static sockaddr_in g_checkDest;
+static uint32_t g_checkSends = 0;
+static uint32_t g_checkDropEvery = 0;   // Lose every n-th datagram (0 = none)
+static uint32_t g_checkLost = 0;
+static bool g_checkDropNext = false;    // Lose the next datagram
+static std::vector<ReplayFrame>* g_checkFrames = nullptr;
+
+static bool checkSend(const uint8_t* datagram, size_t len) {
+    g_checkSends++;
+    if (g_checkDropNext || (g_checkDropEvery > 0 && g_checkSends % g_checkDropEvery == 0)) {
+        g_checkDropNext = false;
+        g_checkLost++;      // Lost on the network: the node thinks it was sent
+        return true;
+    }
+    return sendto(g_checkSock, datagram, len, 0, (sockaddr*)&g_checkDest, sizeof(g_checkDest)) == (ssize_t)len;
+}
+
+static void checkOnFrame(RD03D_Target* targets, uint8_t count) {
+    ReplayFrame f;
+    for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) f.targets[i] = targets[i];
+    f.count = count;
+    g_checkFrames->push_back(f);
+}
+
+static void checkNoFrame(RD03D_Target*, uint8_t) {}
+
+static bool sameFrame(const ReplayFrame& a, const ReplayFrame& b) {
+    if (a.count != b.count) return false;
+    for (int i = 0; i < RD03D_MAX_TARGETS; i++) {
+        const RD03D_Target& p = a.targets[i];
+        const RD03D_Target& q = b.targets[i];
+        if (p.valid != q.valid || p.x != q.x || p.y != q.y || p.speed != q.speed) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Count frames that appear, in order, in the reference
+ * @return Number matched; equal to frames.size() if none are damaged
+ */
+static size_t matchFrames(const std::vector<ReplayFrame>& frames, const std::vector<ReplayFrame>& reference) {
+    size_t matched = 0;
+    size_t r = 0;
+    for (const ReplayFrame& f : frames) {
+        while (r < reference.size() && !sameFrame(reference[r], f)) r++;
+        if (r == reference.size()) break;
+        matched++;
+        r++;
+    }
+    return matched;
+}
+
+struct CheckRun {
+    std::vector<ReplayFrame> frames;
+    uint32_t datagrams = 0;
+    uint32_t lost = 0;
+    uint32_t restarts = 0;
+    uint32_t late = 0;
+    double nodeNsPerByte = 0.0;
+};
+
+/**
+ * @brief Stream bytes through a forwarding node and the receiver
+ * @param restartAt Byte offset at which the node reboots (0 = never)
+ * @param dropFirst Lose the first datagram after the reboot
+ */
+static CheckRun runThrough(const std::vector<uint8_t>& bytes, int rxSock, uint32_t dropEvery,
+                           size_t restartAt, bool dropFirst = false) {
+    CheckRun run;
+    g_checkSends = 0;
+    g_checkLost = 0;
+    g_checkDropEvery = dropEvery;
+    g_checkDropNext = false;
+
+    HardwareSerial port;
+    RD03D node;
+    node.begin(port, -1, -1);
+    node.onFrame(checkNoFrame);
+    std::unique_ptr<RD03D_Tunnel> tunnel(new RD03D_Tunnel(7));
+    tunnel->onSend(checkSend);
+    node.attachTunnel(tunnel.get());
+
+    RD03D central;
+    RD03D_TunnelReceiver receiver;
+    g_checkFrames = &run.frames;
+    central.onFrame(checkOnFrame);
+    central.setOverloadControl(false);
+
+    // 16 bytes every 625 us: the radar's 256000 baud
+    const size_t piece = 16;
+    double nodeNs = 0.0;
+    uint8_t datagram[RD03D_TUNNEL_DATAGRAM];
+    for (size_t pos = 0; pos < bytes.size(); pos += piece) {
+        if (restartAt > 0 && pos == restartAt) {
+            tunnel.reset(new RD03D_Tunnel(7));  // Pending bytes die with the old node
+            tunnel->onSend(checkSend);
+            node.attachTunnel(tunnel.get());
+            g_checkDropNext = dropFirst;
+        }
+        size_t n = std::min(piece, bytes.size() - pos);
+        port.hostInject(bytes.data() + pos, n);
+        hostAdvanceMicros(625);
+
+        auto t0 = std::chrono::steady_clock::now();
+        node.update();
+        nodeNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+
+        ssize_t got;
+        while ((got = recv(rxSock, datagram, sizeof(datagram), MSG_DONTWAIT)) > 0) {
+            receiver.receive(datagram, (size_t)got, central);
+        }
+    }
+    tunnel->flush();
+    usleep(10000);
+    ssize_t got;
+    while ((got = recv(rxSock, datagram, sizeof(datagram), MSG_DONTWAIT)) > 0) {
+        receiver.receive(datagram, (size_t)got, central);
+    }
+
+    g_checkFrames = nullptr;
+    run.datagrams = receiver.getReceivedCount();
+    run.lost = receiver.getLostCount();
+    run.restarts = receiver.getRestartCount();
+    run.late = receiver.getLateCount();
+    run.nodeNsPerByte = nodeNs / bytes.size();
+    return run;
+}
+
+/**
+ * @brief Node-side update() cost when parsing locally (callback does nothing)
+ */
+static double parseNsPerByte(const std::vector<uint8_t>& bytes) {
+    HardwareSerial port;
+    RD03D node;
+    node.begin(port, -1, -1);
+    node.onFrame(checkNoFrame);
+    double ns = 0.0;
+    for (size_t pos = 0; pos < bytes.size(); pos += 16) {
+        port.hostInject(bytes.data() + pos, std::min((size_t)16, bytes.size() - pos));
+        hostAdvanceMicros(625);
+        auto t0 = std::chrono::steady_clock::now();
+        node.update();
+        ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    }
+    return ns / bytes.size();
+}
+
+static int runCheck() {
+    hostUseVirtualClock(true);
+    hostSetMicros(1000000);
+
+    // Simulator scenes with a little line noise between them
+    std::vector<uint8_t> bytes;
+    uint32_t seed = 1;
+    for (const SimScene& scene : rd03dSimScenes()) {
+        RD03D_Sim sim(scene, SimRadarModel(), seed++);
+        std::vector<uint8_t> b = replaySimBytes(sim.run(10.0));
+        bytes.insert(bytes.end(), b.begin(), b.end());
+        static const uint8_t noise[7] = {0xAA, 0x13, 0xFF, 0x03, 0x55, 0xCC, 0x00};
+        bytes.insert(bytes.end(), noise, noise + sizeof(noise));
+    }
+    std::vector<ReplayFrame> reference = replayDecode(bytes);
+    hostUseVirtualClock(true);
+
+    int rxSock = socket(AF_INET, SOCK_DGRAM, 0);
+    g_checkSock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int bufSize = 4 << 20;
+    setsockopt(rxSock, SOL_SOCKET, SO_RCVBUF, &bufSize, sizeof(bufSize));
+    socklen_t addrLen = sizeof(addr);
+    if (rxSock < 0 || g_checkSock < 0 || bind(rxSock, (sockaddr*)&addr, sizeof(addr)) != 0 ||
+        getsockname(rxSock, (sockaddr*)&addr, &addrLen) != 0) {
+        perror("socket");
+        return 1;
+    }
+    g_checkDest = addr;
+
+    printf("%zu bytes, %zu frames decoded locally\n", bytes.size(), reference.size());
+    bool ok = true;
+
+    // Clean link: every frame must come out identical
+    CheckRun clean = runThrough(bytes, rxSock, 0, 0);
+    bool same = clean.frames.size() == reference.size();
+    for (size_t i = 0; same && i < reference.size(); i++) {
+        same = sameFrame(clean.frames[i], reference[i]);
+    }
+    printf("clean:   %u datagrams, %zu frames, %s\n", clean.datagrams, clean.frames.size(),
+           same ? "identical to local decoding" : "DIFFERENT from local decoding");
+    ok = ok && same && clean.lost == 0 && clean.late == 0;
+
+    // Lossy link and a node restart: frames may be missing, never damaged
+    size_t restartAt = (bytes.size() / 2) & ~(size_t)15;
+    CheckRun lossy = runThrough(bytes, rxSock, 20, restartAt);
+    bool clean2 = matchFrames(lossy.frames, reference) == lossy.frames.size();
+    printf("lossy:   %u datagrams, %u lost (%u dropped), %u restart, %zu of %zu frames, %s\n",
+           lossy.datagrams, lossy.lost, g_checkLost, lossy.restarts, lossy.frames.size(),
+           reference.size(), clean2 ? "none damaged" : "DAMAGED frames delivered");
+    ok = ok && clean2 && lossy.restarts == 1 && lossy.lost + 1 >= g_checkLost;
+
+    // A reboot after a long run, whose first datagram (the only one with
+    // RD03D_TUNNEL_FLAG_FIRST) is lost: the new sequence is far behind
+    // the old one, and the receiver must follow it by its boot ID. Only
+    // the lost datagram and the bytes pending at the reboot may go missing
+    std::vector<uint8_t> longBytes;
+    for (int k = 0; k < 10; k++) longBytes.insert(longBytes.end(), bytes.begin(), bytes.end());
+    std::vector<ReplayFrame> longReference = replayDecode(longBytes);
+    hostUseVirtualClock(true);
+    size_t rebootAt = (longBytes.size() - 50 * RD03D_TUNNEL_DATAGRAM) & ~(size_t)15;
+    CheckRun reboot = runThrough(longBytes, rxSock, 0, rebootAt, true);
+    bool clean3 = matchFrames(reboot.frames, longReference) == reboot.frames.size();
+    size_t missing = longReference.size() - reboot.frames.size();
+    size_t allowed = 2 * RD03D_TUNNEL_DATAGRAM / RD03D_FRAME_SIZE + 2;
+    printf("reboot:  %u datagrams, %u lost, %u late, %u restart, %zu of %zu frames, %s\n",
+           reboot.datagrams, reboot.lost, reboot.late, reboot.restarts, reboot.frames.size(),
+           longReference.size(), clean3 ? "none damaged" : "DAMAGED frames delivered");
+    ok = ok && clean3 && reboot.restarts == 1 && reboot.late == 0 && reboot.lost == 1 && missing <= allowed;
+
+    double parseNs = parseNsPerByte(bytes);
+    printf("node update() cost: %.1f ns/byte parsing, %.1f ns/byte forwarding\n", parseNs, clean.nodeNsPerByte);
+
+    close(rxSock);
+    close(g_checkSock);
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--check") == 0) {
+            return runCheck();
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            g_opt.port = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            g_opt.outDir = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            g_opt.statsSeconds = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--pty") == 0) {
+            g_opt.pty = true;
+        } else if (strcmp(argv[i], "-q") == 0) {
+            g_opt.quiet = true;
+        } else {
+            fprintf(stderr, "usage: tunnel [-p port] [-o dir] [--pty] [-q] [-s seconds]\n"
+                            "       tunnel --check\n");
+            return 2;
+        }
+    }
+    return runDaemon();
+}
@@ -4,6 +4,11 @@
  */
 
 #include "RD03D.h"
+#include "RD03D_BlackBox.h"
+#include "RD03D_Config.h"
+#include "RD03D_Input.h"
+#include "RD03D_Tunnel.h"
+#include <string.h>
 
 // Frame header: AA FF 03 00
 const uint8_t RD03D::FRAME_HEADER[4] = {0xAA, 0xFF, 0x03, 0x00};
@@ -19,18 +24,53 @@ const uint8_t RD03D::MULTI_TARGET_CMD[12] = {
 RD03D::RD03D() {
     _serial = nullptr;
     _frameCallback = nullptr;
+    _frozenCallback = nullptr;
+    _blackBox = nullptr;
+    _tunnel = nullptr;
+    _tunnelParse = false;
+    _config = nullptr;
+    _pendingConfig = nullptr;
+    _configPending = false;
+    _configVersion = 0;
+    _configSwaps = 0;
     _frameIdx = 0;
     _syncIdx = 0;
     _parserState = RD03D_SYNC_HEADER;
     _lastByteTime = 0;
     _lastFrameTime = 0;
     _timeoutMs = RD03D_DEFAULT_TIMEOUT;
+    _frameFresh = false;
+    _backlog = 0;
+    _maxBacklog = 0;
     _frameCount = 0;
     _errorCount = 0;
+    _overloadControl = false;
+    _conflating = false;
+    _liveInput = false;
+    _pendingBytes = 0;
+    _lastLiveMicros = 0;
+    _lastLiveValid = false;
+    _frameInterval = 0;
+    _callbackMicros = 0;
+    _conflatedCount = 0;
+    _modeSwitches = 0;
+    _levelCallback = nullptr;
+    _idleTimeoutMs = 0;
+    _lastPresence = 0;
+    _idleDecimation = RD03D_IDLE_DECIMATION;
+    _idleFrame = 0;
+    _idle = false;
+    _idleSkipped = 0;
+    _payloadHash = 0;
+    _repeatStart = 0;
+    _frozenTimeoutMs = RD03D_FROZEN_TIMEOUT;
+    _frozen = false;
+    _frozenCount = 0;
     
     // Clear all targets
     for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
         _targets[i].clear();
+        _siteTargets[i].clear();
     }
 }
 
@@ -67,26 +107,132 @@ void RD03D::enableMultiTarget() {
 }
 
 void RD03D::update() {
-    if (!_serial) return;
+    update(0, 0);
+}
+
+bool RD03D::update(size_t maxBytes, uint32_t maxMicros) {
+    if (!_serial) return false;
+    
+    uint32_t start = micros();
+    checkTimeout();
+    
+    // Process available bytes in chunks, within the budget
+    uint8_t chunk[RD03D_READ_CHUNK];
+    size_t done = 0;
+    int available = _serial->available();
+    if ((size_t)available > _maxBacklog) _maxBacklog = available;
+    
+    _liveInput = true;
+    while (available > 0) {
+        size_t n = (available < RD03D_READ_CHUNK) ? available : RD03D_READ_CHUNK;
+        if (maxBytes > 0 && n > maxBytes - done) n = maxBytes - done;
+        n = _serial->read(chunk, n);
+        if (n == 0) break;
+        
+        if (_tunnel) _tunnel->write(chunk, n, start);
+        if (!_tunnel || _tunnelParse) feed(chunk, n);
+        done += n;
+        
+        if (maxBytes > 0 && done >= maxBytes) break;
+        if (maxMicros > 0 && micros() - start >= maxMicros) break;
+        available = _serial->available();
+    }
+    _liveInput = false;
+    
+    if (_tunnel) _tunnel->poll(micros());
+    
+    _backlog = _serial->available();
+    return _backlog > 0;
+}
+
+bool RD03D::update(RD03D_InputSource& source, size_t maxBytes, uint32_t maxMicros) {
+    uint32_t start = micros();
+    checkTimeout();
+    
+    RD03D_Span spans[2];
+    uint8_t count = source.peek(spans);
+    size_t available = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        available += spans[i].len;
+    }
+    if (available > _maxBacklog) _maxBacklog = available;
+    
+    // Decode straight from the source's buffer, span by span
+    size_t done = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        size_t len = spans[i].len;
+        if (maxBytes > 0 && len > maxBytes - done) len = maxBytes - done;
+        size_t queued = available - done - len;
+        
+        size_t n = len;
+        if (!_tunnel || _tunnelParse) n = parse(spans[i].data, len, queued, start, maxMicros);
+        if (_tunnel) _tunnel->write(spans[i].data, n, start);
+        source.consume(n);
+        done += n;
+        
+        if (n < len) break;
+        if (maxBytes > 0 && done >= maxBytes) break;
+        if (maxMicros > 0 && micros() - start >= maxMicros) break;
+    }
     
+    if (_tunnel) _tunnel->poll(micros());
+    
+    _backlog = source.available();
+    return _backlog > 0;
+}
+
+void RD03D::checkTimeout() {
     uint32_t now = millis();
     
-    // Check for frame timeout (partial frame stuck in buffer)
-    if (_parserState != RD03D_SYNC_HEADER && (now - _lastByteTime > _timeoutMs)) {
-        _errorCount++;
+    // Check for frame timeout (partial frame stuck in buffer). Skipped
+    // while a backlog is left over: those bytes are late, not missing
+    if (_backlog == 0 && _parserState != RD03D_SYNC_HEADER && (now - _lastByteTime > _timeoutMs)) {
+        reportError();
         resetParser();
     }
     
-    // Process all available bytes
-    while (_serial->available()) {
-        uint8_t b = _serial->read();
-        processByte(b);
+    // Latch staleness while the difference is still small, so a silence
+    // longer than the millis() wrap can't look like a fresh frame
+    isConnected();
+}
+
+void RD03D::feed(const uint8_t* data, size_t len) {
+    parse(data, len, 0, 0, 0);
+}
+
+size_t RD03D::parse(const uint8_t* data, size_t len, size_t queued, uint32_t start, uint32_t maxMicros) {
+    size_t i = 0;
+    while (i < len) {
+        if (_parserState == RD03D_SYNC_HEADER && _syncIdx == 0) {
+            // Skip noise up to the next possible header
+            const uint8_t* h = (const uint8_t*)memchr(data + i, FRAME_HEADER[0], len - i);
+            if (!h) {
+                i = len;
+                break;
+            }
+            i = h - data;
+            
+            // Whole frame in this span: decode it where it lies
+            if (len - i >= RD03D_FRAME_SIZE && memcmp(h, FRAME_HEADER, RD03D_FRAME_HEADER_SIZE) == 0) {
+                _pendingBytes = len - i - RD03D_FRAME_SIZE + queued;
+                completeFrame(h);
+                i += RD03D_FRAME_SIZE;
+                if (maxMicros > 0 && micros() - start >= maxMicros) break;
+                continue;
+            }
+        }
+        
+        // Frame split across spans or reads: stitch it in _frameBuf
+        _pendingBytes = len - i - 1 + queued;
+        processByte(data[i]);
+        i++;
     }
+    _pendingBytes = 0;
+    if (i > 0) _lastByteTime = millis();
+    return i;
 }
 
 void RD03D::processByte(uint8_t b) {
-    _lastByteTime = millis();
-    
     switch (_parserState) {
         case RD03D_SYNC_HEADER:
             // Look for header bytes AA FF 03 00
@@ -111,13 +257,7 @@ void RD03D::processByte(uint8_t b) {
             _frameBuf[_frameIdx++] = b;
             // Frame is 30 bytes: header(4) + 3*target(24) + tail(2)
             if (_frameIdx >= RD03D_FRAME_SIZE) {
-                // Check tail bytes
-                if (_frameBuf[28] == 0x55 && _frameBuf[29] == 0xCC) {
-                    processFrame();
-                } else {
-                    _errorCount++;
-                }
-                resetParser();
+                completeFrame(_frameBuf);
             }
             break;
             
@@ -127,6 +267,17 @@ void RD03D::processByte(uint8_t b) {
     }
 }
 
+void RD03D::completeFrame(const uint8_t* frame) {
+    // Check tail bytes
+    if (frame[28] == 0x55 && frame[29] == 0xCC) {
+        processFrame(frame);
+    } else {
+        if (_blackBox) _blackBox->record(frame, nullptr, millis());
+        reportError();
+    }
+    resetParser();
+}
+
 void RD03D::parseTarget(uint8_t index, const uint8_t* data) {
     if (index >= RD03D_MAX_TARGETS) return;
     
@@ -178,20 +329,146 @@ void RD03D::parseTarget(uint8_t index, const uint8_t* data) {
     t.angle = atan2f(x_mm, y_mm) * 180.0f / PI;
 }
 
-void RD03D::processFrame() {
+void RD03D::processFrame(const uint8_t* frame) {
+    // Swap in a staged config between frames, never part way through one
+    if (__atomic_load_n(&_configPending, __ATOMIC_ACQUIRE)) {
+        activateConfig(_pendingConfig);
+        _configSwaps++;
+        __atomic_store_n(&_configPending, false, __ATOMIC_RELEASE);
+    }
+    
+    bool wasFresh = isConnected();
     _frameCount++;
     _lastFrameTime = millis();
+    _frameFresh = true;
+    checkFrozen(frame, wasFresh);
     
     // Parse all 3 targets from the frame buffer
     // Target 1: bytes 4-11, Target 2: bytes 12-19, Target 3: bytes 20-27
-    parseTarget(0, &_frameBuf[4]);
-    parseTarget(1, &_frameBuf[12]);
-    parseTarget(2, &_frameBuf[20]);
+    parseTarget(0, &frame[4]);
+    parseTarget(1, &frame[12]);
+    parseTarget(2, &frame[20]);
+    
+    if (_blackBox) {
+        _blackBox->record(frame, _targets, _lastFrameTime);
+    }
+    
+    // Skip most empty frames while idle
+    bool deliver = updateLevel(getTargetCount());
     
     // Call user callback if set
-    if (_frameCallback) {
+    if (_frameCallback && deliverFrame() && deliver) {
+        uint32_t start = micros();
         _frameCallback(_targets, getTargetCount());
+        updateOverload(micros() - start);
+    }
+}
+
+bool RD03D::updateLevel(uint8_t count) {
+    if (count > 0) {
+        _lastPresence = _lastFrameTime;
+        if (_idle) {
+            _idle = false;
+            if (_levelCallback) _levelCallback(RD03D_LEVEL_FULL);
+        }
+        return true;
+    }
+    
+    if (!_idle) {
+        if (_idleTimeoutMs == 0 || _lastFrameTime - _lastPresence < _idleTimeoutMs) return true;
+        _idle = true;
+        _idleFrame = 0;
+        if (_levelCallback) _levelCallback(RD03D_LEVEL_IDLE);
+    }
+    
+    // Heartbeat: one empty frame in every _idleDecimation
+    if (++_idleFrame >= _idleDecimation) {
+        _idleFrame = 0;
+        return true;
+    }
+    _idleSkipped++;
+    return false;
+}
+
+bool RD03D::deliverFrame() {
+    // Only frames read live from the UART can be conflated; feed() and
+    // input sources carry no arrival timing to measure against
+    if (!_liveInput) return true;
+    
+    // Is a newer complete frame already waiting behind this one?
+    bool behind = _pendingBytes + _serial->available() >= RD03D_FRAME_SIZE;
+    
+    // Frame interval, sampled only between frames that arrived live
+    uint32_t now = micros();
+    if (!behind) {
+        if (_lastLiveValid) {
+            uint32_t interval = now - _lastLiveMicros;
+            if (_frameInterval == 0) {
+                if (interval < 1000000UL) _frameInterval = interval;
+            } else if (interval < _frameInterval * 4) {
+                _frameInterval += ((int32_t)interval - (int32_t)_frameInterval) / 8;
+            }
+        }
+        _lastLiveMicros = now;
+    }
+    _lastLiveValid = !behind;
+    
+    if (_conflating && behind) {
+        _conflatedCount++;
+        return false;
     }
+    return true;
+}
+
+void RD03D::updateOverload(uint32_t callbackMicros) {
+    if (_callbackMicros == 0) {
+        _callbackMicros = callbackMicros;
+    } else {
+        _callbackMicros += ((int32_t)callbackMicros - (int32_t)_callbackMicros) / 8;
+    }
+    if (!_overloadControl || !_liveInput || _frameInterval == 0) return;
+    
+    // Hysteresis between entering and leaving conflation
+    uint32_t load = (uint32_t)((uint64_t)_callbackMicros * 100 / _frameInterval);
+    bool conflate = _conflating ? (load >= RD03D_OVERLOAD_EXIT) : (load > RD03D_OVERLOAD_ENTER);
+    if (conflate != _conflating) {
+        _conflating = conflate;
+        _modeSwitches++;
+    }
+}
+
+void RD03D::checkFrozen(const uint8_t* frame, bool wasFresh) {
+    // FNV-1a over the 24 target bytes
+    uint32_t hash = 2166136261UL;
+    bool empty = true;
+    for (uint8_t i = RD03D_FRAME_HEADER_SIZE; i < RD03D_FRAME_SIZE - 2; i++) {
+        hash = (hash ^ frame[i]) * 16777619UL;
+        if (frame[i] != 0) empty = false;
+    }
+    
+    // A run only continues across consecutive, non-empty, identical
+    // frames; a silence in between starts over
+    bool repeat = !empty && wasFresh && hash == _payloadHash;
+    _payloadHash = hash;
+    
+    bool frozen = _frozen;
+    if (!repeat) {
+        _repeatStart = _lastFrameTime;
+        frozen = false;
+    } else if (_frozenTimeoutMs > 0 && _lastFrameTime - _repeatStart >= _frozenTimeoutMs) {
+        frozen = true;
+    }
+    
+    if (frozen != _frozen) {
+        _frozen = frozen;
+        if (frozen) _frozenCount++;
+        if (_frozenCallback) _frozenCallback(frozen);
+    }
+}
+
+void RD03D::resync() {
+    if (_parserState != RD03D_SYNC_HEADER) reportError();
+    resetParser();
 }
 
 void RD03D::resetParser() {
@@ -213,6 +490,18 @@ RD03D_Target* RD03D::getTargets() {
     return _targets;
 }
 
+RD03D_Target* RD03D::getSiteTargets() {
+    // Targets stay in the sensor frame so range and beam gating see the
+    // real geometry; the site view is built only when asked for
+    RD03D_Pose pose;
+    bool posed = _config && _config->getPose(pose);
+    for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+        _siteTargets[i] = _targets[i];
+        if (posed) pose.apply(_siteTargets[i]);
+    }
+    return _siteTargets;
+}
+
 uint8_t RD03D::getTargetCount() {
     uint8_t count = 0;
     for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
@@ -221,6 +510,14 @@ uint8_t RD03D::getTargetCount() {
     return count;
 }
 
+size_t RD03D::getBacklog() {
+    return _backlog;
+}
+
+size_t RD03D::getMaxBacklog() {
+    return _maxBacklog;
+}
+
 uint32_t RD03D::getFrameCount() {
     return _frameCount;
 }
@@ -234,5 +531,137 @@ void RD03D::setTimeout(uint16_t timeoutMs) {
 }
 
 bool RD03D::isConnected() {
-    return (millis() - _lastFrameTime) < 1000;
+    if (_frameFresh && (millis() - _lastFrameTime) >= RD03D_CONNECTED_WINDOW) {
+        _frameFresh = false;
+    }
+    return _frameFresh;
+}
+
+void RD03D::setOverloadControl(bool enabled) {
+    _overloadControl = enabled;
+    if (!enabled && _conflating) {
+        _conflating = false;
+        _modeSwitches++;
+    }
+}
+
+bool RD03D::isConflating() {
+    return _conflating;
+}
+
+uint32_t RD03D::getConflatedCount() {
+    return _conflatedCount;
+}
+
+uint32_t RD03D::getModeSwitchCount() {
+    return _modeSwitches;
+}
+
+uint32_t RD03D::getCallbackMicros() {
+    return _callbackMicros;
+}
+
+uint32_t RD03D::getFrameInterval() {
+    return _frameInterval;
+}
+
+void RD03D::setIdleTimeout(uint32_t timeoutMs) {
+    _idleTimeoutMs = timeoutMs;
+    _lastPresence = millis();
+    if (timeoutMs == 0 && _idle) {
+        _idle = false;
+        if (_levelCallback) _levelCallback(RD03D_LEVEL_FULL);
+    }
+}
+
+void RD03D::setIdleDecimation(uint8_t frames) {
+    _idleDecimation = (frames == 0) ? 1 : frames;
+}
+
+void RD03D::onLevelChange(RD03D_LevelCallback callback) {
+    _levelCallback = callback;
+}
+
+uint8_t RD03D::getLevel() {
+    return _idle ? RD03D_LEVEL_IDLE : RD03D_LEVEL_FULL;
+}
+
+bool RD03D::isIdle() {
+    return _idle;
+}
+
+uint32_t RD03D::getIdleSkippedCount() {
+    return _idleSkipped;
+}
+
+bool RD03D::isFrozen() {
+    return _frozen;
+}
+
+void RD03D::setFrozenTimeout(uint16_t timeoutMs) {
+    _frozenTimeoutMs = timeoutMs;
+    if (timeoutMs == 0) _frozen = false;
+}
+
+void RD03D::onFrozen(RD03D_FrozenCallback callback) {
+    _frozenCallback = callback;
+}
+
+uint32_t RD03D::getFrozenCount() {
+    return _frozenCount;
+}
+
+void RD03D::attachBlackBox(RD03D_BlackBox* blackBox) {
+    _blackBox = blackBox;
+}
+
+void RD03D::attachTunnel(RD03D_Tunnel* tunnel, bool parseLocally) {
+    _tunnel = tunnel;
+    _tunnelParse = parseLocally;
+}
+
+bool RD03D::applyConfig(const RD03D_ConfigBlob* config) {
+    if (config && !config->isValid()) return false;
+    
+    activateConfig(config);
+    return true;
+}
+
+bool RD03D::stageConfig(const RD03D_ConfigBlob* config) {
+    if (config && !config->isValid()) return false;
+    if (isConfigPending()) return false;
+    
+    // Publish the pointer before the flag the parser checks
+    _pendingConfig = config;
+    __atomic_store_n(&_configPending, true, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool RD03D::isConfigPending() {
+    return __atomic_load_n(&_configPending, __ATOMIC_ACQUIRE);
+}
+
+const RD03D_ConfigBlob* RD03D::getConfig() {
+    return _config;
+}
+
+uint32_t RD03D::getConfigVersion() {
+    return _configVersion;
+}
+
+uint32_t RD03D::getConfigSwapCount() {
+    return _configSwaps;
+}
+
+void RD03D::activateConfig(const RD03D_ConfigBlob* config) {
+    _config = config;
+    _configVersion = config ? config->getVersion() : 0;
+    if (_config && _config->getSettings()->timeoutMs > 0) {
+        _timeoutMs = _config->getSettings()->timeoutMs;
+    }
+}
+
+void RD03D::reportError() {
+    _errorCount++;
+    if (_blackBox) _blackBox->noteError(millis());
 }
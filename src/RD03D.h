@@ -29,6 +29,12 @@
 #define RD03D_TARGET_DATA_SIZE 8
 #define RD03D_BAUD_RATE        256000
 #define RD03D_DEFAULT_TIMEOUT  100   // ms
+#define RD03D_CONNECTED_WINDOW 1000  // ms without frames before isConnected() is false
+#define RD03D_READ_CHUNK       64    // Bytes pulled from the UART per read() call
+#define RD03D_OVERLOAD_ENTER   90    // % of the frame interval spent in the callback to start conflating
+#define RD03D_OVERLOAD_EXIT    60    // % below which normal delivery resumes
+#define RD03D_IDLE_DECIMATION  10    // Frames per delivered frame while idle
+#define RD03D_FROZEN_TIMEOUT   5000  // ms of identical non-empty frames before isFrozen()
 
 // ============== TARGET DATA ==============
 /**
@@ -57,6 +63,11 @@ struct RD03D_Target {
     }
 };
 
+class RD03D_BlackBox;
+class RD03D_ConfigBlob;
+class RD03D_InputSource;
+class RD03D_Tunnel;
+
 // ============== CALLBACK TYPES ==============
 /**
  * @brief Callback function type for new frame events
@@ -65,6 +76,24 @@ struct RD03D_Target {
  */
 typedef void (*RD03D_FrameCallback)(RD03D_Target* targets, uint8_t count);
 
+/**
+ * @brief Callback function type for frozen-sensor changes
+ * @param frozen true when the sensor starts repeating, false when it recovers
+ */
+typedef void (*RD03D_FrozenCallback)(bool frozen);
+
+/**
+ * @brief Callback function type for processing level changes
+ * @param level New level (RD03D_ProcessingLevel)
+ */
+typedef void (*RD03D_LevelCallback)(uint8_t level);
+
+// ============== PROCESSING LEVEL ==============
+enum RD03D_ProcessingLevel {
+    RD03D_LEVEL_FULL = 0,   ///< Every frame delivered
+    RD03D_LEVEL_IDLE        ///< Nobody seen for the idle timeout: decode only, reduced delivery
+};
+
 // ============== PARSER STATE ==============
 enum RD03D_ParserState {
     RD03D_SYNC_HEADER,    ///< Looking for header AA FF 03 00
@@ -125,6 +154,64 @@ public:
      */
     void update();
     
+    /**
+     * @brief Process incoming radar data within a work budget
+     * 
+     * Like update(), but stops after maxBytes bytes or maxMicros
+     * microseconds, so a large backlog is drained over several calls
+     * instead of stalling the loop. Bytes are read from the UART in
+     * chunks of RD03D_READ_CHUNK.
+     * @param maxBytes Byte budget for this call (0 = no limit)
+     * @param maxMicros Time budget for this call (0 = no limit)
+     * @return true if unread bytes remain (call again soon)
+     */
+    bool update(size_t maxBytes, uint32_t maxMicros);
+    
+    /**
+     * @brief Process radar data from a zero-copy input source
+     * 
+     * Decodes frames directly from the source's own buffer (see
+     * RD03D_Input.h); only a frame split across the source's wrap
+     * point is copied. Budgets are checked between frames.
+     * @param source Source to read from
+     * @param maxBytes Byte budget for this call (0 = no limit)
+     * @param maxMicros Time budget for this call (0 = no limit)
+     * @return true if unread bytes remain (call again soon)
+     */
+    bool update(RD03D_InputSource& source, size_t maxBytes = 0, uint32_t maxMicros = 0);
+    
+    /**
+     * @brief Get bytes left waiting in the UART or source after the last update()
+     */
+    size_t getBacklog();
+    
+    /**
+     * @brief Get the largest backlog seen by update() since begin()
+     */
+    size_t getMaxBacklog();
+    
+    /**
+     * @brief Process bytes from any other source
+     * 
+     * Runs the bytes through the same parser as update(), for streams
+     * that don't come from a local HardwareSerial (network tunnel,
+     * capture file, host tools). begin() is not required. Whole
+     * frames are decoded in place.
+     * @param data Raw radar bytes
+     * @param len Number of bytes
+     */
+    void feed(const uint8_t* data, size_t len);
+    
+    /**
+     * @brief Drop any partly received frame
+     * 
+     * For fed streams with a known gap (a lost tunnel datagram): the
+     * next bytes start a fresh search for a header instead of being
+     * stitched onto the old ones. Counts as a parse error if a frame
+     * was in progress, like a frame timeout.
+     */
+    void resync();
+    
     /**
      * @brief Enable multi-target detection mode
      * 
@@ -153,6 +240,17 @@ public:
      */
     RD03D_Target* getTargets();
     
+    /**
+     * @brief Get all targets moved into the site frame
+     * 
+     * Callbacks and getTargets() always see the sensor frame, so range
+     * and beam-angle checks (e.g. RD03D_Tracker) use the real geometry.
+     * This copies the current targets and applies the config's mounting
+     * pose; without a posed config it is a plain copy.
+     * @return Pointer to array of 3 targets, valid until the next call
+     */
+    RD03D_Target* getSiteTargets();
+    
     /**
      * @brief Get number of currently valid targets
      * @return Count of valid targets (0-3)
@@ -179,16 +277,212 @@ public:
     
     /**
      * @brief Check if radar is connected and sending data
+     * 
+     * Safe across the 49-day millis() wrap: once a second passes
+     * without a frame the result stays false until the next frame,
+     * however long the silence lasts.
      * @return true if frames received in last second
      */
     bool isConnected();
+    
+    /**
+     * @brief Check if the radar is stuck repeating the same frame
+     * 
+     * A locked-up sensor can keep sending one identical frame, so
+     * isConnected() stays true. Each payload is hashed in processFrame();
+     * the sensor counts as frozen once non-empty frames have been
+     * bit-identical for the frozen timeout. Empty frames (nobody in
+     * view) never count. Clears on the first different frame.
+     * @return true while frozen
+     */
+    bool isFrozen();
+    
+    /**
+     * @brief Set how long identical frames must repeat to count as frozen
+     * @param timeoutMs Timeout in ms (default 5000, 0 = disabled)
+     */
+    void setFrozenTimeout(uint16_t timeoutMs);
+    
+    /**
+     * @brief Set callback for frozen/recovered changes (e.g. to power-cycle the radar)
+     */
+    void onFrozen(RD03D_FrozenCallback callback);
+    
+    /**
+     * @brief Get number of times the sensor has frozen since begin()
+     */
+    uint32_t getFrozenCount();
+    
+    /**
+     * @brief Enable or disable automatic overload control
+     * 
+     * The frame callback's cost is measured against the radar's frame
+     * interval. When the callback needs more than RD03D_OVERLOAD_ENTER %
+     * of the interval, the radar switches to latest-frame-only delivery.
+     * Frames that already have a newer complete frame queued behind them
+     * are parsed (counters, black box) but not passed to the callback.
+     * Normal delivery resumes below RD03D_OVERLOAD_EXIT %.
+     * 
+     * Off by default. Only frames update() reads from the UART are
+     * timed and conflated; feed() and input sources always deliver every
+     * frame, since their bytes carry no arrival timing.
+     * @param enabled true to switch automatically, false to deliver every frame (default)
+     */
+    void setOverloadControl(bool enabled);
+    
+    /**
+     * @brief Check if only the latest frame is currently being delivered
+     */
+    bool isConflating();
+    
+    /**
+     * @brief Get frames parsed but not delivered because a newer one was queued
+     */
+    uint32_t getConflatedCount();
+    
+    /**
+     * @brief Get number of switches into and out of conflation
+     */
+    uint32_t getModeSwitchCount();
+    
+    /**
+     * @brief Get smoothed frame callback cost in microseconds
+     */
+    uint32_t getCallbackMicros();
+    
+    /**
+     * @brief Get smoothed radar frame interval in microseconds (0 until measured;
+     *        only frames update() reads from the UART are measured)
+     */
+    uint32_t getFrameInterval();
+    
+    /**
+     * @brief Drop to the idle level when the room has been empty
+     * 
+     * While idle, every frame is still decoded (counters, presence,
+     * black box) but only every RD03D_IDLE_DECIMATION-th empty frame is
+     * passed to the callback. The first frame with a valid target
+     * restores the full level and is delivered straight away.
+     * @param timeoutMs Time without valid targets before going idle (0 = never, default)
+     */
+    void setIdleTimeout(uint32_t timeoutMs);
+    
+    /**
+     * @brief Set how many frames make one delivered frame while idle
+     * @param frames Decimation factor (1 = deliver every frame)
+     */
+    void setIdleDecimation(uint8_t frames);
+    
+    /**
+     * @brief Set callback for processing level changes
+     * 
+     * Lets the sketch throttle its own work (WiFi rate, optional stages,
+     * sleep) together with the radar.
+     */
+    void onLevelChange(RD03D_LevelCallback callback);
+    
+    /**
+     * @brief Get current processing level (RD03D_ProcessingLevel)
+     */
+    uint8_t getLevel();
+    
+    /**
+     * @brief Check if the radar is at the idle level
+     */
+    bool isIdle();
+    
+    /**
+     * @brief Get frames decoded but not delivered because of the idle level
+     */
+    uint32_t getIdleSkippedCount();
+    
+    /**
+     * @brief Attach a black-box recorder
+     * 
+     * Every completed frame (including frames with a corrupt tail) is
+     * recorded, and parse errors are reported for error-spike triggers.
+     * @param blackBox Recorder to feed, or nullptr to detach
+     */
+    void attachBlackBox(RD03D_BlackBox* blackBox);
+    
+    /**
+     * @brief Forward raw UART bytes through a tunnel
+     * 
+     * Every byte update() reads is passed to the tunnel with the time
+     * it was read, and the tunnel is polled so datagrams go out once
+     * they are full or old enough (see RD03D_Tunnel.h). With local
+     * parsing off, frames are only decoded at the far end: no
+     * callbacks run here and isConnected() stays false.
+     * @param tunnel Tunnel to write to, or nullptr to detach
+     * @param parseLocally true to decode frames here as well
+     */
+    void attachTunnel(RD03D_Tunnel* tunnel, bool parseLocally = false);
+    
+    /**
+     * @brief Use a validated site configuration blob
+     * 
+     * Applies the frame timeout. Frames stay in the sensor frame; the
+     * blob's mounting pose is applied by getSiteTargets(), or to tracks
+     * after tracking. The blob is used in place, so it must outlive the
+     * radar object.
+     * @param config Loaded config (see RD03D_Config.h), or nullptr for none
+     * @return false if config is not valid (current config is kept)
+     */
+    bool applyConfig(const RD03D_ConfigBlob* config);
+    
+    /**
+     * @brief Queue a configuration to take effect at the next frame
+     * 
+     * Safe to call from another task (e.g. a network handler). The swap
+     * happens at the start of processFrame(), so every frame is handled
+     * entirely under one configuration and parsing never stalls. The
+     * blob must stay unchanged until isConfigPending() returns false;
+     * RD03D_ConfigShadow manages the double buffering.
+     * @param config Loaded config, or nullptr to drop the current one
+     * @return false if config is invalid or a swap is already pending
+     */
+    bool stageConfig(const RD03D_ConfigBlob* config);
+    
+    /**
+     * @brief Check if a staged configuration is waiting for the next frame
+     */
+    bool isConfigPending();
+    
+    /**
+     * @brief Get the active configuration
+     * @return Config blob, or nullptr if none applied
+     */
+    const RD03D_ConfigBlob* getConfig();
+    
+    /**
+     * @brief Get the version of the config the current frame used
+     * 
+     * Stable for the whole frame callback; 0 if no config is active.
+     * @return Config revision from the blob
+     */
+    uint32_t getConfigVersion();
+    
+    /**
+     * @brief Get number of staged configs swapped in since begin()
+     */
+    uint32_t getConfigSwapCount();
 
 private:
     HardwareSerial* _serial;
     RD03D_Target _targets[RD03D_MAX_TARGETS];
+    RD03D_Target _siteTargets[RD03D_MAX_TARGETS];  // Posed copy, see getSiteTargets()
     RD03D_FrameCallback _frameCallback;
+    RD03D_FrozenCallback _frozenCallback;
+    RD03D_BlackBox* _blackBox;
+    RD03D_Tunnel* _tunnel;
+    bool _tunnelParse;      // Decode locally as well as forwarding
+    const RD03D_ConfigBlob* _config;
+    const RD03D_ConfigBlob* _pendingConfig;
+    bool _configPending;    // Set by stageConfig(), cleared at the swap
+    uint32_t _configVersion;
+    uint32_t _configSwaps;
     
-    // Frame buffer and parser state
+    // Frame buffer (stitches frames split across reads) and parser state
     uint8_t _frameBuf[RD03D_FRAME_SIZE];
     uint8_t _frameIdx;
     uint8_t _syncIdx;
@@ -198,6 +492,39 @@ private:
     uint32_t _lastByteTime;
     uint32_t _lastFrameTime;
     uint16_t _timeoutMs;
+    bool _frameFresh;       // Frame seen within the connection window
+    
+    // Backlog
+    size_t _backlog;        // Unread bytes left by the last update()
+    size_t _maxBacklog;
+    
+    // Overload control
+    bool _overloadControl;
+    bool _conflating;
+    bool _liveInput;           // update() is parsing bytes read from the UART
+    size_t _pendingBytes;      // Bytes still to be parsed in the current feed()
+    uint32_t _lastLiveMicros;  // Last frame that arrived with nothing queued behind it
+    bool _lastLiveValid;
+    uint32_t _frameInterval;
+    uint32_t _callbackMicros;
+    uint32_t _conflatedCount;
+    uint32_t _modeSwitches;
+    
+    // Occupancy-adaptive level
+    RD03D_LevelCallback _levelCallback;
+    uint32_t _idleTimeoutMs;
+    uint32_t _lastPresence;    // Last frame with a valid target
+    uint8_t _idleDecimation;
+    uint8_t _idleFrame;
+    bool _idle;
+    uint32_t _idleSkipped;
+    
+    // Frozen-sensor detection
+    uint32_t _payloadHash;
+    uint32_t _repeatStart;  // Time the current run of identical frames began
+    uint16_t _frozenTimeoutMs;
+    bool _frozen;
+    uint32_t _frozenCount;
     
     // Statistics
     uint32_t _frameCount;
@@ -208,10 +535,19 @@ private:
     static const uint8_t MULTI_TARGET_CMD[12];
     
     // Private methods
+    void checkTimeout();
+    size_t parse(const uint8_t* data, size_t len, size_t queued, uint32_t start, uint32_t maxMicros);
     void processByte(uint8_t b);
+    void completeFrame(const uint8_t* frame);
     void parseTarget(uint8_t index, const uint8_t* data);
-    void processFrame();
+    void processFrame(const uint8_t* frame);
+    void checkFrozen(const uint8_t* frame, bool wasFresh);
+    bool deliverFrame();
+    bool updateLevel(uint8_t count);
+    void updateOverload(uint32_t callbackMicros);
     void resetParser();
+    void reportError();
+    void activateConfig(const RD03D_ConfigBlob* config);
 };
 
 #endif // RD03D_H
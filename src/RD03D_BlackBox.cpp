@@ -0,0 +1,143 @@
+/**
+ * @file RD03D_BlackBox.cpp
+ * @brief Implementation of the RD-03D black-box recorder
+ */
+
+#include "RD03D_BlackBox.h"
+
+RD03D_BlackBox::RD03D_BlackBox(RD03D_BlackBoxEntry* storage, uint16_t capacity, uint16_t postTrigger) {
+    _storage = storage;
+    _capacity = capacity;
+    // Always keep at least one slot of pre-trigger history
+    _postTrigger = (capacity > 0 && postTrigger >= capacity) ? capacity - 1 : postTrigger;
+    _flushCallback = nullptr;
+    _errorThreshold = 0;
+    _errorWindowMs = 1000;
+    _errorsInWindow = 0;
+    _errorWindowStart = 0;
+    _triggerCount = 0;
+    _missedCount = 0;
+    _reason = RD03D_TRIGGER_NONE;
+    rearm();
+}
+
+void RD03D_BlackBox::onFlush(RD03D_FlushCallback callback) {
+    _flushCallback = callback;
+}
+
+void RD03D_BlackBox::setErrorTrigger(uint8_t errors, uint16_t windowMs) {
+    _errorThreshold = errors;
+    _errorWindowMs = windowMs;
+    _errorsInWindow = 0;
+}
+
+bool RD03D_BlackBox::trigger(uint8_t reason) {
+    if (_state != RD03D_BB_ARMED || _capacity == 0) return false;
+
+    _reason = reason;
+    _triggerCount++;
+
+    // Mark the newest pre-trigger frame so the trigger point survives the flush
+    if (_count > 0) {
+        uint16_t last = (_head + _capacity - 1) % _capacity;
+        _storage[last].flags |= RD03D_BB_FLAG_TRIGGER;
+    }
+
+    _postRemaining = _postTrigger;
+    _state = (_postRemaining > 0) ? RD03D_BB_CAPTURING : RD03D_BB_FLUSHING;
+    return true;
+}
+
+void RD03D_BlackBox::record(const uint8_t* frame, const RD03D_Target* targets, uint32_t now) {
+    if (_capacity == 0) return;
+    if (_state == RD03D_BB_FLUSHING) {
+        _missedCount++;
+        return;
+    }
+
+    RD03D_BlackBoxEntry& e = _storage[_head];
+    e.timestamp = now;
+    memcpy(e.raw, frame, RD03D_FRAME_SIZE);
+    e.flags = 0;
+    for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+        if (targets) {
+            e.targets[i] = targets[i];
+        } else {
+            e.targets[i].clear();
+        }
+    }
+    if (!targets) e.flags |= RD03D_BB_FLAG_BAD_TAIL;
+
+    _head = (_head + 1) % _capacity;
+    if (_count < _capacity) _count++;
+
+    if (_state == RD03D_BB_CAPTURING && --_postRemaining == 0) {
+        _state = RD03D_BB_FLUSHING;
+        _flushIdx = 0;
+    }
+}
+
+void RD03D_BlackBox::noteError(uint32_t now) {
+    if (_errorThreshold == 0) return;
+
+    if (now - _errorWindowStart > _errorWindowMs) {
+        _errorWindowStart = now;
+        _errorsInWindow = 0;
+    }
+    if (_errorsInWindow < 255) _errorsInWindow++;
+
+    if (_errorsInWindow >= _errorThreshold && trigger(RD03D_TRIGGER_ERROR_SPIKE)) {
+        _errorsInWindow = 0;
+    }
+}
+
+uint16_t RD03D_BlackBox::service(uint16_t maxEntries) {
+    if (_state != RD03D_BB_FLUSHING) return 0;
+
+    uint16_t flushed = 0;
+    uint16_t oldest = (_head + _capacity - _count) % _capacity;
+
+    while (_flushIdx < _count && flushed < maxEntries) {
+        if (_flushCallback) {
+            const RD03D_BlackBoxEntry& e = _storage[(oldest + _flushIdx) % _capacity];
+            if (!_flushCallback(e, _flushIdx, _count)) {
+                return flushed;  // Sink busy, retry this entry later
+            }
+        }
+        _flushIdx++;
+        flushed++;
+    }
+
+    if (_flushIdx >= _count) {
+        rearm();
+    }
+    return flushed;
+}
+
+RD03D_BlackBoxState RD03D_BlackBox::getState() {
+    return _state;
+}
+
+uint8_t RD03D_BlackBox::getTriggerReason() {
+    return _reason;
+}
+
+uint16_t RD03D_BlackBox::getCount() {
+    return _count;
+}
+
+uint32_t RD03D_BlackBox::getTriggerCount() {
+    return _triggerCount;
+}
+
+uint32_t RD03D_BlackBox::getMissedCount() {
+    return _missedCount;
+}
+
+void RD03D_BlackBox::rearm() {
+    _head = 0;
+    _count = 0;
+    _state = RD03D_BB_ARMED;
+    _postRemaining = 0;
+    _flushIdx = 0;
+}
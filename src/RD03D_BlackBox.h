@@ -0,0 +1,180 @@
+/**
+ * @file RD03D_BlackBox.h
+ * @brief Event-triggered black-box recorder for RD-03D frames
+ *
+ * Keeps a RAM ring of the most recent frames (raw bytes plus decoded
+ * targets). When triggered, the frames leading up to the trigger are
+ * frozen, a configurable number of post-trigger frames is captured, and
+ * the whole window is handed to a flush callback a few entries at a time
+ * so writing to flash or the network never blocks the radar loop.
+ *
+ * Storage is supplied by the caller, so memory use is fixed at compile time:
+ * @code
+ * RD03D_BlackBoxEntry bbStorage[64];
+ * RD03D_BlackBox blackBox(bbStorage, 64, 16);  // 48 frames before, 16 after
+ *
+ * void setup() {
+ *     radar.begin(Serial1, 20, 21);
+ *     radar.attachBlackBox(&blackBox);
+ *     blackBox.onFlush(writeEntry);
+ * }
+ *
+ * void loop() {
+ *     radar.update();
+ *     blackBox.service();
+ * }
+ * @endcode
+ */
+
+#ifndef RD03D_BLACKBOX_H
+#define RD03D_BLACKBOX_H
+
+#include "RD03D.h"
+
+// ============== CONFIGURATION ==============
+#define RD03D_BLACKBOX_FLUSH_BATCH  4    // Entries flushed per service() call
+
+// Entry flags
+#define RD03D_BB_FLAG_BAD_TAIL      0x01 // Frame had a corrupt tail (targets cleared)
+#define RD03D_BB_FLAG_TRIGGER       0x02 // Last frame recorded before the trigger
+
+// ============== TRIGGER REASONS ==============
+enum RD03D_TriggerReason {
+    RD03D_TRIGGER_NONE = 0,
+    RD03D_TRIGGER_MANUAL,         ///< trigger() called by the application
+    RD03D_TRIGGER_ERROR_SPIKE,    ///< Parse errors exceeded the configured rate
+    RD03D_TRIGGER_EVENT           ///< Application-defined event (zone, threshold...)
+};
+
+// ============== RECORDER STATE ==============
+enum RD03D_BlackBoxState {
+    RD03D_BB_ARMED,       ///< Recording continuously, waiting for a trigger
+    RD03D_BB_CAPTURING,   ///< Triggered, capturing post-trigger frames
+    RD03D_BB_FLUSHING     ///< Window frozen, handing entries to the flush callback
+};
+
+// ============== ENTRY ==============
+/**
+ * @brief One recorded frame
+ */
+struct RD03D_BlackBoxEntry {
+    uint32_t timestamp;                       ///< millis() when the frame completed
+    uint8_t raw[RD03D_FRAME_SIZE];            ///< Frame bytes exactly as received
+    uint8_t flags;                            ///< RD03D_BB_FLAG_* bits
+    RD03D_Target targets[RD03D_MAX_TARGETS];  ///< Decoded targets
+};
+
+/**
+ * @brief Flush callback, called once per entry in chronological order
+ * @param entry Recorded frame
+ * @param index Position of this entry in the window (0 = oldest)
+ * @param total Number of entries in the window
+ * @return true if the entry was written, false to retry it on the next service()
+ */
+typedef bool (*RD03D_FlushCallback)(const RD03D_BlackBoxEntry& entry, uint16_t index, uint16_t total);
+
+// ============== MAIN CLASS ==============
+class RD03D_BlackBox {
+public:
+    /**
+     * @brief Constructor
+     * @param storage Caller-owned array of entries
+     * @param capacity Number of entries in storage
+     * @param postTrigger Frames captured after a trigger (rest are pre-trigger history)
+     */
+    RD03D_BlackBox(RD03D_BlackBoxEntry* storage, uint16_t capacity, uint16_t postTrigger);
+
+    /**
+     * @brief Set the callback that receives the frozen window
+     * @param callback Function to call for each entry
+     */
+    void onFlush(RD03D_FlushCallback callback);
+
+    /**
+     * @brief Trigger automatically when parse errors spike
+     * @param errors Number of errors that fires the trigger (0 = disabled)
+     * @param windowMs Time window in which the errors must occur
+     */
+    void setErrorTrigger(uint8_t errors, uint16_t windowMs);
+
+    /**
+     * @brief Freeze the pre-trigger history and start the post-trigger capture
+     * @param reason Why the recorder was triggered (RD03D_TriggerReason)
+     * @return true if accepted, false if a capture or flush is already in progress
+     */
+    bool trigger(uint8_t reason = RD03D_TRIGGER_MANUAL);
+
+    /**
+     * @brief Record a completed frame (called by RD03D)
+     * @param frame Raw frame bytes (RD03D_FRAME_SIZE)
+     * @param targets Decoded targets, or nullptr if the frame was corrupt
+     * @param now Current millis()
+     */
+    void record(const uint8_t* frame, const RD03D_Target* targets, uint32_t now);
+
+    /**
+     * @brief Report a parse error (called by RD03D)
+     * @param now Current millis()
+     */
+    void noteError(uint32_t now);
+
+    /**
+     * @brief Flush pending entries (call from loop)
+     * @param maxEntries Maximum entries handed to the flush callback in this call
+     * @return Number of entries flushed
+     */
+    uint16_t service(uint16_t maxEntries = RD03D_BLACKBOX_FLUSH_BATCH);
+
+    /**
+     * @brief Get current recorder state
+     */
+    RD03D_BlackBoxState getState();
+
+    /**
+     * @brief Get reason of the current (or last) trigger
+     */
+    uint8_t getTriggerReason();
+
+    /**
+     * @brief Get number of entries currently held
+     */
+    uint16_t getCount();
+
+    /**
+     * @brief Get number of triggers accepted since construction
+     */
+    uint32_t getTriggerCount();
+
+    /**
+     * @brief Get number of frames not recorded because a flush was in progress
+     */
+    uint32_t getMissedCount();
+
+private:
+    RD03D_BlackBoxEntry* _storage;
+    uint16_t _capacity;
+    uint16_t _postTrigger;
+    RD03D_FlushCallback _flushCallback;
+
+    // Ring state
+    uint16_t _head;          // Next slot to write
+    uint16_t _count;         // Valid entries in the ring
+    RD03D_BlackBoxState _state;
+    uint16_t _postRemaining;
+    uint16_t _flushIdx;
+    uint8_t _reason;
+
+    // Error spike detection
+    uint8_t _errorThreshold;
+    uint16_t _errorWindowMs;
+    uint8_t _errorsInWindow;
+    uint32_t _errorWindowStart;
+
+    // Statistics
+    uint32_t _triggerCount;
+    uint32_t _missedCount;
+
+    void rearm();
+};
+
+#endif // RD03D_BLACKBOX_H
@@ -0,0 +1,180 @@
+/**
+ * @file RD03D_Calibration.cpp
+ * @brief Implementation of two-sensor extrinsic calibration
+ */
+
+#include "RD03D_Calibration.h"
+
+RD03D_Calibration::RD03D_Calibration(RD03D_CalibrationPair* storage, uint16_t capacity) {
+    _pairs = storage;
+    _capacity = capacity;
+    _threshold = 300.0f;
+    clear();
+}
+
+void RD03D_Calibration::addPair(float ax, float ay, float bx, float by) {
+    if (_capacity == 0) return;
+
+    RD03D_CalibrationPair& p = _pairs[_next];
+    p.ax = ax;
+    p.ay = ay;
+    p.bx = bx;
+    p.by = by;
+    p.inlier = true;
+
+    _next = (_next + 1) % _capacity;
+    if (_count < _capacity) _count++;
+}
+
+bool RD03D_Calibration::addFrames(const RD03D_Target* a, const RD03D_Target* b) {
+    int8_t ia = -1;
+    int8_t ib = -1;
+    for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+        if (a[i].valid) {
+            if (ia >= 0) return false;
+            ia = i;
+        }
+        if (b[i].valid) {
+            if (ib >= 0) return false;
+            ib = i;
+        }
+    }
+    if (ia < 0 || ib < 0) return false;
+
+    addPair(a[ia].x, a[ia].y, b[ib].x, b[ib].y);
+    return true;
+}
+
+void RD03D_Calibration::setOutlierThreshold(float mm) {
+    _threshold = mm;
+}
+
+bool RD03D_Calibration::solve(RD03D_Pose& pose) {
+    if (_count < RD03D_CALIB_MIN_PAIRS) return false;
+
+    for (uint16_t i = 0; i < _count; i++) {
+        _pairs[i].inlier = true;
+    }
+
+    RD03D_Pose current;
+    if (!fit(nullptr, current, false)) return false;
+
+    // Huber reweighting pulls the fit away from gross outliers
+    for (uint8_t iter = 0; iter < RD03D_CALIB_ITERATIONS / 2; iter++) {
+        if (!fit(&current, current, false)) return false;
+    }
+
+    // Hard rejection, refit on inliers until the inlier set settles
+    for (uint8_t iter = 0; iter < RD03D_CALIB_ITERATIONS; iter++) {
+        bool changed = false;
+        uint16_t inliers = 0;
+        for (uint16_t i = 0; i < _count; i++) {
+            bool in = residual(_pairs[i], current) <= _threshold;
+            if (in != _pairs[i].inlier) changed = true;
+            _pairs[i].inlier = in;
+            if (in) inliers++;
+        }
+        if (inliers < RD03D_CALIB_MIN_PAIRS) return false;
+        if (!fit(nullptr, current, true)) return false;
+        if (!changed) break;
+    }
+
+    // Statistics over the final inliers
+    float sumSq = 0.0f;
+    _inliers = 0;
+    for (uint16_t i = 0; i < _count; i++) {
+        if (!_pairs[i].inlier) continue;
+        float r = residual(_pairs[i], current);
+        sumSq += r * r;
+        _inliers++;
+    }
+    _rmsError = sqrtf(sumSq / _inliers);
+
+    pose = current;
+    return true;
+}
+
+bool RD03D_Calibration::fit(const RD03D_Pose* previous, RD03D_Pose& pose, bool useInliers) {
+    // Weighted 2D Procrustes: a = R(theta) * b + t
+    float huber = _threshold * 0.5f;
+    float sw = 0.0f;
+    float sax = 0.0f, say = 0.0f, sbx = 0.0f, sby = 0.0f;
+
+    // Centroids (weights recomputed in each pass to avoid scratch memory)
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        float cax = (sw > 0.0f) ? sax / sw : 0.0f;
+        float cay = (sw > 0.0f) ? say / sw : 0.0f;
+        float cbx = (sw > 0.0f) ? sbx / sw : 0.0f;
+        float cby = (sw > 0.0f) ? sby / sw : 0.0f;
+        float dot = 0.0f, cross = 0.0f, spread = 0.0f, wsum = 0.0f;
+
+        for (uint16_t i = 0; i < _count; i++) {
+            const RD03D_CalibrationPair& p = _pairs[i];
+            if (useInliers && !p.inlier) continue;
+
+            float w = 1.0f;
+            if (previous) {
+                float r = residual(p, *previous);
+                if (r > huber) w = huber / r;
+            }
+
+            if (pass == 0) {
+                sw += w;
+                sax += w * p.ax;
+                say += w * p.ay;
+                sbx += w * p.bx;
+                sby += w * p.by;
+            } else {
+                float ax = p.ax - cax, ay = p.ay - cay;
+                float bx = p.bx - cbx, by = p.by - cby;
+                dot += w * (ax * bx + ay * by);
+                cross += w * (ay * bx - ax * by);
+                spread += w * (bx * bx + by * by);
+                wsum += w;
+            }
+        }
+
+        if (pass == 0) {
+            if (sw <= 0.0f) return false;
+            continue;
+        }
+
+        // Rotation is undefined if the walk barely moved
+        if (spread / wsum < RD03D_CALIB_MIN_SPREAD_MM * RD03D_CALIB_MIN_SPREAD_MM) return false;
+
+        float theta = atan2f(cross, dot);
+        float c = cosf(theta);
+        float s = sinf(theta);
+        pose.theta = theta * 180.0f / PI;
+        pose.x = cax - (c * cbx - s * cby);
+        pose.y = cay - (s * cbx + c * cby);
+    }
+    return true;
+}
+
+float RD03D_Calibration::residual(const RD03D_CalibrationPair& p, const RD03D_Pose& pose) {
+    float x, y;
+    pose.apply(p.bx, p.by, x, y);
+    float dx = x - p.ax;
+    float dy = y - p.ay;
+    return sqrtf(dx * dx + dy * dy);
+}
+
+float RD03D_Calibration::getRmsError() {
+    return _rmsError;
+}
+
+uint16_t RD03D_Calibration::getInlierCount() {
+    return _inliers;
+}
+
+uint16_t RD03D_Calibration::getCount() {
+    return _count;
+}
+
+void RD03D_Calibration::clear() {
+    _count = 0;
+    _next = 0;
+    _rmsError = 0.0f;
+    _inliers = 0;
+}
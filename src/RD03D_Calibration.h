@@ -0,0 +1,121 @@
+/**
+ * @file RD03D_Calibration.h
+ * @brief Automatic extrinsic calibration between two overlapping radars
+ *
+ * While one person walks through the area both sensors can see, collect
+ * simultaneous detections from sensor A (reference) and sensor B. The
+ * solver finds the pose of B in A's frame (RD03D_Pose) with a weighted
+ * least-squares rigid fit, Huber reweighting and hard outlier rejection,
+ * so ghost targets and mismatched pairs don't pull the result.
+ *
+ * Pair storage is supplied by the caller, so memory is fixed:
+ * @code
+ * RD03D_CalibrationPair pairs[200];
+ * RD03D_Calibration calib(pairs, 200);
+ *
+ * // Whenever both radars have a new frame:
+ * calib.addFrames(targetsA, targetsB);
+ *
+ * RD03D_Pose poseB;
+ * if (calib.solve(poseB)) {
+ *     poseB.apply(targetB);   // B's targets now in A's frame
+ * }
+ * @endcode
+ *
+ * The same class runs on the host (see extras/host/calibrate.cpp).
+ */
+
+#ifndef RD03D_CALIBRATION_H
+#define RD03D_CALIBRATION_H
+
+#include "RD03D.h"
+#include "RD03D_Pose.h"
+
+// ============== CONFIGURATION ==============
+#define RD03D_CALIB_MIN_PAIRS      20      // Pairs needed before solve()
+#define RD03D_CALIB_MIN_SPREAD_MM  500.0f  // RMS spread of the walk needed for a stable rotation
+#define RD03D_CALIB_ITERATIONS     10      // Reweighting iterations
+
+// ============== PAIR ==============
+/**
+ * @brief One simultaneous observation of the same person
+ */
+struct RD03D_CalibrationPair {
+    float ax, ay;   ///< Position seen by sensor A (mm)
+    float bx, by;   ///< Position seen by sensor B (mm)
+    bool inlier;    ///< Set by solve()
+};
+
+// ============== MAIN CLASS ==============
+class RD03D_Calibration {
+public:
+    /**
+     * @brief Constructor
+     * @param storage Caller-owned pair array
+     * @param capacity Number of pairs in storage (older pairs are overwritten)
+     */
+    RD03D_Calibration(RD03D_CalibrationPair* storage, uint16_t capacity);
+
+    /**
+     * @brief Add one pair of positions
+     */
+    void addPair(float ax, float ay, float bx, float by);
+
+    /**
+     * @brief Add a pair from two simultaneous frames
+     *
+     * Only used when each sensor sees exactly one target, so the pairing
+     * is unambiguous.
+     * @param a Targets from sensor A (RD03D_MAX_TARGETS)
+     * @param b Targets from sensor B (RD03D_MAX_TARGETS)
+     * @return true if a pair was added
+     */
+    bool addFrames(const RD03D_Target* a, const RD03D_Target* b);
+
+    /**
+     * @brief Set the residual below which a pair is always an inlier
+     * @param mm Distance in mm (default 300)
+     */
+    void setOutlierThreshold(float mm);
+
+    /**
+     * @brief Solve for the pose of sensor B in sensor A's frame
+     * @param pose Output pose (unchanged on failure)
+     * @return false if there are too few pairs or the walk covered too little area
+     */
+    bool solve(RD03D_Pose& pose);
+
+    /**
+     * @brief Get RMS residual of the inliers from the last solve() (mm)
+     */
+    float getRmsError();
+
+    /**
+     * @brief Get number of inliers from the last solve()
+     */
+    uint16_t getInlierCount();
+
+    /**
+     * @brief Get number of stored pairs
+     */
+    uint16_t getCount();
+
+    /**
+     * @brief Discard all pairs
+     */
+    void clear();
+
+private:
+    RD03D_CalibrationPair* _pairs;
+    uint16_t _capacity;
+    uint16_t _count;
+    uint16_t _next;
+    float _threshold;
+    float _rmsError;
+    uint16_t _inliers;
+
+    bool fit(const RD03D_Pose* previous, RD03D_Pose& pose, bool useInliers);
+    float residual(const RD03D_CalibrationPair& p, const RD03D_Pose& pose);
+};
+
+#endif // RD03D_CALIBRATION_H
@@ -0,0 +1,189 @@
+/**
+ * @file RD03D_Config.cpp
+ * @brief Implementation of the binary site configuration
+ */
+
+#include "RD03D_Config.h"
+#include <string.h>
+
+// Fixed layout: the host generator and the firmware must agree
+static_assert(sizeof(RD03D_ConfigHeader) == 32, "RD03D_ConfigHeader layout changed");
+static_assert(sizeof(RD03D_ConfigSettings) == 40, "RD03D_ConfigSettings layout changed");
+static_assert(sizeof(RD03D_ConfigRegion) == 12, "RD03D_ConfigRegion layout changed");
+
+// Half-byte table keeps the CRC small enough for any MCU
+static const uint32_t CRC32_NIBBLE[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+RD03D_ConfigBlob::RD03D_ConfigBlob() {
+    _data = nullptr;
+    _header = nullptr;
+}
+
+RD03D_ConfigError RD03D_ConfigBlob::load(const uint8_t* data, size_t size) {
+    _data = nullptr;
+    _header = nullptr;
+
+    if (!data || ((uintptr_t)data & 3) != 0) return RD03D_CONFIG_ERR_ALIGN;
+    if (size < sizeof(RD03D_ConfigHeader)) return RD03D_CONFIG_ERR_SIZE;
+
+    const RD03D_ConfigHeader* h = (const RD03D_ConfigHeader*)data;
+    if (h->magic != RD03D_CONFIG_MAGIC) return RD03D_CONFIG_ERR_MAGIC;
+    if (h->format != RD03D_CONFIG_FORMAT) return RD03D_CONFIG_ERR_FORMAT;
+    if (h->totalSize > size || h->totalSize < sizeof(RD03D_ConfigHeader)) return RD03D_CONFIG_ERR_SIZE;
+
+    // Every record must lie inside the blob and be at least as large as
+    // this firmware expects (newer generators may append fields)
+    uint32_t total = h->totalSize;
+    if (h->headerSize < sizeof(RD03D_ConfigHeader) ||
+        h->settingsSize < sizeof(RD03D_ConfigSettings) ||
+        (h->settingsOffset & 3) != 0 ||
+        (uint32_t)h->settingsOffset + h->settingsSize > total) {
+        return RD03D_CONFIG_ERR_LAYOUT;
+    }
+    if (h->regionCount > 0) {
+        if (h->regionSize < sizeof(RD03D_ConfigRegion) || (h->regionSize & 3) != 0 ||
+            (h->regionsOffset & 3) != 0 ||
+            (uint32_t)h->regionsOffset + (uint32_t)h->regionCount * h->regionSize > total) {
+            return RD03D_CONFIG_ERR_LAYOUT;
+        }
+    }
+
+    if (crc32(data + 8, total - 8) != h->crc) return RD03D_CONFIG_ERR_CRC;
+
+    _data = data;
+    _header = h;
+    return RD03D_CONFIG_OK;
+}
+
+bool RD03D_ConfigBlob::isValid() const {
+    return _header != nullptr;
+}
+
+uint32_t RD03D_ConfigBlob::getVersion() const {
+    return _header ? _header->configVersion : 0;
+}
+
+const RD03D_ConfigSettings* RD03D_ConfigBlob::getSettings() const {
+    if (!_header) return nullptr;
+    return (const RD03D_ConfigSettings*)(_data + _header->settingsOffset);
+}
+
+bool RD03D_ConfigBlob::getPose(RD03D_Pose& pose) const {
+    const RD03D_ConfigSettings* s = getSettings();
+    if (!s || !(s->flags & RD03D_CONFIG_FLAG_POSE)) return false;
+    pose.x = s->poseX;
+    pose.y = s->poseY;
+    pose.theta = s->poseTheta;
+    return true;
+}
+
+bool RD03D_ConfigBlob::getTrackerConfig(RD03D_TrackerConfig& config) const {
+    const RD03D_ConfigSettings* s = getSettings();
+    if (!s || !(s->flags & RD03D_CONFIG_FLAG_TRACKER)) return false;
+    config.maxRangeCm = s->maxRangeCm;
+    config.maxAngleDeg = s->maxAngleDeg;
+    config.gateMm = s->gateMm;
+    config.coastFrames = s->coastFrames;
+    config.confirmFrames = s->confirmFrames;
+    config.alpha = s->alpha;
+    config.beta = s->beta;
+    return true;
+}
+
+uint16_t RD03D_ConfigBlob::getRegionCount() const {
+    return _header ? _header->regionCount : 0;
+}
+
+const RD03D_ConfigRegion* RD03D_ConfigBlob::getRegion(uint16_t index) const {
+    if (!_header || index >= _header->regionCount) return nullptr;
+    return (const RD03D_ConfigRegion*)(_data + _header->regionsOffset + (uint32_t)index * _header->regionSize);
+}
+
+size_t RD03D_ConfigBlob::build(const RD03D_ConfigSettings& settings,
+                               const RD03D_ConfigRegion* regions, uint16_t regionCount,
+                               uint32_t configVersion, uint8_t* buffer, size_t size) {
+    size_t settingsOffset = sizeof(RD03D_ConfigHeader);
+    size_t regionsOffset = settingsOffset + sizeof(RD03D_ConfigSettings);
+    size_t total = regionsOffset + (size_t)regionCount * sizeof(RD03D_ConfigRegion);
+    if (!buffer || total > size || total > 0xFFFF) return 0;
+
+    RD03D_ConfigHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = RD03D_CONFIG_MAGIC;
+    h.format = RD03D_CONFIG_FORMAT;
+    h.headerSize = sizeof(RD03D_ConfigHeader);
+    h.totalSize = (uint32_t)total;
+    h.configVersion = configVersion;
+    h.settingsOffset = (uint16_t)settingsOffset;
+    h.settingsSize = sizeof(RD03D_ConfigSettings);
+    h.regionsOffset = (uint16_t)regionsOffset;
+    h.regionCount = regionCount;
+    h.regionSize = sizeof(RD03D_ConfigRegion);
+
+    memcpy(buffer, &h, sizeof(h));
+    memcpy(buffer + settingsOffset, &settings, sizeof(settings));
+    if (regionCount > 0) {
+        memcpy(buffer + regionsOffset, regions, (size_t)regionCount * sizeof(RD03D_ConfigRegion));
+    }
+
+    h.crc = crc32(buffer + 8, total - 8);
+    memcpy(buffer + 4, &h.crc, sizeof(h.crc));
+    return total;
+}
+
+uint32_t RD03D_ConfigBlob::crc32(const uint8_t* data, size_t len, uint32_t crc) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ CRC32_NIBBLE[crc & 0x0F];
+        crc = (crc >> 4) ^ CRC32_NIBBLE[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+// ============== HOT SWAP ==============
+RD03D_ConfigShadow::RD03D_ConfigShadow(RD03D& radar, uint8_t* bufferA, uint8_t* bufferB, size_t size)
+    : _radar(radar) {
+    _buffers[0] = bufferA;
+    _buffers[1] = bufferB;
+    _size = size;
+}
+
+uint8_t* RD03D_ConfigShadow::getBuffer() {
+    if (_radar.isConfigPending()) return nullptr;
+    return _buffers[shadowIndex()];
+}
+
+size_t RD03D_ConfigShadow::getCapacity() {
+    return _size;
+}
+
+RD03D_ConfigError RD03D_ConfigShadow::commit(size_t len) {
+    if (_radar.isConfigPending()) return RD03D_CONFIG_ERR_BUSY;
+    if (len > _size) return RD03D_CONFIG_ERR_SIZE;
+
+    uint8_t index = shadowIndex();
+    RD03D_ConfigError err = _views[index].load(_buffers[index], len);
+    if (err != RD03D_CONFIG_OK) return err;
+
+    return _radar.stageConfig(&_views[index]) ? RD03D_CONFIG_OK : RD03D_CONFIG_ERR_BUSY;
+}
+
+RD03D_ConfigError RD03D_ConfigShadow::stage(const uint8_t* data, size_t len) {
+    uint8_t* buffer = getBuffer();
+    if (!buffer) return RD03D_CONFIG_ERR_BUSY;
+    if (len > _size) return RD03D_CONFIG_ERR_SIZE;
+
+    memcpy(buffer, data, len);
+    return commit(len);
+}
+
+uint8_t RD03D_ConfigShadow::shadowIndex() {
+    // Whichever buffer the radar is not using
+    return (_radar.getConfig() == &_views[0]) ? 1 : 0;
+}
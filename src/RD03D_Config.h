@@ -0,0 +1,254 @@
+/**
+ * @file RD03D_Config.h
+ * @brief Versioned binary site configuration, used in place from flash
+ *
+ * Site settings (timeout, mounting pose, tracker tuning, zones and
+ * tripwires) are compiled on the host by extras/host/mkconfig into a
+ * compact blob. At boot the blob is checked (magic, format version,
+ * layout and CRC-32) and then read directly where it lies: no text
+ * parsing, no copies, no heap.
+ *
+ * Layout (little-endian, IEEE-754 floats, 4-byte aligned):
+ *
+ *   RD03D_ConfigHeader      32 bytes
+ *   RD03D_ConfigSettings    settingsSize bytes at settingsOffset
+ *   RD03D_ConfigRegion[]    regionCount * regionSize bytes at regionsOffset
+ *
+ * Sizes and offsets are stored in the header, so a newer generator may
+ * append fields to either record without breaking older firmware.
+ *
+ * @code
+ * #include "site_config.h"   // alignas(4) const uint8_t siteConfig[] = {...};
+ *
+ * RD03D_ConfigBlob config;
+ * if (config.load(siteConfig, sizeof(siteConfig)) == RD03D_CONFIG_OK) {
+ *     radar.applyConfig(&config);
+ * }
+ * @endcode
+ */
+
+#ifndef RD03D_CONFIG_H
+#define RD03D_CONFIG_H
+
+#include "RD03D.h"
+#include "RD03D_Pose.h"
+#include "RD03D_Tracker.h"
+
+// ============== CONFIGURATION ==============
+#define RD03D_CONFIG_MAGIC     0x44334452UL  // "RD3D" as stored bytes
+#define RD03D_CONFIG_FORMAT    1             // Blob layout version
+
+// Settings flags
+#define RD03D_CONFIG_FLAG_POSE     0x01      // Blob carries a mounting pose
+#define RD03D_CONFIG_FLAG_TRACKER  0x02      // Tracker settings are present
+
+// ============== BLOB RECORDS ==============
+/**
+ * @brief Blob header (CRC covers everything after the crc field)
+ */
+struct RD03D_ConfigHeader {
+    uint32_t magic;          ///< RD03D_CONFIG_MAGIC
+    uint32_t crc;            ///< CRC-32 of bytes [8, totalSize)
+    uint16_t format;         ///< RD03D_CONFIG_FORMAT
+    uint16_t headerSize;     ///< sizeof(RD03D_ConfigHeader) when written
+    uint32_t totalSize;      ///< Blob size in bytes
+    uint32_t configVersion;  ///< Site revision, chosen by whoever builds the blob
+    uint16_t settingsOffset;
+    uint16_t settingsSize;
+    uint16_t regionsOffset;
+    uint16_t regionCount;
+    uint16_t regionSize;
+    uint16_t reserved;
+};
+
+/**
+ * @brief Scalar settings
+ */
+struct RD03D_ConfigSettings {
+    uint16_t timeoutMs;      ///< Frame timeout (0 = leave unchanged)
+    uint8_t flags;           ///< RD03D_CONFIG_FLAG_*
+    uint8_t reserved;
+    float poseX;             ///< Mounting pose (mm, mm, degrees CCW)
+    float poseY;
+    float poseTheta;
+    float maxRangeCm;        ///< Tracker settings (see RD03D_TrackerConfig)
+    float maxAngleDeg;
+    float gateMm;
+    float alpha;
+    float beta;
+    uint8_t coastFrames;
+    uint8_t confirmFrames;
+    uint8_t reserved2[2];
+};
+
+enum RD03D_RegionType {
+    RD03D_REGION_ZONE = 1,      ///< Axis-aligned rectangle (x0,y0)-(x1,y1)
+    RD03D_REGION_TRIPWIRE = 2   ///< Line segment (x0,y0)-(x1,y1)
+};
+
+/**
+ * @brief Zone or tripwire, in mm in the site frame (after the pose)
+ */
+struct RD03D_ConfigRegion {
+    uint8_t type;            ///< RD03D_RegionType
+    uint8_t id;
+    uint16_t reserved;
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+};
+
+// ============== LOAD RESULT ==============
+enum RD03D_ConfigError {
+    RD03D_CONFIG_OK = 0,
+    RD03D_CONFIG_ERR_ALIGN,     ///< Blob not 4-byte aligned
+    RD03D_CONFIG_ERR_SIZE,      ///< Truncated, or totalSize disagrees with the buffer
+    RD03D_CONFIG_ERR_MAGIC,     ///< Not a config blob
+    RD03D_CONFIG_ERR_FORMAT,    ///< Written by an incompatible generator
+    RD03D_CONFIG_ERR_LAYOUT,    ///< Offsets or record sizes out of range
+    RD03D_CONFIG_ERR_CRC,       ///< Contents corrupted
+    RD03D_CONFIG_ERR_BUSY       ///< Previous update not swapped in yet
+};
+
+// ============== MAIN CLASS ==============
+/**
+ * @brief Read-only view of a validated config blob
+ *
+ * Holds only a pointer; the blob must stay in place (flash, static
+ * array or a caller buffer) for as long as the view is used.
+ */
+class RD03D_ConfigBlob {
+public:
+    /**
+     * @brief Constructor (empty, invalid view)
+     */
+    RD03D_ConfigBlob();
+
+    /**
+     * @brief Validate a blob and point the view at it
+     * @param data Blob bytes (4-byte aligned)
+     * @param size Size of the buffer holding the blob
+     * @return RD03D_CONFIG_OK, or the first check that failed (view is then invalid)
+     */
+    RD03D_ConfigError load(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Check if load() succeeded
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Get the site revision stored in the blob (0 if invalid)
+     */
+    uint32_t getVersion() const;
+
+    /**
+     * @brief Get the scalar settings, or nullptr if invalid
+     */
+    const RD03D_ConfigSettings* getSettings() const;
+
+    /**
+     * @brief Get the mounting pose
+     * @return false if invalid or the blob has no pose
+     */
+    bool getPose(RD03D_Pose& pose) const;
+
+    /**
+     * @brief Get tracker settings
+     * @return false if invalid or the blob has no tracker settings
+     */
+    bool getTrackerConfig(RD03D_TrackerConfig& config) const;
+
+    /**
+     * @brief Get number of zones and tripwires
+     */
+    uint16_t getRegionCount() const;
+
+    /**
+     * @brief Get a zone or tripwire by index, or nullptr if out of range
+     */
+    const RD03D_ConfigRegion* getRegion(uint16_t index) const;
+
+    /**
+     * @brief Build a blob into a caller buffer
+     *
+     * Used by the host generator; also usable on the device to turn
+     * settings received over the network into a blob.
+     * @return Blob size, or 0 if the buffer is too small
+     */
+    static size_t build(const RD03D_ConfigSettings& settings,
+                        const RD03D_ConfigRegion* regions, uint16_t regionCount,
+                        uint32_t configVersion, uint8_t* buffer, size_t size);
+
+    /**
+     * @brief CRC-32 (IEEE 802.3, as used by zlib)
+     */
+    static uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc = 0);
+
+private:
+    const uint8_t* _data;
+    const RD03D_ConfigHeader* _header;
+};
+
+// ============== HOT SWAP ==============
+/**
+ * @brief Double-buffered config updates for a running radar
+ *
+ * The radar reads the active buffer while a new blob is written into the
+ * other (shadow) buffer. commit() validates the shadow and stages it; the
+ * radar swaps at the start of its next frame, after which the old buffer
+ * becomes the shadow. Buffers are caller-owned, 4-byte aligned.
+ *
+ * @code
+ * alignas(4) uint8_t cfgA[512], cfgB[512];
+ * RD03D_ConfigShadow shadow(radar, cfgA, cfgB, sizeof(cfgA));
+ *
+ * // Network handler:
+ * shadow.stage(packet, packetLen);     // or write into getBuffer() and commit()
+ * @endcode
+ */
+class RD03D_ConfigShadow {
+public:
+    /**
+     * @brief Constructor
+     * @param radar Radar the configs are staged to
+     * @param bufferA First buffer
+     * @param bufferB Second buffer
+     * @param size Size of each buffer
+     */
+    RD03D_ConfigShadow(RD03D& radar, uint8_t* bufferA, uint8_t* bufferB, size_t size);
+
+    /**
+     * @brief Get the shadow buffer to write a new blob into
+     * @return Buffer, or nullptr while the previous update is pending
+     */
+    uint8_t* getBuffer();
+
+    /**
+     * @brief Get the size of each buffer
+     */
+    size_t getCapacity();
+
+    /**
+     * @brief Validate the blob in the shadow buffer and stage it
+     * @param len Bytes written to the shadow buffer
+     * @return RD03D_CONFIG_OK once staged, otherwise why it was rejected
+     */
+    RD03D_ConfigError commit(size_t len);
+
+    /**
+     * @brief Copy a complete blob into the shadow buffer and commit it
+     */
+    RD03D_ConfigError stage(const uint8_t* data, size_t len);
+
+private:
+    RD03D& _radar;
+    uint8_t* _buffers[2];
+    RD03D_ConfigBlob _views[2];
+    size_t _size;
+
+    uint8_t shadowIndex();
+};
+
+#endif // RD03D_CONFIG_H
@@ -0,0 +1,243 @@
+/**
+ * @file RD03D_Gesture.cpp
+ * @brief Implementation of the streaming DTW gesture recognizer
+ */
+
+#include "RD03D_Gesture.h"
+#include <string.h>
+
+#define RD03D_GESTURE_INF 1e30f
+
+// Built-in templates: from rest to about 1.5 m/s and back within 0.7 s
+// or more (100 ms samples), i.e. a brisk step or arm's-length swipe
+static const int8_t GESTURE_RAMP[7] = {0, 4, 11, 15, 11, 4, 0};
+static const int8_t GESTURE_ZERO[7] = {0, 0, 0, 0, 0, 0, 0};
+static const int8_t GESTURE_RAMP_NEG[7] = {0, -4, -11, -15, -11, -4, 0};
+#define RD03D_GESTURE_DEFAULT_THRESHOLD 6.0f
+
+RD03D_GestureRecognizer::RD03D_GestureRecognizer() {
+    _gestureCount = 0;
+    _callback = nullptr;
+    _eventCount = 0;
+    _abandonedCount = 0;
+    reset();
+}
+
+bool RD03D_GestureRecognizer::addDefaultGestures() {
+    if (_gestureCount + 4 > RD03D_MAX_GESTURES) return false;
+    addGesture("swipe_left", GESTURE_RAMP_NEG, GESTURE_ZERO, 7, RD03D_GESTURE_DEFAULT_THRESHOLD);
+    addGesture("swipe_right", GESTURE_RAMP, GESTURE_ZERO, 7, RD03D_GESTURE_DEFAULT_THRESHOLD);
+    addGesture("approach", GESTURE_ZERO, GESTURE_RAMP_NEG, 7, RD03D_GESTURE_DEFAULT_THRESHOLD);
+    addGesture("retreat", GESTURE_ZERO, GESTURE_RAMP, 7, RD03D_GESTURE_DEFAULT_THRESHOLD);
+    return true;
+}
+
+int8_t RD03D_GestureRecognizer::addGesture(const char* name, const int8_t* vx, const int8_t* vy,
+                                           uint8_t length, float threshold) {
+    if (_gestureCount >= RD03D_MAX_GESTURES || !vx || !vy) return -1;
+    if (length == 0 || length > RD03D_GESTURE_MAX_LEN || threshold <= 0.0f) return -1;
+
+    uint8_t index = _gestureCount++;
+    Gesture& g = _gestures[index];
+    g.name = name;
+    memcpy(g.vx, vx, length);
+    memcpy(g.vy, vy, length);
+    g.length = length;
+    g.threshold = threshold * length;
+
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        clearColumn(_columns[i][index]);
+    }
+    return index;
+}
+
+void RD03D_GestureRecognizer::onGesture(RD03D_GestureCallback callback) {
+    _callback = callback;
+}
+
+uint8_t RD03D_GestureRecognizer::update(RD03D_Tracker& tracker, uint32_t now) {
+    uint8_t events = 0;
+
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        const RD03D_Track* t = tracker.getTrack(i);
+
+        // A new track in this slot starts from scratch
+        uint16_t id = t->active ? t->id : 0;
+        if (id != _trackIds[i]) {
+            restart(i);
+            _trackIds[i] = id;
+        }
+
+        // Coasting tracks only have a predicted velocity; skip them
+        if (!t->isValid() || t->missed > 0) continue;
+
+        float x = constrain(t->vx / RD03D_GESTURE_UNIT, -RD03D_GESTURE_MAX_SPEED, RD03D_GESTURE_MAX_SPEED);
+        float y = constrain(t->vy / RD03D_GESTURE_UNIT, -RD03D_GESTURE_MAX_SPEED, RD03D_GESTURE_MAX_SPEED);
+
+        // Too long without a detection to say how it moved in between
+        if (_sampling[i] && now - _lastTime[i] > RD03D_GESTURE_MAX_GAP) restart(i);
+        if (!_sampling[i]) {
+            _sampling[i] = true;
+            _lastTime[i] = now;
+            _lastVx[i] = x;
+            _lastVy[i] = y;
+            _nextSample[i] = now + RD03D_GESTURE_STEP_MS;
+            continue;
+        }
+        uint32_t t0 = _lastTime[i];
+        if (now == t0) continue;
+
+        // Velocity is taken as linear between updates; each step's sample
+        // is its mean over the step, so any frame rate gives the same grid
+        float span = (float)(now - t0);
+        uint32_t from = t0;
+        float fx = _lastVx[i];
+        float fy = _lastVy[i];
+        while ((int32_t)(now - _nextSample[i]) >= 0) {
+            uint32_t ts = _nextSample[i];
+            float f = (ts - t0) / span;
+            float sx = _lastVx[i] + (x - _lastVx[i]) * f;
+            float sy = _lastVy[i] + (y - _lastVy[i]) * f;
+            _sumX[i] += (fx + sx) * 0.5f * (ts - from);
+            _sumY[i] += (fy + sy) * 0.5f * (ts - from);
+
+            events += sample(i, ts, now, _sumX[i] / RD03D_GESTURE_STEP_MS, _sumY[i] / RD03D_GESTURE_STEP_MS);
+
+            _sumX[i] = 0.0f;
+            _sumY[i] = 0.0f;
+            from = ts;
+            fx = sx;
+            fy = sy;
+            _nextSample[i] = ts + RD03D_GESTURE_STEP_MS;
+        }
+        _sumX[i] += (fx + x) * 0.5f * (now - from);
+        _sumY[i] += (fy + y) * 0.5f * (now - from);
+        _lastTime[i] = now;
+        _lastVx[i] = x;
+        _lastVy[i] = y;
+    }
+    return events;
+}
+
+uint8_t RD03D_GestureRecognizer::sample(uint8_t slot, uint32_t time, uint32_t now, float x, float y) {
+    if (_hold[slot] > 0) {
+        _hold[slot]--;
+        return 0;
+    }
+
+    for (uint8_t g = 0; g < _gestureCount; g++) {
+        RD03D_GestureEvent event;
+        if (!step(_columns[slot][g], _gestures[g], time, x, y, event)) continue;
+
+        event.gesture = g;
+        event.trackId = _trackIds[slot];
+        event.time = now;
+        _eventCount++;
+        if (_callback) _callback(event);
+
+        // One gesture at a time: the tail of this one must not start another
+        for (uint8_t k = 0; k < _gestureCount; k++) {
+            clearColumn(_columns[slot][k]);
+        }
+        _hold[slot] = _gestures[g].length;
+        return 1;
+    }
+    return 0;
+}
+
+bool RD03D_GestureRecognizer::step(Column& c, const Gesture& g, uint32_t time, float x, float y,
+                                   RD03D_GestureEvent& event) {
+    uint8_t m = g.length;
+    uint32_t maxSpan = (uint32_t)m * RD03D_GESTURE_MAX_WARP * RD03D_GESTURE_STEP_MS;
+
+    // Each sample either advances one template sample (diagonal) or stays
+    // on the same one (up). Samples are never skipped and one sample never
+    // covers several template samples, so a match takes at least m steps.
+    // Row 0 is free: an alignment may start at any sample.
+    float diag = 0.0f;
+    uint32_t diagStart = time;
+    uint8_t reach = 0;
+
+    for (uint8_t j = 1; j <= m; j++) {
+        // Past the old frontier: neither predecessor is live, nor will any
+        // cell further along be
+        if (j > c.reach + 1) {
+            _abandonedCount += m - j + 1;
+            break;
+        }
+
+        float up = c.cost[j];
+        uint32_t upStart = c.start[j];
+
+        float best = diag;
+        uint32_t start = diagStart;
+        if (up < best) {
+            best = up;
+            start = upStart;
+        }
+
+        float cost = best + distance(x, g.vx[j - 1]) + distance(y, g.vy[j - 1]);
+        if (cost > g.threshold || time - start >= maxSpan) cost = RD03D_GESTURE_INF;
+
+        diag = up;
+        diagStart = upStart;
+        c.cost[j] = cost;
+        c.start[j] = start;
+        if (cost < RD03D_GESTURE_INF) reach = j;
+    }
+    c.reach = reach;
+
+    // The whole template aligned within the threshold, ending on this sample
+    if (c.cost[m] >= RD03D_GESTURE_INF) return false;
+    event.cost = c.cost[m] / m;
+    event.duration = (uint16_t)(time - c.start[m] + RD03D_GESTURE_STEP_MS);
+    return true;
+}
+
+// Squared, so one badly off sample (e.g. still moving where the template
+// has stopped) outweighs several slightly off ones
+float RD03D_GestureRecognizer::distance(float v, int8_t t) {
+    float d = fabsf(v - t) - RD03D_GESTURE_DEADBAND;
+    return d > 0.0f ? d * d : 0.0f;
+}
+
+void RD03D_GestureRecognizer::restart(uint8_t slot) {
+    for (uint8_t g = 0; g < RD03D_MAX_GESTURES; g++) {
+        clearColumn(_columns[slot][g]);
+    }
+    _hold[slot] = 0;
+    _sampling[slot] = false;
+    _sumX[slot] = 0.0f;
+    _sumY[slot] = 0.0f;
+}
+
+void RD03D_GestureRecognizer::clearColumn(Column& c) {
+    for (uint8_t j = 0; j <= RD03D_GESTURE_MAX_LEN; j++) {
+        c.cost[j] = RD03D_GESTURE_INF;
+        c.start[j] = 0;
+    }
+    c.reach = 0;
+}
+
+const char* RD03D_GestureRecognizer::getName(uint8_t gesture) {
+    return (gesture < _gestureCount) ? _gestures[gesture].name : nullptr;
+}
+
+uint8_t RD03D_GestureRecognizer::getGestureCount() {
+    return _gestureCount;
+}
+
+uint32_t RD03D_GestureRecognizer::getEventCount() {
+    return _eventCount;
+}
+
+uint32_t RD03D_GestureRecognizer::getAbandonedCount() {
+    return _abandonedCount;
+}
+
+void RD03D_GestureRecognizer::reset() {
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        _trackIds[i] = 0;
+        restart(i);
+    }
+}
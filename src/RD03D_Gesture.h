@@ -0,0 +1,194 @@
+/**
+ * @file RD03D_Gesture.h
+ * @brief On-device gesture recognition on track trajectories
+ *
+ * Every confirmed track's velocity is resampled onto a fixed time grid
+ * (one sample per RD03D_GESTURE_STEP_MS, averaged over the step) and
+ * matched against gesture templates with streaming subsequence DTW: one
+ * column of the DTW matrix per track and template is updated per
+ * sample, so a gesture is recognised on the frame that completes it,
+ * with no window buffering and no network round trip. Templates are
+ * therefore independent of the radar's frame rate (20-50 Hz, or lower
+ * when the callback is throttled). Cells whose cost already exceeds the
+ * threshold are abandoned, so a quiet room costs almost nothing.
+ *
+ * Built-in gestures (addDefaultGestures()) are short stop-go-stop moves:
+ * swipe left/right (along X) and approach/retreat (along Y). Walking
+ * through at a steady speed does not match them.
+ *
+ * @code
+ * RD03D_Tracker tracker;
+ * RD03D_GestureRecognizer gestures;
+ *
+ * void onGesture(const RD03D_GestureEvent& e) {
+ *     Serial.printf("%s by track %u\n", gestures.getName(e.gesture), e.trackId);
+ * }
+ *
+ * void onRadarData(RD03D_Target* targets, uint8_t count) {
+ *     tracker.update(targets, millis());
+ *     gestures.update(tracker, millis());
+ * }
+ *
+ * void setup() {
+ *     gestures.addDefaultGestures();
+ *     gestures.onGesture(onGesture);
+ * }
+ * @endcode
+ */
+
+#ifndef RD03D_GESTURE_H
+#define RD03D_GESTURE_H
+
+#include "RD03D.h"
+#include "RD03D_Tracker.h"
+
+// ============== CONFIGURATION ==============
+#define RD03D_MAX_GESTURES        8
+#define RD03D_GESTURE_MAX_LEN     16    // Samples per template
+#define RD03D_GESTURE_STEP_MS     100   // Time between template samples
+#define RD03D_GESTURE_MAX_GAP     500   // ms without a detection before a track's matching restarts
+#define RD03D_GESTURE_UNIT        100.0f  // mm/s per template unit
+#define RD03D_GESTURE_MAX_SPEED   30    // Velocities are clamped to ±this many units
+#define RD03D_GESTURE_DEADBAND    1.0f  // Per-axis differences below this many units cost nothing
+#define RD03D_GESTURE_MAX_WARP    3     // A match may span at most this many times the template duration
+
+// ============== GESTURE TYPES ==============
+enum RD03D_GestureType {
+    RD03D_GESTURE_SWIPE_LEFT = 0,   ///< Quick move towards -X and stop
+    RD03D_GESTURE_SWIPE_RIGHT,      ///< Quick move towards +X and stop
+    RD03D_GESTURE_APPROACH,         ///< Quick step towards the radar and stop
+    RD03D_GESTURE_RETREAT           ///< Quick step away from the radar and stop
+};
+
+// ============== EVENT ==============
+/**
+ * @brief A recognised gesture
+ */
+struct RD03D_GestureEvent {
+    uint8_t gesture;     ///< Gesture index (RD03D_GestureType for the built-ins)
+    uint16_t trackId;    ///< Track that made the gesture
+    float cost;          ///< Mean DTW cost per template sample (lower = closer match)
+    uint16_t duration;   ///< Time the gesture took (ms)
+    uint32_t time;       ///< Time of the completing frame (ms)
+};
+
+/**
+ * @brief Callback function type for gesture events
+ */
+typedef void (*RD03D_GestureCallback)(const RD03D_GestureEvent& event);
+
+// ============== MAIN CLASS ==============
+class RD03D_GestureRecognizer {
+public:
+    /**
+     * @brief Constructor (no gestures; see addDefaultGestures())
+     */
+    RD03D_GestureRecognizer();
+
+    /**
+     * @brief Add swipe left/right and approach/retreat as gestures 0-3
+     * @return false if there is no room for them
+     */
+    bool addDefaultGestures();
+
+    /**
+     * @brief Add a gesture template
+     *
+     * Templates are velocities in units of RD03D_GESTURE_UNIT (100 mm/s),
+     * one sample per RD03D_GESTURE_STEP_MS whatever the frame rate.
+     * @param name Name for getName() (string must outlive the recognizer)
+     * @param vx X velocity per sample
+     * @param vy Y velocity per sample
+     * @param length Samples (1 to RD03D_GESTURE_MAX_LEN)
+     * @param threshold Largest mean cost per sample that counts as a match
+     *        (cost is the squared per-axis difference beyond
+     *        RD03D_GESTURE_DEADBAND, in units; the built-ins use 6)
+     * @return Gesture index, or -1 if full or invalid
+     */
+    int8_t addGesture(const char* name, const int8_t* vx, const int8_t* vy, uint8_t length, float threshold);
+
+    /**
+     * @brief Set callback for recognised gestures
+     */
+    void onGesture(RD03D_GestureCallback callback);
+
+    /**
+     * @brief Feed the tracker's state after each tracker update
+     *
+     * Frames need not be evenly spaced: each track's velocity is
+     * interpolated between updates and averaged over every
+     * RD03D_GESTURE_STEP_MS step that ends by now.
+     * @param tracker Tracker that was just updated
+     * @param now Frame time in ms (the time passed to tracker.update())
+     * @return Number of gestures recognised on this frame
+     */
+    uint8_t update(RD03D_Tracker& tracker, uint32_t now);
+
+    /**
+     * @brief Get a gesture's name, or nullptr if index invalid
+     */
+    const char* getName(uint8_t gesture);
+
+    /**
+     * @brief Get number of gesture templates
+     */
+    uint8_t getGestureCount();
+
+    /**
+     * @brief Get total gestures recognised
+     */
+    uint32_t getEventCount();
+
+    /**
+     * @brief Get DTW cells skipped by early abandoning
+     */
+    uint32_t getAbandonedCount();
+
+    /**
+     * @brief Forget all partial matches (templates are kept)
+     */
+    void reset();
+
+private:
+    struct Gesture {
+        const char* name;
+        int8_t vx[RD03D_GESTURE_MAX_LEN];
+        int8_t vy[RD03D_GESTURE_MAX_LEN];
+        uint8_t length;
+        float threshold;    // Total cost over the template
+    };
+
+    // DTW column for one track and one gesture: cost and start time of
+    // the best alignment ending at each template sample
+    struct Column {
+        float cost[RD03D_GESTURE_MAX_LEN + 1];
+        uint32_t start[RD03D_GESTURE_MAX_LEN + 1];
+        uint8_t reach;      // Highest sample with a live alignment
+    };
+
+    Gesture _gestures[RD03D_MAX_GESTURES];
+    uint8_t _gestureCount;
+    Column _columns[RD03D_MAX_TRACKS][RD03D_MAX_GESTURES];
+    uint16_t _trackIds[RD03D_MAX_TRACKS];   // Track each slot's columns belong to
+    uint8_t _hold[RD03D_MAX_TRACKS];        // Samples to skip before the slot may match again
+
+    // Resampling onto the template grid, per slot
+    bool _sampling[RD03D_MAX_TRACKS];       // Velocity seen since the last restart
+    uint32_t _lastTime[RD03D_MAX_TRACKS];   // Time of the last velocity taken in
+    float _lastVx[RD03D_MAX_TRACKS];        // Velocity then, in template units
+    float _lastVy[RD03D_MAX_TRACKS];
+    uint32_t _nextSample[RD03D_MAX_TRACKS]; // End of the step being averaged
+    float _sumX[RD03D_MAX_TRACKS];          // Velocity integrated over the step so far (units * ms)
+    float _sumY[RD03D_MAX_TRACKS];
+    RD03D_GestureCallback _callback;
+    uint32_t _eventCount;
+    uint32_t _abandonedCount;
+
+    static float distance(float v, int8_t t);
+    void clearColumn(Column& c);
+    void restart(uint8_t slot);
+    uint8_t sample(uint8_t slot, uint32_t time, uint32_t now, float x, float y);
+    bool step(Column& c, const Gesture& g, uint32_t time, float x, float y, RD03D_GestureEvent& event);
+};
+
+#endif // RD03D_GESTURE_H
@@ -0,0 +1,78 @@
+/**
+ * @file RD03D_Input.cpp
+ * @brief Implementation of the SPSC ring input source
+ */
+
+#include "RD03D_Input.h"
+#include <string.h>
+
+RD03D_RingSource::RD03D_RingSource(uint8_t* storage, size_t capacity) {
+    _buffer = storage;
+    _capacity = storage ? capacity : 0;
+    _head = 0;
+    _tail = 0;
+    _overflow = 0;
+}
+
+size_t RD03D_RingSource::write(const uint8_t* data, size_t len) {
+    if (_capacity < 2) return 0;
+
+    size_t head = _head;
+    size_t tail = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+    size_t used = (head >= tail) ? head - tail : head + _capacity - tail;
+    size_t space = _capacity - 1 - used;
+
+    size_t n = (len < space) ? len : space;
+    _overflow += (uint32_t)(len - n);
+
+    // Up to the end of the buffer, then from the start
+    size_t first = _capacity - head;
+    if (first > n) first = n;
+    memcpy(_buffer + head, data, first);
+    memcpy(_buffer, data + first, n - first);
+
+    head += n;
+    if (head >= _capacity) head -= _capacity;
+    __atomic_store_n(&_head, head, __ATOMIC_RELEASE);
+    return n;
+}
+
+uint8_t RD03D_RingSource::peek(RD03D_Span spans[2]) {
+    size_t head = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+    size_t tail = _tail;
+    if (head == tail) return 0;
+
+    spans[0].data = _buffer + tail;
+    if (head > tail) {
+        spans[0].len = head - tail;
+        return 1;
+    }
+    spans[0].len = _capacity - tail;
+    if (head == 0) return 1;
+    spans[1].data = _buffer;
+    spans[1].len = head;
+    return 2;
+}
+
+void RD03D_RingSource::consume(size_t n) {
+    size_t avail = available();
+    if (n > avail) n = avail;
+
+    size_t tail = _tail + n;
+    if (tail >= _capacity) tail -= _capacity;
+    __atomic_store_n(&_tail, tail, __ATOMIC_RELEASE);
+}
+
+size_t RD03D_RingSource::available() {
+    size_t head = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+    size_t tail = _tail;
+    return (head >= tail) ? head - tail : head + _capacity - tail;
+}
+
+size_t RD03D_RingSource::getCapacity() {
+    return _capacity > 0 ? _capacity - 1 : 0;
+}
+
+uint32_t RD03D_RingSource::getOverflowCount() {
+    return _overflow;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file RD03D_Input.h
+ * @brief Zero-copy input sources for the RD03D parser
+ *
+ * update(HardwareSerial) has to read() the UART into a chunk before
+ * parsing it. A source that can expose its own buffer instead offers
+ * peek() (up to two contiguous spans, two when the data wraps) and
+ * consume(n), and update(source) decodes frames directly from those
+ * spans. Only a frame that straddles the wrap is copied, byte by byte,
+ * into the parser's 30-byte frame buffer.
+ *
+ * RD03D_RingSource is a single-producer/single-consumer byte ring over
+ * caller storage, filled from a UART receive callback, a DMA handler or
+ * a network tunnel:
+ *
+ * @code
+ * uint8_t ringStorage[2048];
+ * RD03D_RingSource ring(ringStorage, sizeof(ringStorage));
+ *
+ * void onUartData() {                     // Serial1.onReceive(onUartData)
+ *     uint8_t buf[64];
+ *     size_t n = Serial1.read(buf, sizeof(buf));
+ *     ring.write(buf, n);
+ * }
+ *
+ * void loop() {
+ *     radar.update(ring);
+ * }
+ * @endcode
+ */
+
+#ifndef RD03D_INPUT_H
+#define RD03D_INPUT_H
+
+#include "RD03D.h"
+
+// ============== SPAN ==============
+/**
+ * @brief Contiguous run of readable bytes owned by a source
+ */
+struct RD03D_Span {
+    const uint8_t* data;
+    size_t len;
+};
+
+// ============== SOURCE INTERFACE ==============
+/**
+ * @brief Byte source the parser can read without copying
+ */
+class RD03D_InputSource {
+public:
+    virtual ~RD03D_InputSource() {}
+
+    /**
+     * @brief Get the readable bytes in place
+     * @param spans Receives up to two spans, oldest first
+     * @return Number of spans filled (0-2); they stay valid until consume()
+     */
+    virtual uint8_t peek(RD03D_Span spans[2]) = 0;
+
+    /**
+     * @brief Release the first n bytes returned by peek()
+     */
+    virtual void consume(size_t n) = 0;
+
+    /**
+     * @brief Get the number of readable bytes
+     */
+    virtual size_t available() = 0;
+};
+
+// ============== RING SOURCE ==============
+/**
+ * @brief Lock-free SPSC byte ring implementing RD03D_InputSource
+ *
+ * One context calls write(), one other context calls peek()/consume().
+ * Holds capacity - 1 bytes.
+ */
+class RD03D_RingSource : public RD03D_InputSource {
+public:
+    /**
+     * @brief Constructor
+     * @param storage Caller-owned buffer
+     * @param capacity Size of storage in bytes
+     */
+    RD03D_RingSource(uint8_t* storage, size_t capacity);
+
+    /**
+     * @brief Append bytes (producer side)
+     * @return Bytes accepted; the rest are dropped and counted as overflow
+     */
+    size_t write(const uint8_t* data, size_t len);
+
+    uint8_t peek(RD03D_Span spans[2]) override;
+    void consume(size_t n) override;
+    size_t available() override;
+
+    /**
+     * @brief Get the number of bytes the ring can hold
+     */
+    size_t getCapacity();
+
+    /**
+     * @brief Get bytes dropped because the ring was full
+     */
+    uint32_t getOverflowCount();
+
+private:
+    uint8_t* _buffer;
+    size_t _capacity;
+    size_t _head;       // Next write position (producer)
+    size_t _tail;       // Next read position (consumer)
+    uint32_t _overflow;
+};
+
+#endif // RD03D_INPUT_H
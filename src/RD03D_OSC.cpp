@@ -0,0 +1,103 @@
+/**
+ * @file RD03D_OSC.cpp
+ * @brief Implementation of the allocation-free OSC encoder
+ */
+
+#include "RD03D_OSC.h"
+
+RD03D_OSCEncoder::RD03D_OSCEncoder() {
+    setPrefix("/radar");
+}
+
+void RD03D_OSCEncoder::setPrefix(const char* prefix) {
+    strncpy(_prefix, prefix, RD03D_OSC_MAX_PREFIX - 1);
+    _prefix[RD03D_OSC_MAX_PREFIX - 1] = '\0';
+    _prefixLen = strlen(_prefix);
+}
+
+size_t RD03D_OSCEncoder::encodeTarget(uint8_t index, const RD03D_Target& target, uint8_t* buffer, size_t size) {
+    char suffix[4] = {'/', (char)('1' + index), '\0', '\0'};
+    size_t len = beginMessage(suffix, ",iiffi", buffer, size);
+    if (len == 0 || len + 20 > size) return 0;
+
+    putInt(target.x, buffer + len);
+    putInt(target.y, buffer + len + 4);
+    putFloat(target.distance, buffer + len + 8);
+    putFloat(target.angle, buffer + len + 12);
+    putInt(target.speed, buffer + len + 16);
+    return len + 20;
+}
+
+size_t RD03D_OSCEncoder::encodeCount(uint8_t count, uint8_t* buffer, size_t size) {
+    size_t len = beginMessage("/count", ",i", buffer, size);
+    if (len == 0 || len + 4 > size) return 0;
+
+    putInt(count, buffer + len);
+    return len + 4;
+}
+
+size_t RD03D_OSCEncoder::encodeBundle(const RD03D_Target* targets, uint8_t* buffer, size_t size) {
+    // "#bundle" + time tag 1 (immediately)
+    size_t len = putString("#bundle", buffer, size);
+    if (len == 0 || len + 8 > size) return 0;
+    memset(buffer + len, 0, 7);
+    buffer[len + 7] = 1;
+    len += 8;
+
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+        if (!targets[i].valid) continue;
+        count++;
+        if (len + 4 > size) return 0;
+        size_t n = encodeTarget(i, targets[i], buffer + len + 4, size - len - 4);
+        if (n == 0) return 0;
+        putInt((int32_t)n, buffer + len);
+        len += 4 + n;
+    }
+
+    if (len + 4 > size) return 0;
+    size_t n = encodeCount(count, buffer + len + 4, size - len - 4);
+    if (n == 0) return 0;
+    putInt((int32_t)n, buffer + len);
+    return len + 4 + n;
+}
+
+size_t RD03D_OSCEncoder::beginMessage(const char* suffix, const char* typeTags, uint8_t* buffer, size_t size) {
+    // Address = prefix + suffix, null-terminated and padded to 4 bytes
+    size_t suffixLen = strlen(suffix);
+    size_t addrLen = _prefixLen + suffixLen;
+    size_t padded = (addrLen + 4) & ~(size_t)3;
+    if (padded > size) return 0;
+
+    memcpy(buffer, _prefix, _prefixLen);
+    memcpy(buffer + _prefixLen, suffix, suffixLen);
+    memset(buffer + addrLen, 0, padded - addrLen);
+
+    size_t tagLen = putString(typeTags, buffer + padded, size - padded);
+    if (tagLen == 0) return 0;
+    return padded + tagLen;
+}
+
+size_t RD03D_OSCEncoder::putString(const char* s, uint8_t* buffer, size_t size) {
+    size_t len = strlen(s);
+    size_t padded = (len + 4) & ~(size_t)3;
+    if (padded > size) return 0;
+    memcpy(buffer, s, len);
+    memset(buffer + len, 0, padded - len);
+    return padded;
+}
+
+void RD03D_OSCEncoder::putInt(int32_t v, uint8_t* out) {
+    // OSC is big-endian
+    uint32_t u = (uint32_t)v;
+    out[0] = (u >> 24) & 0xFF;
+    out[1] = (u >> 16) & 0xFF;
+    out[2] = (u >> 8) & 0xFF;
+    out[3] = u & 0xFF;
+}
+
+void RD03D_OSCEncoder::putFloat(float v, uint8_t* out) {
+    uint32_t u;
+    memcpy(&u, &v, sizeof(u));
+    putInt((int32_t)u, out);
+}
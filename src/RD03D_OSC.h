@@ -0,0 +1,84 @@
+/**
+ * @file RD03D_OSC.h
+ * @brief Allocation-free OSC encoder for RD-03D targets
+ *
+ * Builds the same OSC messages as the OSC examples directly into a
+ * caller-supplied buffer, without the heap allocations of OSCMessage:
+ *
+ *   <prefix>/1      (x, y, distance, angle, speed)  - ints/floats
+ *   <prefix>/count  (count)
+ *
+ * The default prefix is "/radar". A whole frame can also be packed into a
+ * single OSC bundle so it fits in one UDP datagram.
+ *
+ * @code
+ * RD03D_OSCEncoder osc;
+ * uint8_t packet[RD03D_OSC_MAX_BUNDLE];
+ *
+ * void onRadarData(RD03D_Target* targets, uint8_t count) {
+ *     size_t len = osc.encodeBundle(targets, packet, sizeof(packet));
+ *     udp.beginPacket(ip, port);
+ *     udp.write(packet, len);
+ *     udp.endPacket();
+ * }
+ * @endcode
+ */
+
+#ifndef RD03D_OSC_H
+#define RD03D_OSC_H
+
+#include "RD03D.h"
+
+// ============== CONFIGURATION ==============
+#define RD03D_OSC_MAX_PREFIX   32    // Including terminator
+#define RD03D_OSC_MAX_MESSAGE  64    // Largest single message (target with max prefix)
+#define RD03D_OSC_MAX_BUNDLE   (16 + (RD03D_MAX_TARGETS + 1) * (4 + RD03D_OSC_MAX_MESSAGE))
+
+// ============== MAIN CLASS ==============
+class RD03D_OSCEncoder {
+public:
+    /**
+     * @brief Constructor (prefix "/radar")
+     */
+    RD03D_OSCEncoder();
+
+    /**
+     * @brief Set the address prefix (e.g. "/radar" or "/room2/radar")
+     * @param prefix Null-terminated address, truncated to fit
+     */
+    void setPrefix(const char* prefix);
+
+    /**
+     * @brief Encode "<prefix>/<index+1>" with x, y, distance, angle, speed
+     * @param index Target index (0-2)
+     * @param target Target to encode
+     * @param buffer Output buffer
+     * @param size Size of output buffer
+     * @return Message length in bytes, or 0 if it does not fit
+     */
+    size_t encodeTarget(uint8_t index, const RD03D_Target& target, uint8_t* buffer, size_t size);
+
+    /**
+     * @brief Encode "<prefix>/count" with the number of valid targets
+     * @return Message length in bytes, or 0 if it does not fit
+     */
+    size_t encodeCount(uint8_t count, uint8_t* buffer, size_t size);
+
+    /**
+     * @brief Encode a bundle with every valid target and the count
+     * @param targets Array of RD03D_MAX_TARGETS targets
+     * @return Bundle length in bytes, or 0 if it does not fit
+     */
+    size_t encodeBundle(const RD03D_Target* targets, uint8_t* buffer, size_t size);
+
+private:
+    char _prefix[RD03D_OSC_MAX_PREFIX];
+    uint8_t _prefixLen;
+
+    size_t beginMessage(const char* suffix, const char* typeTags, uint8_t* buffer, size_t size);
+    static size_t putString(const char* s, uint8_t* buffer, size_t size);
+    static void putInt(int32_t v, uint8_t* out);
+    static void putFloat(float v, uint8_t* out);
+};
+
+#endif // RD03D_OSC_H
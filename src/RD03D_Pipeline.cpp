@@ -0,0 +1,71 @@
+/**
+ * @file RD03D_Pipeline.cpp
+ * @brief Dynamic pipeline and built-in stage constructors
+ */
+
+#include "RD03D_Pipeline.h"
+
+// ============== DYNAMIC PIPELINE ==============
+RD03D_DynamicPipeline::RD03D_DynamicPipeline() {
+    _frame = 0;
+    clear();
+}
+
+bool RD03D_DynamicPipeline::add(RD03D_Stage* stage) {
+    if (!stage || _count >= RD03D_MAX_DYNAMIC_STAGES) return false;
+    _stages[_count] = stage;
+    _timing[_count].clear();
+    _timing[_count].name = stage->name();
+    _count++;
+    return true;
+}
+
+void RD03D_DynamicPipeline::clear() {
+    _count = 0;
+}
+
+bool RD03D_DynamicPipeline::process(RD03D_Target* targets, uint8_t count) {
+    RD03D_FrameContext ctx;
+    ctx.targets = targets;
+    ctx.count = count;
+    ctx.now = millis();
+    ctx.frame = _frame++;
+    ctx.tracker = nullptr;
+
+    for (uint8_t i = 0; i < _count; i++) {
+        if (!rd03dRunStage(*_stages[i], ctx, _timing[i])) return false;
+    }
+    return true;
+}
+
+const RD03D_StageTiming* RD03D_DynamicPipeline::getTiming(uint8_t index) {
+    return (index < _count) ? &_timing[index] : nullptr;
+}
+
+uint8_t RD03D_DynamicPipeline::getStageCount() {
+    return _count;
+}
+
+void RD03D_DynamicPipeline::resetStats() {
+    for (uint8_t i = 0; i < _count; i++) {
+        _timing[i].clear();
+        _timing[i].name = _stages[i]->name();
+    }
+}
+
+// ============== BUILT-IN STAGES ==============
+RD03D_ValidateStage::RD03D_ValidateStage(float maxRangeCm, float maxAngleDeg, bool keepEmpty) {
+    _maxRangeCm = maxRangeCm;
+    _maxAngleDeg = maxAngleDeg;
+    _keepEmpty = keepEmpty;
+}
+
+RD03D_PoseStage::RD03D_PoseStage(const RD03D_Pose& pose) : _pose(pose) {}
+
+RD03D_TrackStage::RD03D_TrackStage(RD03D_Tracker& tracker) : _tracker(tracker) {}
+
+RD03D_CallbackStage::RD03D_CallbackStage(const char* name, RD03D_FrameCallback callback) {
+    _name = name;
+    _callback = callback;
+}
+
@@ -0,0 +1,362 @@
+/**
+ * @file RD03D_Pipeline.h
+ * @brief Composable per-frame processing stages
+ *
+ * A stage is any class with
+ *
+ *   bool process(RD03D_FrameContext& ctx);   // false stops the frame here
+ *   const char* name() const;
+ *
+ * RD03D_Pipeline<...> chains stages at compile time: every call is to a
+ * known type, so the whole chain inlines into one function with no
+ * indirect calls. The built-in stages define process() here in the
+ * header so this holds without link-time optimisation; user stages
+ * should do the same. RD03D_DynamicPipeline chains RD03D_Stage pointers at
+ * run time for hosts that assemble the pipeline from configuration.
+ * Both keep per-stage timing and counters.
+ *
+ * @code
+ * RD03D radar;
+ * RD03D_Tracker tracker;
+ *
+ * RD03D_ValidateStage validate(600, 55);
+ * RD03D_TrackStage track(tracker);
+ * PrintStage print;                        // user stage
+ *
+ * RD03D_Pipeline<RD03D_ValidateStage, RD03D_TrackStage, PrintStage>
+ *     pipeline(validate, track, print);
+ *
+ * void onRadarFrame(RD03D_Target* targets, uint8_t count) {
+ *     pipeline.process(targets, count);
+ * }
+ * @endcode
+ */
+
+#ifndef RD03D_PIPELINE_H
+#define RD03D_PIPELINE_H
+
+#include "RD03D.h"
+#include "RD03D_Pose.h"
+#include "RD03D_Tracker.h"
+
+// ============== CONFIGURATION ==============
+#ifndef RD03D_PIPELINE_TIMING
+#define RD03D_PIPELINE_TIMING      1     // 0 = counters only, no micros() calls
+#endif
+#define RD03D_MAX_DYNAMIC_STAGES   8
+
+// ============== FRAME CONTEXT ==============
+/**
+ * @brief Data handed from stage to stage for one frame
+ */
+struct RD03D_FrameContext {
+    RD03D_Target* targets;    ///< RD03D_MAX_TARGETS targets (stages may modify)
+    uint8_t count;            ///< Number of valid targets
+    uint32_t now;             ///< Frame time (millis())
+    uint32_t frame;           ///< Frame number within this pipeline
+    RD03D_Tracker* tracker;   ///< Set by RD03D_TrackStage, nullptr before it
+};
+
+// ============== STAGE TIMING ==============
+/**
+ * @brief Counters kept for every stage
+ */
+struct RD03D_StageTiming {
+    const char* name;     ///< Stage name
+    uint32_t runs;        ///< Frames the stage processed
+    uint32_t stops;       ///< Frames the stage stopped (process() returned false)
+    uint32_t avgMicros;   ///< Smoothed cost per run
+    uint32_t maxMicros;   ///< Worst cost seen
+
+    void clear() {
+        runs = 0;
+        stops = 0;
+        avgMicros = 0;
+        maxMicros = 0;
+    }
+
+    /**
+     * @brief Account for one run
+     */
+    void record(uint32_t cost, bool stopped) {
+        avgMicros = (runs == 0) ? cost : avgMicros + ((int32_t)cost - (int32_t)avgMicros) / 8;
+        if (cost > maxMicros) maxMicros = cost;
+        runs++;
+        if (stopped) stops++;
+    }
+};
+
+/**
+ * @brief Run one stage with timing (shared by both pipeline kinds)
+ */
+template <typename Stage>
+inline bool rd03dRunStage(Stage& stage, RD03D_FrameContext& ctx, RD03D_StageTiming& timing) {
+#if RD03D_PIPELINE_TIMING
+    uint32_t start = micros();
+    bool ok = stage.process(ctx);
+    timing.record(micros() - start, !ok);
+#else
+    bool ok = stage.process(ctx);
+    timing.record(0, !ok);
+#endif
+    return ok;
+}
+
+// ============== STATIC PIPELINE ==============
+/**
+ * @brief Compile-time chain of stages (implementation detail of RD03D_Pipeline)
+ */
+template <typename... Stages>
+class RD03D_StageChain;
+
+template <>
+class RD03D_StageChain<> {
+public:
+    void names(RD03D_StageTiming* timing) { (void)timing; }
+    bool run(RD03D_FrameContext& ctx, RD03D_StageTiming* timing) {
+        (void)ctx;
+        (void)timing;
+        return true;
+    }
+};
+
+template <typename First, typename... Rest>
+class RD03D_StageChain<First, Rest...> {
+public:
+    RD03D_StageChain(First& first, Rest&... rest) : _stage(first), _rest(rest...) {}
+
+    void names(RD03D_StageTiming* timing) {
+        timing->name = _stage.name();
+        _rest.names(timing + 1);
+    }
+
+    bool run(RD03D_FrameContext& ctx, RD03D_StageTiming* timing) {
+        if (!rd03dRunStage(_stage, ctx, *timing)) return false;
+        return _rest.run(ctx, timing + 1);
+    }
+
+private:
+    First& _stage;
+    RD03D_StageChain<Rest...> _rest;
+};
+
+/**
+ * @brief Pipeline composed at compile time
+ *
+ * Stages are held by reference and must outlive the pipeline.
+ */
+template <typename... Stages>
+class RD03D_Pipeline {
+public:
+    static const uint8_t STAGE_COUNT = sizeof...(Stages);
+
+    /**
+     * @brief Constructor
+     * @param stages Stage objects, in processing order
+     */
+    RD03D_Pipeline(Stages&... stages) : _chain(stages...) {
+        _frame = 0;
+        for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+            _timing[i].clear();
+        }
+        _chain.names(_timing);
+    }
+
+    /**
+     * @brief Run all stages on a frame (call from the frame callback)
+     * @return true if every stage ran, false if a stage stopped the frame
+     */
+    bool process(RD03D_Target* targets, uint8_t count) {
+        RD03D_FrameContext ctx;
+        ctx.targets = targets;
+        ctx.count = count;
+        ctx.now = millis();
+        ctx.frame = _frame++;
+        ctx.tracker = nullptr;
+        return _chain.run(ctx, _timing);
+    }
+
+    /**
+     * @brief Get timing for a stage
+     * @param index Stage index in declaration order
+     * @return Timing, or nullptr if index invalid
+     */
+    const RD03D_StageTiming* getTiming(uint8_t index) {
+        return (index < STAGE_COUNT) ? &_timing[index] : nullptr;
+    }
+
+    /**
+     * @brief Get number of stages
+     */
+    uint8_t getStageCount() { return STAGE_COUNT; }
+
+    /**
+     * @brief Reset stage counters
+     */
+    void resetStats() {
+        for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+            const char* name = _timing[i].name;
+            _timing[i].clear();
+            _timing[i].name = name;
+        }
+    }
+
+private:
+    RD03D_StageChain<Stages...> _chain;
+    RD03D_StageTiming _timing[STAGE_COUNT > 0 ? STAGE_COUNT : 1];
+    uint32_t _frame;
+};
+
+// ============== DYNAMIC PIPELINE ==============
+/**
+ * @brief Base class for stages used by RD03D_DynamicPipeline
+ *
+ * Built-in stages derive from it and mark process() final, so they also
+ * dispatch statically inside RD03D_Pipeline.
+ */
+class RD03D_Stage {
+public:
+    virtual ~RD03D_Stage() {}
+    virtual bool process(RD03D_FrameContext& ctx) = 0;
+    virtual const char* name() const = 0;
+};
+
+/**
+ * @brief Pipeline assembled at run time
+ */
+class RD03D_DynamicPipeline {
+public:
+    RD03D_DynamicPipeline();
+
+    /**
+     * @brief Append a stage (must outlive the pipeline)
+     * @return false if RD03D_MAX_DYNAMIC_STAGES are already added
+     */
+    bool add(RD03D_Stage* stage);
+
+    /**
+     * @brief Remove all stages
+     */
+    void clear();
+
+    /**
+     * @brief Run all stages on a frame
+     * @return true if every stage ran, false if a stage stopped the frame
+     */
+    bool process(RD03D_Target* targets, uint8_t count);
+
+    /**
+     * @brief Get timing for a stage, or nullptr if index invalid
+     */
+    const RD03D_StageTiming* getTiming(uint8_t index);
+
+    /**
+     * @brief Get number of stages
+     */
+    uint8_t getStageCount();
+
+    /**
+     * @brief Reset stage counters
+     */
+    void resetStats();
+
+private:
+    RD03D_Stage* _stages[RD03D_MAX_DYNAMIC_STAGES];
+    RD03D_StageTiming _timing[RD03D_MAX_DYNAMIC_STAGES];
+    uint8_t _count;
+    uint32_t _frame;
+};
+
+// ============== BUILT-IN STAGES ==============
+/**
+ * @brief Clears detections outside a range and beam gate
+ *
+ * Stops the frame when nothing valid is left, unless keepEmpty is set
+ * (a tracker needs empty frames to coast and expire tracks).
+ */
+class RD03D_ValidateStage : public RD03D_Stage {
+public:
+    RD03D_ValidateStage(float maxRangeCm, float maxAngleDeg, bool keepEmpty = true);
+
+    bool process(RD03D_FrameContext& ctx) override final {
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+            RD03D_Target& t = ctx.targets[i];
+            if (!t.valid) continue;
+            if (t.distance > _maxRangeCm || fabsf(t.angle) > _maxAngleDeg) {
+                t.clear();
+            } else {
+                count++;
+            }
+        }
+        ctx.count = count;
+        return count > 0 || _keepEmpty;
+    }
+
+    const char* name() const override { return "validate"; }
+
+private:
+    float _maxRangeCm;
+    float _maxAngleDeg;
+    bool _keepEmpty;
+};
+
+/**
+ * @brief Moves targets into a common frame with a mounting pose
+ */
+class RD03D_PoseStage : public RD03D_Stage {
+public:
+    explicit RD03D_PoseStage(const RD03D_Pose& pose);
+
+    bool process(RD03D_FrameContext& ctx) override final {
+        for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+            _pose.apply(ctx.targets[i]);
+        }
+        return true;
+    }
+
+    const char* name() const override { return "pose"; }
+
+private:
+    const RD03D_Pose& _pose;
+};
+
+/**
+ * @brief Feeds the frame to a tracker and publishes it in the context
+ */
+class RD03D_TrackStage : public RD03D_Stage {
+public:
+    explicit RD03D_TrackStage(RD03D_Tracker& tracker);
+
+    bool process(RD03D_FrameContext& ctx) override final {
+        _tracker.update(ctx.targets, ctx.now);
+        ctx.tracker = &_tracker;
+        return true;
+    }
+
+    const char* name() const override { return "track"; }
+
+private:
+    RD03D_Tracker& _tracker;
+};
+
+/**
+ * @brief Wraps a plain frame callback (an indirect call, for quick sketches)
+ */
+class RD03D_CallbackStage : public RD03D_Stage {
+public:
+    RD03D_CallbackStage(const char* name, RD03D_FrameCallback callback);
+
+    bool process(RD03D_FrameContext& ctx) override final {
+        if (_callback) _callback(ctx.targets, ctx.count);
+        return true;
+    }
+
+    const char* name() const override { return _name; }
+
+private:
+    const char* _name;
+    RD03D_FrameCallback _callback;
+};
+
+#endif // RD03D_PIPELINE_H
@@ -0,0 +1,64 @@
+/**
+ * @file RD03D_Pose.h
+ * @brief Mounting pose of a radar in a shared (room) coordinate frame
+ *
+ * When several radars cover one space, each sensor's targets are moved
+ * into a common frame with a 2D rigid transform:
+ *
+ *   common = R(theta) * sensor + (x, y)
+ *
+ * theta is counter-clockwise in the usual X-right / Y-forward radar
+ * frame. Poses can be measured, or solved with RD03D_Calibration.
+ */
+
+#ifndef RD03D_POSE_H
+#define RD03D_POSE_H
+
+#include "RD03D.h"
+
+// ============== POSE ==============
+struct RD03D_Pose {
+    float x;       ///< Sensor origin X in the common frame (mm)
+    float y;       ///< Sensor origin Y in the common frame (mm)
+    float theta;   ///< Rotation in degrees (counter-clockwise)
+
+    /**
+     * @brief Set to identity (sensor frame = common frame)
+     */
+    void setIdentity() {
+        x = 0;
+        y = 0;
+        theta = 0;
+    }
+
+    /**
+     * @brief Transform a point from sensor to common frame
+     */
+    void apply(float inX, float inY, float& outX, float& outY) const {
+        float rad = theta * PI / 180.0f;
+        float c = cosf(rad);
+        float s = sinf(rad);
+        outX = c * inX - s * inY + x;
+        outY = s * inX + c * inY + y;
+    }
+
+    /**
+     * @brief Transform a target in place (position, distance and angle)
+     *
+     * Distance and angle are recomputed from the common-frame origin.
+     * Positions outside ±32 m are clamped to fit the int16_t fields.
+     */
+    void apply(RD03D_Target& target) const {
+        if (!target.valid) return;
+        float ox, oy;
+        apply((float)target.x, (float)target.y, ox, oy);
+        ox = constrain(ox, -32767.0f, 32767.0f);
+        oy = constrain(oy, -32767.0f, 32767.0f);
+        target.x = (int16_t)lroundf(ox);
+        target.y = (int16_t)lroundf(oy);
+        target.distance = sqrtf(ox * ox + oy * oy) / 10.0f;
+        target.angle = atan2f(ox, oy) * 180.0f / PI;
+    }
+};
+
+#endif // RD03D_POSE_H
@@ -0,0 +1,178 @@
+/**
+ * @file RD03D_Scheduler.cpp
+ * @brief Implementation of the deadline-aware stage scheduler
+ */
+
+#include "RD03D_Scheduler.h"
+
+RD03D_Scheduler::RD03D_Scheduler() {
+    _stageCount = 0;
+    _count = 0;
+    _frameStart = 0;
+    _frameNumber = 0;
+    _hasFrame = false;
+    _budgetPercent = RD03D_SCHED_DEFAULT_BUDGET;
+    _fixedPeriod = 0;
+    _period = RD03D_SCHED_DEFAULT_PERIOD;
+
+    for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+        _targets[i].clear();
+    }
+    resetStats();
+}
+
+int8_t RD03D_Scheduler::addStage(const char* name, RD03D_FrameCallback stage, bool mandatory, uint8_t decimation) {
+    if (_stageCount >= RD03D_MAX_STAGES || !stage) return -1;
+
+    uint8_t i = _stageCount++;
+    _stages[i] = stage;
+    _pending[i] = false;
+    _stats[i].name = name;
+    _stats[i].mandatory = mandatory;
+    _stats[i].decimation = (decimation == 0 || mandatory) ? 1 : decimation;
+    _stats[i].runs = 0;
+    _stats[i].deferred = 0;
+    _stats[i].skipped = 0;
+    _stats[i].decimated = 0;
+    _stats[i].avgMicros = 0;
+    _stats[i].maxMicros = 0;
+    return i;
+}
+
+void RD03D_Scheduler::setBudget(uint8_t percent) {
+    _budgetPercent = constrain(percent, 1, 100);
+}
+
+void RD03D_Scheduler::setFramePeriod(uint32_t periodUs) {
+    _fixedPeriod = periodUs;
+    if (periodUs > 0) _period = periodUs;
+}
+
+void RD03D_Scheduler::runFrame(RD03D_Target* targets, uint8_t count) {
+    uint32_t now = micros();
+
+    // Measure the frame period, ignoring gaps when the radar was silent
+    if (_hasFrame) {
+        uint32_t interval = now - _frameStart;
+        if (_fixedPeriod == 0 && interval < _period * 4) {
+            _period += ((int32_t)interval - (int32_t)_period) / 8;
+        }
+
+        // Deferred work that never found time before this frame
+        for (uint8_t i = 0; i < _stageCount; i++) {
+            if (_pending[i]) {
+                _pending[i] = false;
+                _stats[i].skipped++;
+                _skippedCount++;
+
+                // Let the estimate relax so a single slow run doesn't
+                // shut the stage out forever
+                _stats[i].avgMicros -= _stats[i].avgMicros / 32;
+            }
+        }
+    }
+
+    _frameStart = now;
+    _frameNumber++;
+    _hasFrame = true;
+    _count = count;
+    for (uint8_t i = 0; i < RD03D_MAX_TARGETS; i++) {
+        _targets[i] = targets[i];
+    }
+
+    for (uint8_t i = 0; i < _stageCount; i++) {
+        RD03D_StageStats& s = _stats[i];
+        if (s.mandatory) {
+            runStage(i, targets, count);
+            continue;
+        }
+        if (_frameNumber % s.decimation != 0) {
+            s.decimated++;
+            continue;
+        }
+        if (fits(i, micros())) {
+            runStage(i, targets, count);
+        } else {
+            _pending[i] = true;
+            s.deferred++;
+            _deferredCount++;
+        }
+    }
+
+    if (micros() - _frameStart > _period) {
+        _overrunCount++;
+    }
+}
+
+bool RD03D_Scheduler::runDeferred() {
+    for (uint8_t i = 0; i < _stageCount; i++) {
+        if (!_pending[i]) continue;
+        if (!fits(i, micros())) return false;
+        _pending[i] = false;
+        runStage(i, _targets, _count);
+        return true;
+    }
+    return false;
+}
+
+uint32_t RD03D_Scheduler::budgetUs() {
+    return (uint32_t)((uint64_t)_period * _budgetPercent / 100);
+}
+
+bool RD03D_Scheduler::fits(uint8_t index, uint32_t now) {
+    uint32_t elapsed = now - _frameStart;
+    return elapsed + _stats[index].avgMicros <= budgetUs();
+}
+
+void RD03D_Scheduler::runStage(uint8_t index, RD03D_Target* targets, uint8_t count) {
+    uint32_t start = micros();
+    _stages[index](targets, count);
+    uint32_t cost = micros() - start;
+
+    RD03D_StageStats& s = _stats[index];
+    if (s.avgMicros == 0) {
+        s.avgMicros = cost;
+    } else {
+        s.avgMicros += ((int32_t)cost - (int32_t)s.avgMicros) / 8;
+    }
+    if (cost > s.maxMicros) s.maxMicros = cost;
+    s.runs++;
+}
+
+const RD03D_StageStats* RD03D_Scheduler::getStage(uint8_t index) {
+    if (index >= _stageCount) return nullptr;
+    return &_stats[index];
+}
+
+uint8_t RD03D_Scheduler::getStageCount() {
+    return _stageCount;
+}
+
+uint32_t RD03D_Scheduler::getFramePeriod() {
+    return _period;
+}
+
+uint32_t RD03D_Scheduler::getOverrunCount() {
+    return _overrunCount;
+}
+
+uint32_t RD03D_Scheduler::getDeferredCount() {
+    return _deferredCount;
+}
+
+uint32_t RD03D_Scheduler::getSkippedCount() {
+    return _skippedCount;
+}
+
+void RD03D_Scheduler::resetStats() {
+    for (uint8_t i = 0; i < _stageCount; i++) {
+        _stats[i].runs = 0;
+        _stats[i].deferred = 0;
+        _stats[i].skipped = 0;
+        _stats[i].decimated = 0;
+        _stats[i].maxMicros = 0;
+    }
+    _overrunCount = 0;
+    _deferredCount = 0;
+    _skippedCount = 0;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file RD03D_Scheduler.h
+ * @brief Deadline-aware scheduler for per-frame processing stages
+ *
+ * On a busy MCU (several radars plus WiFi on one core) optional work such
+ * as heatmaps, clutter learning or classification can push the loop past
+ * the frame period and overflow the UART buffer. The scheduler measures
+ * the frame period and the cost of every stage, always runs mandatory
+ * stages, and runs optional stages only while the frame's time budget
+ * allows. Optional stages that don't fit are deferred to idle time in
+ * loop(), or skipped if the next frame arrives first.
+ *
+ * @code
+ * RD03D_Scheduler scheduler;
+ *
+ * void setup() {
+ *     scheduler.addStage("track", trackStage, true);       // mandatory
+ *     scheduler.addStage("output", outputStage, true);     // mandatory
+ *     scheduler.addStage("heatmap", heatmapStage, false);  // optional
+ *     scheduler.addStage("clutter", clutterStage, false, 4); // optional, every 4th frame
+ *     radar.onFrame(onRadarFrame);
+ * }
+ *
+ * void onRadarFrame(RD03D_Target* targets, uint8_t count) {
+ *     scheduler.runFrame(targets, count);
+ * }
+ *
+ * void loop() {
+ *     radar.update();
+ *     scheduler.runDeferred();
+ * }
+ * @endcode
+ */
+
+#ifndef RD03D_SCHEDULER_H
+#define RD03D_SCHEDULER_H
+
+#include "RD03D.h"
+
+// ============== CONFIGURATION ==============
+#define RD03D_MAX_STAGES              8
+#define RD03D_SCHED_DEFAULT_BUDGET    70       // % of the frame period stages may use
+#define RD03D_SCHED_DEFAULT_PERIOD    100000UL // us, until a period has been measured
+
+// ============== STAGE STATISTICS ==============
+/**
+ * @brief Per-stage counters and cost
+ */
+struct RD03D_StageStats {
+    const char* name;      ///< Name given to addStage()
+    bool mandatory;        ///< Always runs
+    uint8_t decimation;    ///< Runs on every Nth frame (1 = every frame)
+    uint32_t runs;         ///< Times the stage ran
+    uint32_t deferred;     ///< Times it was moved out of the frame callback into runDeferred()
+    uint32_t skipped;      ///< Frames it did not run for (no time before the next frame)
+    uint32_t decimated;    ///< Frames it sat out because of decimation
+    uint32_t avgMicros;    ///< Smoothed cost per run
+    uint32_t maxMicros;    ///< Worst cost seen
+};
+
+// ============== MAIN CLASS ==============
+class RD03D_Scheduler {
+public:
+    /**
+     * @brief Constructor
+     */
+    RD03D_Scheduler();
+
+    /**
+     * @brief Register a stage (runs in registration order)
+     * @param name Name for statistics (string must outlive the scheduler)
+     * @param stage Function called with the frame's targets
+     * @param mandatory true if the stage must run every frame
+     * @param decimation Optional stages run on every Nth frame only
+     * @return Stage index, or -1 if RD03D_MAX_STAGES are registered
+     */
+    int8_t addStage(const char* name, RD03D_FrameCallback stage, bool mandatory, uint8_t decimation = 1);
+
+    /**
+     * @brief Set the share of the frame period stages may use
+     * @param percent Budget in percent (default 70), the rest is left for UART and WiFi
+     */
+    void setBudget(uint8_t percent);
+
+    /**
+     * @brief Fix the frame period instead of measuring it
+     * @param periodUs Frame period in microseconds (0 = measure)
+     */
+    void setFramePeriod(uint32_t periodUs);
+
+    /**
+     * @brief Run the stages for a new frame (call from the frame callback)
+     *
+     * Mandatory stages always run. Optional stages run while the budget
+     * allows; the rest are deferred to runDeferred(). Deferred stages
+     * from the previous frame that never got time are counted as skipped.
+     */
+    void runFrame(RD03D_Target* targets, uint8_t count);
+
+    /**
+     * @brief Run the next deferred stage if it fits the remaining budget
+     *
+     * Call from loop(). Deferred stages see a copy of the frame they were
+     * deferred from.
+     * @return true if a stage ran
+     */
+    bool runDeferred();
+
+    /**
+     * @brief Get statistics for a stage
+     * @param index Stage index from addStage()
+     * @return Statistics, or nullptr if index invalid
+     */
+    const RD03D_StageStats* getStage(uint8_t index);
+
+    /**
+     * @brief Get number of registered stages
+     */
+    uint8_t getStageCount();
+
+    /**
+     * @brief Get the frame period in use (us)
+     */
+    uint32_t getFramePeriod();
+
+    /**
+     * @brief Get frames whose stages ran past the frame period
+     */
+    uint32_t getOverrunCount();
+
+    /**
+     * @brief Get total optional stage runs deferred out of the frame callback
+     */
+    uint32_t getDeferredCount();
+
+    /**
+     * @brief Get total optional stage runs skipped for lack of time
+     */
+    uint32_t getSkippedCount();
+
+    /**
+     * @brief Reset all counters (stages and measured costs are kept)
+     */
+    void resetStats();
+
+private:
+    RD03D_StageStats _stats[RD03D_MAX_STAGES];
+    RD03D_FrameCallback _stages[RD03D_MAX_STAGES];
+    bool _pending[RD03D_MAX_STAGES];    // Deferred, waiting for runDeferred()
+    uint8_t _stageCount;
+
+    // Frame being processed (copy kept for deferred stages)
+    RD03D_Target _targets[RD03D_MAX_TARGETS];
+    uint8_t _count;
+    uint32_t _frameStart;
+    uint32_t _frameNumber;
+    bool _hasFrame;
+
+    // Timing
+    uint8_t _budgetPercent;
+    uint32_t _fixedPeriod;
+    uint32_t _period;
+
+    // Statistics
+    uint32_t _overrunCount;
+    uint32_t _deferredCount;
+    uint32_t _skippedCount;
+
+    uint32_t budgetUs();
+    bool fits(uint8_t index, uint32_t now);
+    void runStage(uint8_t index, RD03D_Target* targets, uint8_t count);
+};
+
+#endif // RD03D_SCHEDULER_H
@@ -0,0 +1,204 @@
+/**
+ * @file RD03D_Sketch.cpp
+ * @brief Implementation of the log-binned quantile sketch
+ */
+
+#include "RD03D_Sketch.h"
+#include "RD03D_Config.h"
+#include <string.h>
+
+// ============== SERIALISED LAYOUT ==============
+#define RD03D_SKETCH_MAGIC   0x51334452UL  // "RD3Q" little endian
+#define RD03D_SKETCH_FORMAT  1
+
+struct RD03D_SketchHeader {
+    uint32_t magic;
+    uint32_t crc;            // CRC-32 of bytes [8, size)
+    uint8_t format;
+    uint8_t bins;            // RD03D_SKETCH_BINS of the writer
+    uint8_t first;           // Bins first..last follow as uint32 counts
+    uint8_t last;            // (first > last when empty)
+    float minValue;
+    float maxValue;
+    uint32_t count;
+    float lo;
+    float hi;
+    double sum;
+};
+
+static_assert(sizeof(RD03D_SketchHeader) == RD03D_SKETCH_HEADER_SIZE, "RD03D_SketchHeader layout changed");
+static_assert(RD03D_SKETCH_BINS >= 3 && RD03D_SKETCH_BINS <= 255, "RD03D_SKETCH_BINS out of range");
+
+RD03D_QuantileSketch::RD03D_QuantileSketch(float minValue, float maxValue) {
+    setRange(minValue, maxValue);
+    clear();
+}
+
+void RD03D_QuantileSketch::setRange(float minValue, float maxValue) {
+    if (!(minValue > 0.0f)) minValue = 1.0f;
+    if (!(maxValue > minValue)) maxValue = minValue * 2.0f;
+    _minValue = minValue;
+    _maxValue = maxValue;
+
+    // Bin 0 is below the range, the last bin above it
+    _logGamma = logf(maxValue / minValue) / (RD03D_SKETCH_BINS - 2);
+}
+
+uint8_t RD03D_QuantileSketch::binOf(float value) const {
+    if (value < _minValue) return 0;
+    if (value >= _maxValue) return RD03D_SKETCH_BINS - 1;
+    int bin = 1 + (int)(logf(value / _minValue) / _logGamma);
+    if (bin > RD03D_SKETCH_BINS - 2) bin = RD03D_SKETCH_BINS - 2;
+    return (uint8_t)bin;
+}
+
+void RD03D_QuantileSketch::add(float value) {
+    if (!(value >= 0.0f) || isinf(value)) return;
+
+    _bins[binOf(value)]++;
+    if (_count == 0 || value < _lo) _lo = value;
+    if (_count == 0 || value > _hi) _hi = value;
+    _count++;
+    _sum += value;
+}
+
+bool RD03D_QuantileSketch::merge(const RD03D_QuantileSketch& other) {
+    if (other._minValue != _minValue || other._maxValue != _maxValue) return false;
+    if (other._count == 0) return true;
+
+    for (uint8_t i = 0; i < RD03D_SKETCH_BINS; i++) {
+        _bins[i] += other._bins[i];
+    }
+    if (_count == 0 || other._lo < _lo) _lo = other._lo;
+    if (_count == 0 || other._hi > _hi) _hi = other._hi;
+    _count += other._count;
+    _sum += other._sum;
+    return true;
+}
+
+float RD03D_QuantileSketch::quantile(float q) const {
+    if (_count == 0) return 0.0f;
+    if (!(q > 0.0f)) return _lo;
+    if (q >= 1.0f) return _hi;
+
+    // Bin holding the value of rank q * (count - 1)
+    uint32_t rank = (uint32_t)(q * (_count - 1));
+    uint32_t seen = 0;
+    uint8_t bin = 0;
+    for (; bin < RD03D_SKETCH_BINS - 1; bin++) {
+        seen += _bins[bin];
+        if (seen > rank) break;
+    }
+
+    // Geometric centre of the bin; the outer bins have no centre
+    float value;
+    if (bin == 0) {
+        value = _lo;
+    } else if (bin == RD03D_SKETCH_BINS - 1) {
+        value = _hi;
+    } else {
+        value = _minValue * expf((bin - 0.5f) * _logGamma);
+    }
+    if (value < _lo) value = _lo;
+    if (value > _hi) value = _hi;
+    return value;
+}
+
+uint32_t RD03D_QuantileSketch::getCount() const {
+    return _count;
+}
+
+float RD03D_QuantileSketch::getMean() const {
+    return (_count > 0) ? (float)(_sum / _count) : 0.0f;
+}
+
+float RD03D_QuantileSketch::getMin() const {
+    return _lo;
+}
+
+float RD03D_QuantileSketch::getMax() const {
+    return _hi;
+}
+
+float RD03D_QuantileSketch::getRelativeError() const {
+    return expf(_logGamma * 0.5f) - 1.0f;
+}
+
+void RD03D_QuantileSketch::clear() {
+    memset(_bins, 0, sizeof(_bins));
+    _count = 0;
+    _sum = 0.0;
+    _lo = 0.0f;
+    _hi = 0.0f;
+}
+
+// ============== SERIALISATION ==============
+size_t RD03D_QuantileSketch::serialize(uint8_t* buffer, size_t size) const {
+    RD03D_SketchHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = RD03D_SKETCH_MAGIC;
+    h.format = RD03D_SKETCH_FORMAT;
+    h.bins = RD03D_SKETCH_BINS;
+    h.minValue = _minValue;
+    h.maxValue = _maxValue;
+    h.count = _count;
+    h.lo = _lo;
+    h.hi = _hi;
+    h.sum = _sum;
+
+    // Only the span of non-empty bins is stored
+    h.first = 1;
+    h.last = 0;
+    for (uint8_t i = 0; i < RD03D_SKETCH_BINS; i++) {
+        if (_bins[i] == 0) continue;
+        if (h.first > h.last) h.first = i;
+        h.last = i;
+    }
+    size_t n = (h.first <= h.last) ? h.last - h.first + 1 : 0;
+    size_t total = sizeof(h) + n * sizeof(uint32_t);
+    if (!buffer || total > size) return 0;
+
+    if (n > 0) memcpy(buffer + sizeof(h), &_bins[h.first], n * sizeof(uint32_t));
+    memcpy(buffer, &h, sizeof(h));
+    h.crc = RD03D_ConfigBlob::crc32(buffer + 8, total - 8);
+    memcpy(buffer + 4, &h.crc, sizeof(h.crc));
+    return total;
+}
+
+size_t RD03D_QuantileSketch::deserialize(const uint8_t* buffer, size_t size) {
+    if (!buffer || size < sizeof(RD03D_SketchHeader)) return 0;
+
+    RD03D_SketchHeader h;
+    memcpy(&h, buffer, sizeof(h));
+    if (h.magic != RD03D_SKETCH_MAGIC || h.format != RD03D_SKETCH_FORMAT ||
+        h.bins != RD03D_SKETCH_BINS) {
+        return 0;
+    }
+    size_t n = 0;
+    if (h.first <= h.last) {
+        if (h.last >= RD03D_SKETCH_BINS) return 0;
+        n = h.last - h.first + 1;
+    }
+    size_t total = sizeof(h) + n * sizeof(uint32_t);
+    if (total > size) return 0;
+    if (RD03D_ConfigBlob::crc32(buffer + 8, total - 8) != h.crc) return 0;
+    if (!(h.minValue > 0.0f) || !(h.maxValue > h.minValue) || isinf(h.maxValue)) return 0;
+
+    // Bin counts must add up to the count
+    uint32_t counts[RD03D_SKETCH_BINS];
+    memset(counts, 0, sizeof(counts));
+    if (n > 0) memcpy(&counts[h.first], buffer + sizeof(h), n * sizeof(uint32_t));
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < RD03D_SKETCH_BINS; i++) {
+        sum += counts[i];
+    }
+    if (sum != h.count) return 0;
+
+    setRange(h.minValue, h.maxValue);
+    memcpy(_bins, counts, sizeof(_bins));
+    _count = h.count;
+    _sum = h.sum;
+    _lo = h.lo;
+    _hi = h.hi;
+    return total;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file RD03D_Sketch.h
+ * @brief Fixed-memory, mergeable quantile sketch
+ *
+ * Keeps a histogram with logarithmically spaced bins between a minimum
+ * and maximum value, so every quantile is answered with the same
+ * relative error (about 2.8% for a 1000:1 range) no matter how many
+ * values were added. Unlike P² estimators, two sketches with the same
+ * range merge exactly by adding their bins, so devices can ship one
+ * small sketch per hour instead of raw samples, and the host combines
+ * sensors, hours or days afterwards (extras/host/sketches).
+ *
+ * @code
+ * RD03D_QuantileSketch speeds(50, 5000);   // mm/s
+ *
+ * speeds.add(speed);                        // Every frame
+ *
+ * uint8_t blob[RD03D_SKETCH_MAX_SIZE];      // Every hour
+ * size_t len = speeds.serialize(blob, sizeof(blob));
+ * udp.write(blob, len);
+ * speeds.clear();
+ * @endcode
+ */
+
+#ifndef RD03D_SKETCH_H
+#define RD03D_SKETCH_H
+
+#include "RD03D.h"
+
+// ============== CONFIGURATION ==============
+#define RD03D_SKETCH_BINS      128   // Underflow + log bins + overflow (3-255)
+#define RD03D_SKETCH_HEADER_SIZE 40
+#define RD03D_SKETCH_MAX_SIZE  (RD03D_SKETCH_HEADER_SIZE + RD03D_SKETCH_BINS * 4)  // Largest serialize() output
+
+// ============== MAIN CLASS ==============
+class RD03D_QuantileSketch {
+public:
+    /**
+     * @brief Constructor
+     * @param minValue Smallest value resolved (> 0); smaller values, including 0,
+     *        share one bin
+     * @param maxValue Largest value resolved; larger values share one bin
+     */
+    RD03D_QuantileSketch(float minValue, float maxValue);
+
+    /**
+     * @brief Add one value (negative and NaN values are ignored)
+     */
+    void add(float value);
+
+    /**
+     * @brief Add all values of another sketch
+     * @return false if the sketches have different ranges
+     */
+    bool merge(const RD03D_QuantileSketch& other);
+
+    /**
+     * @brief Estimate a quantile
+     *
+     * Quantiles that fall below minValue or above maxValue are reported
+     * as the smallest or largest value added.
+     * @param q Quantile (0 = minimum, 0.5 = median, 1 = maximum)
+     * @return Estimated value, or 0 if the sketch is empty
+     */
+    float quantile(float q) const;
+
+    /**
+     * @brief Get number of values added
+     */
+    uint32_t getCount() const;
+
+    /**
+     * @brief Get mean of the values added (0 if empty)
+     */
+    float getMean() const;
+
+    /**
+     * @brief Get smallest value added (0 if empty)
+     */
+    float getMin() const;
+
+    /**
+     * @brief Get largest value added (0 if empty)
+     */
+    float getMax() const;
+
+    /**
+     * @brief Get the worst-case relative error of quantile() inside the range
+     */
+    float getRelativeError() const;
+
+    /**
+     * @brief Forget all values (the range is kept)
+     */
+    void clear();
+
+    /**
+     * @brief Write the sketch as a compact blob (empty bins at either end
+     *        are left out)
+     * @param buffer Output buffer (RD03D_SKETCH_MAX_SIZE bytes is always enough)
+     * @param size Size of buffer
+     * @return Bytes written, or 0 if the buffer is too small
+     */
+    size_t serialize(uint8_t* buffer, size_t size) const;
+
+    /**
+     * @brief Replace this sketch, range included, with one written by serialize()
+     *
+     * Blobs can be concatenated: the return value is the offset of the next.
+     * The sketch is left unchanged on failure.
+     * @return Bytes read, or 0 if the blob is truncated, damaged or from a
+     *         build with a different RD03D_SKETCH_BINS
+     */
+    size_t deserialize(const uint8_t* buffer, size_t size);
+
+private:
+    float _minValue;
+    float _maxValue;
+    float _logGamma;        // Log of the ratio between neighbouring bin edges
+    uint32_t _bins[RD03D_SKETCH_BINS];
+    uint32_t _count;
+    double _sum;            // Double: a day of mm/s values overflows float precision
+    float _lo;
+    float _hi;
+
+    void setRange(float minValue, float maxValue);
+    uint8_t binOf(float value) const;
+};
+
+#endif // RD03D_SKETCH_H
@@ -0,0 +1,140 @@
+/**
+ * @file RD03D_TrackWindow.cpp
+ * @brief Implementation of the rolling track statistics window
+ */
+
+#include "RD03D_TrackWindow.h"
+#include <string.h>
+
+static_assert(RD03D_TRACK_WINDOW >= 2 && RD03D_TRACK_WINDOW <= 255, "RD03D_TRACK_WINDOW out of range");
+
+RD03D_TrackWindow::RD03D_TrackWindow() {
+    clear();
+}
+
+void RD03D_TrackWindow::add(float x, float y, float speed) {
+    push(_series[RD03D_WINDOW_X], x);
+    push(_series[RD03D_WINDOW_Y], y);
+    push(_series[RD03D_WINDOW_SPEED], speed);
+
+    _next = (_next + 1) % RD03D_TRACK_WINDOW;
+    if (_count < RD03D_TRACK_WINDOW) _count++;
+
+    // Once per window: move the pivot to the newest value and recompute
+    // the sums exactly, so the amortised cost stays O(1)
+    if (++_sinceRepivot >= RD03D_TRACK_WINDOW) {
+        for (uint8_t i = 0; i < RD03D_WINDOW_VALUES; i++) {
+            repivot(_series[i]);
+        }
+        _sinceRepivot = 0;
+    }
+}
+
+void RD03D_TrackWindow::push(Series& s, float v) {
+    uint8_t slot = _next;
+
+    // The slot being written holds the oldest sample once the window is full
+    if (_count == RD03D_TRACK_WINDOW) {
+        float old = s.values[slot] - s.pivot;
+        s.sum -= old;
+        s.sumSq -= old * old;
+        if (s.minQ.size > 0 && front(s.minQ) == slot) {
+            s.minQ.head = (s.minQ.head + 1) % RD03D_TRACK_WINDOW;
+            s.minQ.size--;
+        }
+        if (s.maxQ.size > 0 && front(s.maxQ) == slot) {
+            s.maxQ.head = (s.maxQ.head + 1) % RD03D_TRACK_WINDOW;
+            s.maxQ.size--;
+        }
+    } else if (_count == 0) {
+        s.pivot = v;
+    }
+
+    s.values[slot] = v;
+    float d = v - s.pivot;
+    s.sum += d;
+    s.sumSq += d * d;
+
+    pushBack(s.minQ, s.values, slot, true);
+    pushBack(s.maxQ, s.values, slot, false);
+}
+
+void RD03D_TrackWindow::pushBack(Deque& q, const float* values, uint8_t slot, bool keepSmaller) {
+    // Older values that the new one beats can never be the extreme again
+    float v = values[slot];
+    while (q.size > 0) {
+        uint8_t back = q.index[(q.head + q.size - 1) % RD03D_TRACK_WINDOW];
+        bool beaten = keepSmaller ? (values[back] >= v) : (values[back] <= v);
+        if (!beaten) break;
+        q.size--;
+    }
+    q.index[(q.head + q.size) % RD03D_TRACK_WINDOW] = slot;
+    q.size++;
+}
+
+uint8_t RD03D_TrackWindow::front(const Deque& q) {
+    return q.index[q.head];
+}
+
+void RD03D_TrackWindow::repivot(Series& s) {
+    s.pivot = s.values[(_next + RD03D_TRACK_WINDOW - 1) % RD03D_TRACK_WINDOW];
+    s.sum = 0.0f;
+    s.sumSq = 0.0f;
+
+    uint8_t first = (_count == RD03D_TRACK_WINDOW) ? _next : 0;
+    for (uint8_t k = 0; k < _count; k++) {
+        float d = s.values[(first + k) % RD03D_TRACK_WINDOW] - s.pivot;
+        s.sum += d;
+        s.sumSq += d * d;
+    }
+}
+
+void RD03D_TrackWindow::clear() {
+    memset(_series, 0, sizeof(_series));
+    _next = 0;
+    _count = 0;
+    _sinceRepivot = 0;
+}
+
+uint8_t RD03D_TrackWindow::getCount() const {
+    return _count;
+}
+
+bool RD03D_TrackWindow::isFull() const {
+    return _count == RD03D_TRACK_WINDOW;
+}
+
+float RD03D_TrackWindow::getMean(RD03D_WindowValue value) const {
+    if (_count == 0 || value >= RD03D_WINDOW_VALUES) return 0.0f;
+    const Series& s = _series[value];
+    return s.pivot + s.sum / _count;
+}
+
+float RD03D_TrackWindow::getVariance(RD03D_WindowValue value) const {
+    if (_count == 0 || value >= RD03D_WINDOW_VALUES) return 0.0f;
+    const Series& s = _series[value];
+    float mean = s.sum / _count;
+    float var = s.sumSq / _count - mean * mean;
+    return var > 0.0f ? var : 0.0f;
+}
+
+float RD03D_TrackWindow::getStdDev(RD03D_WindowValue value) const {
+    return sqrtf(getVariance(value));
+}
+
+float RD03D_TrackWindow::getMin(RD03D_WindowValue value) const {
+    if (_count == 0 || value >= RD03D_WINDOW_VALUES) return 0.0f;
+    const Series& s = _series[value];
+    return s.values[front(s.minQ)];
+}
+
+float RD03D_TrackWindow::getMax(RD03D_WindowValue value) const {
+    if (_count == 0 || value >= RD03D_WINDOW_VALUES) return 0.0f;
+    const Series& s = _series[value];
+    return s.values[front(s.maxQ)];
+}
+
+float RD03D_TrackWindow::getLatest(RD03D_WindowValue value) const {
+    if (_count == 0 || value >= RD03D_WINDOW_VALUES) return 0.0f;
+    return _series[value].values[(_next + RD03D_TRACK_WINDOW - 1) % RD03D_TRACK_WINDOW];
+}
@@ -0,0 +1,130 @@
+/**
+ * @file RD03D_TrackWindow.h
+ * @brief Rolling statistics over a track's last frames
+ *
+ * The tracker keeps one window per track and adds the track's position
+ * and speed on every frame the track exists (detected or coasting), so
+ * consumers can ask for the mean, variance, minimum or maximum over the
+ * last RD03D_TRACK_WINDOW frames without keeping their own history.
+ *
+ * Each add() is O(1): means and variances come from running sums, and
+ * minimum/maximum from monotonic deques (a value is dropped from the
+ * back as soon as a newer, larger/smaller one arrives, so the front is
+ * always the extreme). Sums are taken relative to a pivot that is moved
+ * to a recent value every RD03D_TRACK_WINDOW samples; this keeps float
+ * variances accurate at positions of several metres and stops rounding
+ * error from building up.
+ *
+ * @code
+ * const RD03D_TrackWindow* w = tracker.getWindow(i);
+ * if (w->isFull() && w->getStdDev(RD03D_WINDOW_X) < 50) {
+ *     // Track i has stood still (±5 cm) for the last window
+ * }
+ * float peak = w->getMax(RD03D_WINDOW_SPEED);
+ * @endcode
+ */
+
+#ifndef RD03D_TRACK_WINDOW_H
+#define RD03D_TRACK_WINDOW_H
+
+#include "RD03D.h"
+
+// ============== CONFIGURATION ==============
+#define RD03D_TRACK_WINDOW     16    // Frames per window (2-255)
+
+// ============== WINDOWED VALUES ==============
+enum RD03D_WindowValue {
+    RD03D_WINDOW_X = 0,     ///< Filtered X (mm)
+    RD03D_WINDOW_Y,         ///< Filtered Y (mm)
+    RD03D_WINDOW_SPEED,     ///< Speed, |(vx, vy)| (mm/s)
+    RD03D_WINDOW_VALUES
+};
+
+// ============== MAIN CLASS ==============
+class RD03D_TrackWindow {
+public:
+    /**
+     * @brief Constructor (empty window)
+     */
+    RD03D_TrackWindow();
+
+    /**
+     * @brief Add one frame, dropping the oldest once the window is full
+     */
+    void add(float x, float y, float speed);
+
+    /**
+     * @brief Forget all samples
+     */
+    void clear();
+
+    /**
+     * @brief Get number of samples in the window (0 to RD03D_TRACK_WINDOW)
+     */
+    uint8_t getCount() const;
+
+    /**
+     * @brief True once the window holds RD03D_TRACK_WINDOW samples
+     */
+    bool isFull() const;
+
+    /**
+     * @brief Get the mean over the window (0 if empty)
+     */
+    float getMean(RD03D_WindowValue value) const;
+
+    /**
+     * @brief Get the population variance over the window (0 if empty)
+     */
+    float getVariance(RD03D_WindowValue value) const;
+
+    /**
+     * @brief Get the standard deviation over the window (0 if empty)
+     */
+    float getStdDev(RD03D_WindowValue value) const;
+
+    /**
+     * @brief Get the smallest value in the window (0 if empty)
+     */
+    float getMin(RD03D_WindowValue value) const;
+
+    /**
+     * @brief Get the largest value in the window (0 if empty)
+     */
+    float getMax(RD03D_WindowValue value) const;
+
+    /**
+     * @brief Get the most recent value (0 if empty)
+     */
+    float getLatest(RD03D_WindowValue value) const;
+
+private:
+    // Ring indices of samples in the window, oldest first, that could
+    // still become the extreme
+    struct Deque {
+        uint8_t index[RD03D_TRACK_WINDOW];
+        uint8_t head;
+        uint8_t size;
+    };
+
+    struct Series {
+        float values[RD03D_TRACK_WINDOW];
+        float pivot;        // Sums are of (value - pivot)
+        float sum;
+        float sumSq;
+        Deque minQ;         // Increasing values
+        Deque maxQ;         // Decreasing values
+    };
+
+    Series _series[RD03D_WINDOW_VALUES];
+    uint8_t _next;          // Ring slot for the next sample
+    uint8_t _count;
+    uint8_t _sinceRepivot;
+
+    void push(Series& s, float v);
+    void repivot(Series& s);
+    static void pushBack(Deque& q, const float* values, uint8_t slot, bool keepSmaller);
+    static uint8_t front(const Deque& q);
+};
+
+#endif // RD03D_TRACK_WINDOW_H
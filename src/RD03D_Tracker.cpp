@@ -0,0 +1,383 @@
+/**
+ * @file RD03D_Tracker.cpp
+ * @brief Implementation of the RD-03D multi-target tracker
+ */
+
+#include "RD03D_Tracker.h"
+#include "RD03D_Config.h"
+#include <string.h>
+
+// ============== SAVED STATE LAYOUT ==============
+#define RD03D_TRACKER_STATE_MAGIC   0x54334452UL  // "RD3T" little endian
+#define RD03D_TRACKER_STATE_FORMAT  1
+#define RD03D_TRACKER_NEVER_UPDATED 0xFFFFFFFFUL
+
+struct RD03D_TrackerStateHeader {
+    uint32_t magic;
+    uint32_t crc;            // CRC-32 of bytes [8, size)
+    uint8_t format;
+    uint8_t trackCount;      // Active tracks that follow
+    uint16_t nextId;
+    uint32_t stamp;          // Persistent clock at save (ms)
+    uint32_t sinceUpdate;    // ms from the last update() to the save
+    uint32_t rejectedCount;
+    uint32_t reserved;
+};
+
+struct RD03D_TrackerStateTrack {
+    uint16_t id;
+    uint16_t hits;
+    uint8_t missed;
+    uint8_t confirmed;
+    uint8_t slot;
+    uint8_t reserved;
+    float x;
+    float y;
+    float vx;
+    float vy;
+    uint32_t sinceFirst;     // ms from firstSeen to the save
+    uint32_t sinceLast;      // ms from lastSeen to the save
+};
+
+static_assert(sizeof(RD03D_TrackerStateHeader) == 28, "RD03D_TrackerStateHeader layout changed");
+static_assert(sizeof(RD03D_TrackerStateTrack) == 32, "RD03D_TrackerStateTrack layout changed");
+static_assert(RD03D_TRACKER_STATE_SIZE == sizeof(RD03D_TrackerStateHeader) + RD03D_MAX_TRACKS * sizeof(RD03D_TrackerStateTrack),
+              "RD03D_TRACKER_STATE_SIZE out of date");
+
+RD03D_Tracker::RD03D_Tracker() {
+    _config.setDefaults();
+    _nextId = 1;
+    _rejectedCount = 0;
+    reset();
+}
+
+void RD03D_Tracker::setConfig(const RD03D_TrackerConfig& config) {
+    _config = config;
+}
+
+const RD03D_TrackerConfig& RD03D_Tracker::getConfig() {
+    return _config;
+}
+
+bool RD03D_Tracker::validate(const RD03D_Target& target) {
+    if (!target.valid) return false;
+    if (target.distance > _config.maxRangeCm) return false;
+    if (fabsf(target.angle) > _config.maxAngleDeg) return false;
+    return true;
+}
+
+uint8_t RD03D_Tracker::update(const RD03D_Target* targets, uint32_t now) {
+    // Time step in seconds, clamped so a long gap can't fling tracks away
+    float dt = _hasUpdate ? (now - _lastUpdate) / 1000.0f : 0.0f;
+    if (dt > 1.0f) dt = 1.0f;
+    _prevUpdate = _hasUpdate ? _lastUpdate : now;
+    _lastUpdate = now;
+    _hasUpdate = true;
+
+    // Validate detections
+    bool usable[RD03D_MAX_TARGETS];
+    for (uint8_t j = 0; j < RD03D_MAX_TARGETS; j++) {
+        usable[j] = validate(targets[j]);
+        if (targets[j].valid && !usable[j]) _rejectedCount++;
+    }
+
+    // Predict active tracks forward, keeping where they were for sampleAt()
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        RD03D_Track& t = _tracks[i];
+        if (!t.active) continue;
+        _prevX[i] = t.x;
+        _prevY[i] = t.y;
+        t.x += t.vx * dt;
+        t.y += t.vy * dt;
+    }
+
+    // Greedy nearest-neighbour association inside the gate
+    bool trackUsed[RD03D_MAX_TRACKS] = {false};
+    float gate2 = _config.gateMm * _config.gateMm;
+    while (true) {
+        int8_t bestTrack = -1;
+        int8_t bestDet = -1;
+        float bestDist = gate2;
+        for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+            if (!_tracks[i].active || trackUsed[i]) continue;
+            for (uint8_t j = 0; j < RD03D_MAX_TARGETS; j++) {
+                if (!usable[j]) continue;
+                float dx = targets[j].x - _tracks[i].x;
+                float dy = targets[j].y - _tracks[i].y;
+                float d2 = dx * dx + dy * dy;
+                if (d2 < bestDist) {
+                    bestDist = d2;
+                    bestTrack = i;
+                    bestDet = j;
+                }
+            }
+        }
+        if (bestTrack < 0) break;
+
+        // Alpha-beta correction
+        RD03D_Track& t = _tracks[bestTrack];
+        float rx = targets[bestDet].x - t.x;
+        float ry = targets[bestDet].y - t.y;
+        t.x += _config.alpha * rx;
+        t.y += _config.alpha * ry;
+        if (dt > 0.0f) {
+            t.vx += _config.beta * rx / dt;
+            t.vy += _config.beta * ry / dt;
+        }
+        if (t.hits < 0xFFFF) t.hits++;
+        t.missed = 0;
+        t.lastSeen = now;
+        if (t.hits >= _config.confirmFrames) t.confirmed = true;
+
+        trackUsed[bestTrack] = true;
+        usable[bestDet] = false;
+    }
+
+    // Coast or drop unmatched tracks
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        RD03D_Track& t = _tracks[i];
+        if (!t.active || trackUsed[i]) continue;
+        t.missed++;
+        if (t.missed > _config.coastFrames) {
+            t.clear();
+            _windows[i].clear();
+        }
+    }
+
+    // Start new tracks from leftover detections
+    for (uint8_t j = 0; j < RD03D_MAX_TARGETS; j++) {
+        if (usable[j]) startTrack(targets[j], now);
+    }
+
+    // Every existing track, detected or coasting, adds one frame to its window
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        const RD03D_Track& t = _tracks[i];
+        if (!t.active) continue;
+        _windows[i].add(t.x, t.y, sqrtf(t.vx * t.vx + t.vy * t.vy));
+    }
+
+    return getTrackCount();
+}
+
+void RD03D_Tracker::startTrack(const RD03D_Target& target, uint32_t now) {
+    // Use a free slot, or replace the track that has been missing longest
+    int8_t slot = -1;
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        if (!_tracks[i].active) {
+            slot = i;
+            break;
+        }
+        if (_tracks[i].missed > 0 && (slot < 0 || _tracks[i].missed > _tracks[slot].missed)) {
+            slot = i;
+        }
+    }
+    if (slot < 0) return;
+
+    RD03D_Track& t = _tracks[slot];
+    t.clear();
+    _windows[slot].clear();
+    t.id = _nextId++;
+    if (_nextId == 0) _nextId = 1;
+    t.x = target.x;
+    t.y = target.y;
+    _prevX[slot] = t.x;
+    _prevY[slot] = t.y;
+
+    // Seed velocity from the radial speed reported by the radar
+    float r = target.distance * 10.0f;
+    if (r > 0.0f) {
+        float v = target.speed * 10.0f;
+        t.vx = v * target.x / r;
+        t.vy = v * target.y / r;
+    }
+
+    t.hits = 1;
+    t.active = true;
+    t.confirmed = (_config.confirmFrames <= 1);
+    t.firstSeen = now;
+    t.lastSeen = now;
+}
+
+RD03D_Track* RD03D_Tracker::getTrack(uint8_t index) {
+    if (index >= RD03D_MAX_TRACKS) return nullptr;
+    return &_tracks[index];
+}
+
+RD03D_Track* RD03D_Tracker::getTracks() {
+    return _tracks;
+}
+
+const RD03D_TrackWindow* RD03D_Tracker::getWindow(uint8_t index) {
+    if (index >= RD03D_MAX_TRACKS) return nullptr;
+    return &_windows[index];
+}
+
+uint8_t RD03D_Tracker::sampleAt(uint32_t t, RD03D_TrackSample* samples) const {
+    if (!samples) return 0;
+
+    // Interpolate over the last frame interval unless it was a long gap
+    uint32_t span = _lastUpdate - _prevUpdate;
+    bool interpolate = span > 0 && span <= 1000;
+    int32_t age = (int32_t)(t - _lastUpdate);
+    float u = 1.0f;
+    if (age < 0 && interpolate) {
+        int32_t into = (int32_t)(t - _prevUpdate);
+        u = (into <= 0) ? 0.0f : (float)into / span;
+    }
+    float ahead = 0.0f;
+    if (age > 0) ahead = (age < RD03D_SAMPLE_HORIZON ? age : RD03D_SAMPLE_HORIZON) / 1000.0f;
+
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        const RD03D_Track& track = _tracks[i];
+        RD03D_TrackSample& s = samples[i];
+        if (!_hasUpdate || !track.isValid()) {
+            memset(&s, 0, sizeof(s));
+            continue;
+        }
+        s.id = track.id;
+        s.vx = track.vx;
+        s.vy = track.vy;
+        s.extrapolated = age > 0;
+        if (age > 0) {
+            s.x = track.x + track.vx * ahead;
+            s.y = track.y + track.vy * ahead;
+        } else {
+            s.x = _prevX[i] + (track.x - _prevX[i]) * u;
+            s.y = _prevY[i] + (track.y - _prevY[i]) * u;
+        }
+        count++;
+    }
+    return count;
+}
+
+uint8_t RD03D_Tracker::getTrackCount() {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        if (_tracks[i].isValid()) count++;
+    }
+    return count;
+}
+
+uint32_t RD03D_Tracker::getRejectedCount() {
+    return _rejectedCount;
+}
+
+void RD03D_Tracker::reset() {
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        _tracks[i].clear();
+        _windows[i].clear();
+        _prevX[i] = 0;
+        _prevY[i] = 0;
+    }
+    _lastUpdate = 0;
+    _prevUpdate = 0;
+    _hasUpdate = false;
+}
+
+// ============== WARM RESTART ==============
+size_t RD03D_Tracker::saveState(uint8_t* buffer, size_t size, uint32_t now, uint32_t stamp) {
+    RD03D_TrackerStateHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = RD03D_TRACKER_STATE_MAGIC;
+    h.format = RD03D_TRACKER_STATE_FORMAT;
+    h.nextId = _nextId;
+    h.stamp = stamp;
+    h.sinceUpdate = _hasUpdate ? now - _lastUpdate : RD03D_TRACKER_NEVER_UPDATED;
+    h.rejectedCount = _rejectedCount;
+
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        if (_tracks[i].active) h.trackCount++;
+    }
+    size_t total = sizeof(h) + (size_t)h.trackCount * sizeof(RD03D_TrackerStateTrack);
+    if (!buffer || total > size) return 0;
+
+    // Only active tracks are stored, each with its slot
+    size_t offset = sizeof(h);
+    for (uint8_t i = 0; i < RD03D_MAX_TRACKS; i++) {
+        const RD03D_Track& t = _tracks[i];
+        if (!t.active) continue;
+
+        RD03D_TrackerStateTrack r;
+        memset(&r, 0, sizeof(r));
+        r.id = t.id;
+        r.hits = t.hits;
+        r.missed = t.missed;
+        r.confirmed = t.confirmed ? 1 : 0;
+        r.slot = i;
+        r.x = t.x;
+        r.y = t.y;
+        r.vx = t.vx;
+        r.vy = t.vy;
+        r.sinceFirst = now - t.firstSeen;
+        r.sinceLast = now - t.lastSeen;
+        memcpy(buffer + offset, &r, sizeof(r));
+        offset += sizeof(r);
+    }
+
+    memcpy(buffer, &h, sizeof(h));
+    h.crc = RD03D_ConfigBlob::crc32(buffer + 8, total - 8);
+    memcpy(buffer + 4, &h.crc, sizeof(h.crc));
+    return total;
+}
+
+RD03D_RestoreResult RD03D_Tracker::restoreState(const uint8_t* buffer, size_t size, uint32_t now,
+                                                uint32_t stamp, uint32_t maxAgeMs) {
+    if (!buffer || size < sizeof(RD03D_TrackerStateHeader)) return RD03D_RESTORE_INVALID;
+
+    RD03D_TrackerStateHeader h;
+    memcpy(&h, buffer, sizeof(h));
+    if (h.magic != RD03D_TRACKER_STATE_MAGIC || h.format != RD03D_TRACKER_STATE_FORMAT ||
+        h.trackCount > RD03D_MAX_TRACKS) {
+        return RD03D_RESTORE_INVALID;
+    }
+    size_t total = sizeof(h) + (size_t)h.trackCount * sizeof(RD03D_TrackerStateTrack);
+    if (total > size) return RD03D_RESTORE_INVALID;
+    if (RD03D_ConfigBlob::crc32(buffer + 8, total - 8) != h.crc) return RD03D_RESTORE_CRC;
+
+    // A stamp ahead of the clock (clock reset or set back) wraps to a huge age
+    uint32_t age = stamp - h.stamp;
+    if (age > maxAgeMs) return RD03D_RESTORE_STALE;
+
+    // Check every record before touching the tracker
+    RD03D_TrackerStateTrack records[RD03D_MAX_TRACKS];
+    bool slotUsed[RD03D_MAX_TRACKS] = {false};
+    for (uint8_t k = 0; k < h.trackCount; k++) {
+        RD03D_TrackerStateTrack& r = records[k];
+        memcpy(&r, buffer + sizeof(h) + (size_t)k * sizeof(r), sizeof(r));
+        if (r.slot >= RD03D_MAX_TRACKS || slotUsed[r.slot] || r.id == 0 ||
+            !isfinite(r.x) || !isfinite(r.y) || !isfinite(r.vx) || !isfinite(r.vy)) {
+            return RD03D_RESTORE_INVALID;
+        }
+        slotUsed[r.slot] = true;
+    }
+
+    // Rebase times onto now, counting the time spent in the reset
+    uint32_t saved = now - age;
+    reset();
+    for (uint8_t k = 0; k < h.trackCount; k++) {
+        const RD03D_TrackerStateTrack& r = records[k];
+        RD03D_Track& t = _tracks[r.slot];
+        t.id = r.id;
+        t.x = r.x;
+        t.y = r.y;
+        t.vx = r.vx;
+        t.vy = r.vy;
+        t.hits = r.hits;
+        t.missed = r.missed;
+        t.confirmed = r.confirmed != 0;
+        t.active = true;
+        t.firstSeen = saved - r.sinceFirst;
+        t.lastSeen = saved - r.sinceLast;
+        _prevX[r.slot] = r.x;
+        _prevY[r.slot] = r.y;
+    }
+    _nextId = (h.nextId != 0) ? h.nextId : 1;
+    _rejectedCount = h.rejectedCount;
+    if (h.sinceUpdate != RD03D_TRACKER_NEVER_UPDATED) {
+        _lastUpdate = saved - h.sinceUpdate;
+        _prevUpdate = _lastUpdate;
+        _hasUpdate = true;
+    }
+    return RD03D_RESTORE_OK;
+}
@@ -0,0 +1,274 @@
+/**
+ * @file RD03D_Tracker.h
+ * @brief Lightweight multi-target tracker for RD-03D detections
+ *
+ * The radar reports up to 3 targets per frame, but slot order can swap
+ * and targets drop out for a frame or two. The tracker validates each
+ * detection (range and beam gate), associates detections to existing
+ * tracks by nearest neighbour, smooths position/velocity with an
+ * alpha-beta filter and coasts tracks through short dropouts, so each
+ * person keeps a stable ID.
+ *
+ * The whole tracker state can be saved into a small buffer (for example
+ * RTC memory that survives a watchdog reset or deep sleep) and restored
+ * at boot, so tracks and IDs carry straight on instead of restarting.
+ *
+ * Each track also has a rolling window (getWindow()) with the mean,
+ * variance, minimum and maximum of its position and speed over the last
+ * RD03D_TRACK_WINDOW frames, kept up to date in O(1) per frame.
+ *
+ * A display refreshing faster than the radar's 20-50 Hz can call
+ * sampleAt() once per rendered frame: it interpolates each track
+ * between its last two updates, or extrapolates a short way past the
+ * latest one, so markers glide instead of jumping.
+ *
+ * @code
+ * RD03D radar;
+ * RD03D_Tracker tracker;
+ *
+ * void onRadarData(RD03D_Target* targets, uint8_t count) {
+ *     tracker.update(targets, millis());
+ *     for (int i = 0; i < RD03D_MAX_TRACKS; i++) {
+ *         RD03D_Track* t = tracker.getTrack(i);
+ *         if (t->isValid()) {
+ *             Serial.printf("Track %u: %.0f, %.0f mm\n", t->id, t->x, t->y);
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+
+#ifndef RD03D_TRACKER_H
+#define RD03D_TRACKER_H
+
+#include "RD03D.h"
+#include "RD03D_TrackWindow.h"
+
+// ============== CONFIGURATION ==============
+#define RD03D_MAX_TRACKS       4     // Radar slots plus one coasting track
+#define RD03D_TRACKER_STATE_SIZE (28 + RD03D_MAX_TRACKS * 32)  // Bytes needed by saveState()
+#define RD03D_SAMPLE_HORIZON   100   // ms sampleAt() extrapolates past the last update before holding
+
+// ============== TRACKER SETTINGS ==============
+/**
+ * @brief Tuning parameters for RD03D_Tracker
+ */
+struct RD03D_TrackerConfig {
+    float maxRangeCm;      ///< Detections further than this are rejected
+    float maxAngleDeg;     ///< Detections outside ±angle are rejected
+    float gateMm;          ///< Maximum distance between prediction and detection
+    uint8_t coastFrames;   ///< Frames a track survives without a detection
+    uint8_t confirmFrames; ///< Detections needed before a track is reported
+    float alpha;           ///< Position gain (0-1, lower = smoother)
+    float beta;            ///< Velocity gain (0-1, lower = smoother)
+
+    /**
+     * @brief Restore default settings
+     */
+    void setDefaults() {
+        maxRangeCm = 800.0f;
+        maxAngleDeg = 60.0f;
+        gateMm = 600.0f;
+        coastFrames = 5;
+        confirmFrames = 2;
+        alpha = 0.6f;
+        beta = 0.2f;
+    }
+};
+
+// ============== TRACK DATA ==============
+/**
+ * @brief Structure holding a single filtered track
+ */
+struct RD03D_Track {
+    uint16_t id;         ///< Stable track ID (1-65535, 0 = unused)
+    float x;             ///< Filtered X in mm
+    float y;             ///< Filtered Y in mm
+    float vx;            ///< X velocity in mm/s
+    float vy;            ///< Y velocity in mm/s
+    uint16_t hits;       ///< Number of associated detections
+    uint8_t missed;      ///< Consecutive frames without a detection
+    bool confirmed;      ///< True once hits >= confirmFrames
+    bool active;         ///< True while the track exists
+    uint32_t firstSeen;  ///< Time of first detection (ms)
+    uint32_t lastSeen;   ///< Time of last detection (ms)
+
+    /**
+     * @brief True if the track should be reported
+     */
+    bool isValid() const { return active && confirmed; }
+
+    /**
+     * @brief Clear track data
+     */
+    void clear() {
+        id = 0;
+        x = 0;
+        y = 0;
+        vx = 0;
+        vy = 0;
+        hits = 0;
+        missed = 0;
+        confirmed = false;
+        active = false;
+        firstSeen = 0;
+        lastSeen = 0;
+    }
+};
+
+/**
+ * @brief Track position at an arbitrary time, filled by sampleAt()
+ */
+struct RD03D_TrackSample {
+    uint16_t id;         ///< Track ID (0 = no valid track in this slot)
+    float x;             ///< X in mm at the sample time
+    float y;             ///< Y in mm at the sample time
+    float vx;            ///< X velocity in mm/s
+    float vy;            ///< Y velocity in mm/s
+    bool extrapolated;   ///< True if the sample time is past the last update
+};
+
+// ============== WARM RESTART ==============
+enum RD03D_RestoreResult {
+    RD03D_RESTORE_OK = 0,
+    RD03D_RESTORE_INVALID,   ///< No saved state (wrong magic, size or format)
+    RD03D_RESTORE_CRC,       ///< Saved state is damaged
+    RD03D_RESTORE_STALE      ///< Saved state is older than maxAgeMs
+};
+
+// ============== MAIN CLASS ==============
+class RD03D_Tracker {
+public:
+    /**
+     * @brief Constructor (uses default settings)
+     */
+    RD03D_Tracker();
+
+    /**
+     * @brief Replace tracker settings
+     * @param config New settings
+     */
+    void setConfig(const RD03D_TrackerConfig& config);
+
+    /**
+     * @brief Get current settings
+     */
+    const RD03D_TrackerConfig& getConfig();
+
+    /**
+     * @brief Feed one radar frame
+     * @param targets Array of RD03D_MAX_TARGETS targets from the radar
+     * @param now Frame time in ms (e.g. millis())
+     * @return Number of valid (confirmed) tracks
+     */
+    uint8_t update(const RD03D_Target* targets, uint32_t now);
+
+    /**
+     * @brief Check a detection against the range and beam gate
+     * @param target Detection to check
+     * @return true if the detection should be tracked
+     */
+    bool validate(const RD03D_Target& target);
+
+    /**
+     * @brief Get track by index
+     * @param index Track index (0 to RD03D_MAX_TRACKS-1)
+     * @return Pointer to track data, or nullptr if index invalid
+     */
+    RD03D_Track* getTrack(uint8_t index);
+
+    /**
+     * @brief Get all tracks array
+     * @return Pointer to array of RD03D_MAX_TRACKS tracks
+     */
+    RD03D_Track* getTracks();
+
+    /**
+     * @brief Get the rolling statistics of a track
+     *
+     * The window belongs to the track slot: it is cleared when the slot
+     * gets a new track, and by reset() and restoreState().
+     * @param index Track index (0 to RD03D_MAX_TRACKS-1)
+     * @return Pointer to the window, or nullptr if index invalid
+     */
+    const RD03D_TrackWindow* getWindow(uint8_t index);
+
+    /**
+     * @brief Sample every valid track at an arbitrary time
+     *
+     * Between the last two update() calls positions are interpolated;
+     * after the last one they are extrapolated along the velocity for up
+     * to RD03D_SAMPLE_HORIZON ms, then held. Querying with one frame
+     * interval of delay (now minus RD03D::getFrameInterval(), 20-50 ms)
+     * always interpolates and is the smoothest; querying now has no lag
+     * but overshoots when a target turns. getFrameInterval() is 0 until
+     * measured and for feed() or update(source) input: use 50 ms then.
+     * After a gap of more than a second there is nothing to interpolate
+     * from and the latest position is used. O(tracks), allocates
+     * nothing, does not change the tracker.
+     * @param t Time in the update() time base (ms)
+     * @param samples Output array of RD03D_MAX_TRACKS samples, indexed like getTrack()
+     * @return Number of valid tracks sampled
+     */
+    uint8_t sampleAt(uint32_t t, RD03D_TrackSample* samples) const;
+
+    /**
+     * @brief Get number of valid (confirmed) tracks
+     */
+    uint8_t getTrackCount();
+
+    /**
+     * @brief Get number of detections rejected by validate()
+     */
+    uint32_t getRejectedCount();
+
+    /**
+     * @brief Drop all tracks (IDs keep counting up)
+     */
+    void reset();
+
+    /**
+     * @brief Serialise tracks, IDs, filter states and counters
+     *
+     * Times are stored relative to now, and the state is stamped with a
+     * clock that survives the reset (e.g. gettimeofday() in ms, which
+     * ESP32 keeps across deep sleep and software resets).
+     * @param buffer Output buffer (RD03D_TRACKER_STATE_SIZE bytes is always enough)
+     * @param size Size of buffer
+     * @param now Current time in the update() time base (millis())
+     * @param stamp Current time in ms on the persistent clock
+     * @return Bytes written, or 0 if the buffer is too small
+     */
+    size_t saveState(uint8_t* buffer, size_t size, uint32_t now, uint32_t stamp);
+
+    /**
+     * @brief Restore state written by saveState() if it is intact and fresh
+     *
+     * Track times are rebased onto now minus the time spent in the reset.
+     * The tracker is left unchanged unless the result is RD03D_RESTORE_OK.
+     * Settings are not part of the state.
+     * @param buffer Saved state
+     * @param size Bytes available in buffer
+     * @param now Current time in the update() time base (millis())
+     * @param stamp Current time in ms on the same persistent clock
+     * @param maxAgeMs Oldest state to accept
+     */
+    RD03D_RestoreResult restoreState(const uint8_t* buffer, size_t size, uint32_t now,
+                                     uint32_t stamp, uint32_t maxAgeMs);
+
+private:
+    RD03D_TrackerConfig _config;
+    RD03D_Track _tracks[RD03D_MAX_TRACKS];
+    RD03D_TrackWindow _windows[RD03D_MAX_TRACKS];
+    uint16_t _nextId;
+    float _prevX[RD03D_MAX_TRACKS];    // Filtered positions at the update before last
+    float _prevY[RD03D_MAX_TRACKS];
+    uint32_t _lastUpdate;
+    uint32_t _prevUpdate;
+    bool _hasUpdate;
+    uint32_t _rejectedCount;
+
+    void startTrack(const RD03D_Target& target, uint32_t now);
+};
+
+#endif // RD03D_TRACKER_H
@@ -0,0 +1,255 @@
+/**
+ * @file RD03D_Tunnel.cpp
+ * @brief Implementation of the raw UART tunnel sender and receiver
+ */
+
+#include "RD03D_Tunnel.h"
+#include <string.h>
+
+// ============== DATAGRAM LAYOUT ==============
+#define RD03D_TUNNEL_MAGIC   0x55334452UL  // "RD3U" little endian
+#define RD03D_TUNNEL_FORMAT  2
+
+static_assert(sizeof(RD03D_TunnelHeader) == RD03D_TUNNEL_HEADER_SIZE, "RD03D_TunnelHeader layout changed");
+static_assert(RD03D_TUNNEL_DATAGRAM > RD03D_TUNNEL_HEADER_SIZE + RD03D_TUNNEL_RECORD_SIZE &&
+              RD03D_TUNNEL_DATAGRAM <= 65535, "RD03D_TUNNEL_DATAGRAM out of range");
+
+static void putU16(uint8_t* out, uint16_t v) {
+    out[0] = (uint8_t)v;
+    out[1] = (uint8_t)(v >> 8);
+}
+
+static uint16_t getU16(const uint8_t* in) {
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+// ============== SENDER ==============
+RD03D_Tunnel::RD03D_Tunnel(uint16_t sensorId) {
+    _sendCallback = nullptr;
+    _used = RD03D_TUNNEL_HEADER_SIZE;
+    _lastRecord = 0;
+    _records = 0;
+    _baseMicros = 0;
+    _lastMicros = 0;
+    _sensorId = sensorId;
+    _maxDelayMs = RD03D_TUNNEL_MAX_DELAY;
+    _sequence = 0;
+    _sent = 0;
+    _dropped = 0;
+    _bytes = 0;
+    _bootId = 0;
+    _hasBootId = false;
+    _first = true;
+}
+
+void RD03D_Tunnel::onSend(RD03D_TunnelSendCallback callback) {
+    _sendCallback = callback;
+}
+
+void RD03D_Tunnel::setMaxDelay(uint16_t ms) {
+    _maxDelayMs = ms;
+}
+
+void RD03D_Tunnel::setBootId(uint32_t bootId) {
+    _bootId = bootId;
+    _hasBootId = true;
+}
+
+void RD03D_Tunnel::write(const uint8_t* data, size_t len, uint32_t arrivalMicros) {
+    _bytes += len;
+
+    while (len > 0) {
+        // Record offsets are 16-bit microseconds from the first record
+        if (_records > 0 && arrivalMicros - _baseMicros > 0xFFFF) flush();
+
+        // Bytes that arrived with the previous ones extend its record
+        bool extend = _lastRecord != 0 && arrivalMicros == _lastMicros;
+        if (!extend) {
+            if (RD03D_TUNNEL_DATAGRAM - _used <= RD03D_TUNNEL_RECORD_SIZE) flush();
+            if (_records == 0) _baseMicros = arrivalMicros;
+            _lastRecord = _used;
+            _lastMicros = arrivalMicros;
+            putU16(_datagram + _used, (uint16_t)(arrivalMicros - _baseMicros));
+            putU16(_datagram + _used + 2, 0);
+            _used += RD03D_TUNNEL_RECORD_SIZE;
+            _records++;
+        }
+
+        size_t n = RD03D_TUNNEL_DATAGRAM - _used;
+        if (n > len) n = len;
+        memcpy(_datagram + _used, data, n);
+        _used += n;
+        putU16(_datagram + _lastRecord + 2, (uint16_t)(getU16(_datagram + _lastRecord + 2) + n));
+        data += n;
+        len -= n;
+
+        if (_used == RD03D_TUNNEL_DATAGRAM) flush();
+    }
+}
+
+void RD03D_Tunnel::poll(uint32_t nowMicros) {
+    if (_records > 0 && nowMicros - _baseMicros >= (uint32_t)_maxDelayMs * 1000) flush();
+}
+
+bool RD03D_Tunnel::flush() {
+    if (_records == 0) return false;
+
+    // Drawn at the first datagram rather than in the constructor, so the
+    // RNG has had radio noise to mix in
+    if (!_hasBootId) {
+        _bootId = ((uint32_t)random(0x10000) << 16) | (uint32_t)random(0x10000);
+        _hasBootId = true;
+    }
+
+    RD03D_TunnelHeader h;
+    h.magic = RD03D_TUNNEL_MAGIC;
+    h.sensorId = _sensorId;
+    h.format = RD03D_TUNNEL_FORMAT;
+    h.flags = _first ? RD03D_TUNNEL_FLAG_FIRST : 0;
+    h.bootId = _bootId;
+    h.sequence = _sequence++;
+    h.baseMicros = _baseMicros;
+    h.records = _records;
+    h.length = (uint16_t)(_used - RD03D_TUNNEL_HEADER_SIZE);
+    memcpy(_datagram, &h, sizeof(h));
+
+    bool ok = _sendCallback && _sendCallback(_datagram, _used);
+    if (ok) {
+        _sent++;
+        _first = false;     // Accepted by the callback, which is not delivery
+    } else {
+        _dropped++;
+    }
+
+    _used = RD03D_TUNNEL_HEADER_SIZE;
+    _lastRecord = 0;
+    _records = 0;
+    return ok;
+}
+
+uint32_t RD03D_Tunnel::getSequence() const {
+    return _sequence;
+}
+
+uint32_t RD03D_Tunnel::getSentCount() const {
+    return _sent;
+}
+
+uint32_t RD03D_Tunnel::getDroppedCount() const {
+    return _dropped;
+}
+
+uint32_t RD03D_Tunnel::getByteCount() const {
+    return _bytes;
+}
+
+// ============== RECEIVER ==============
+RD03D_TunnelReceiver::RD03D_TunnelReceiver() {
+    _arrivalMicros = 0;
+    _received = 0;
+    _lost = 0;
+    _late = 0;
+    _invalid = 0;
+    _restarts = 0;
+    reset();
+}
+
+bool RD03D_TunnelReceiver::parseHeader(const uint8_t* datagram, size_t len, RD03D_TunnelHeader* header) {
+    if (!datagram || len < sizeof(RD03D_TunnelHeader)) return false;
+
+    RD03D_TunnelHeader h;
+    memcpy(&h, datagram, sizeof(h));
+    if (h.magic != RD03D_TUNNEL_MAGIC || h.format != RD03D_TUNNEL_FORMAT) return false;
+    if (h.length != len - sizeof(h) || h.records == 0) return false;
+
+    // Records must fill the datagram exactly
+    size_t pos = sizeof(h);
+    for (uint16_t i = 0; i < h.records; i++) {
+        if (len - pos < RD03D_TUNNEL_RECORD_SIZE) return false;
+        size_t n = getU16(datagram + pos + 2);
+        pos += RD03D_TUNNEL_RECORD_SIZE;
+        if (len - pos < n) return false;
+        pos += n;
+    }
+    if (pos != len) return false;
+
+    if (header) *header = h;
+    return true;
+}
+
+RD03D_TunnelResult RD03D_TunnelReceiver::receive(const uint8_t* datagram, size_t len, RD03D& radar) {
+    RD03D_TunnelHeader h;
+    if (!parseHeader(datagram, len, &h)) {
+        _invalid++;
+        return RD03D_TUNNEL_INVALID;
+    }
+
+    RD03D_TunnelResult result = RD03D_TUNNEL_OK;
+    if (!_synced) {
+        radar.resync();
+    } else if (h.bootId != _bootId) {
+        // Restarted: the first datagrams of the new boot may be lost, so
+        // the sequence is taken from whichever arrives first (a new boot
+        // starts at 0, so any before it were lost)
+        _restarts++;
+        _lost += h.sequence;
+        radar.resync();
+        result = RD03D_TUNNEL_RESTART;
+    } else {
+        int32_t ahead = (int32_t)(h.sequence - _expected);
+        if (ahead < 0) {
+            _late++;
+            return RD03D_TUNNEL_LATE;
+        }
+        if (ahead > 0) {
+            _lost += ahead;
+            radar.resync();
+            result = RD03D_TUNNEL_GAP;
+        }
+    }
+    _expected = h.sequence + 1;
+    _bootId = h.bootId;
+    _synced = true;
+    _received++;
+
+    size_t pos = sizeof(h);
+    for (uint16_t i = 0; i < h.records; i++) {
+        uint16_t offset = getU16(datagram + pos);
+        uint16_t n = getU16(datagram + pos + 2);
+        pos += RD03D_TUNNEL_RECORD_SIZE;
+        _arrivalMicros = h.baseMicros + offset;
+        radar.feed(datagram + pos, n);
+        pos += n;
+    }
+    return result;
+}
+
+uint32_t RD03D_TunnelReceiver::getArrivalMicros() const {
+    return _arrivalMicros;
+}
+
+uint32_t RD03D_TunnelReceiver::getReceivedCount() const {
+    return _received;
+}
+
+uint32_t RD03D_TunnelReceiver::getLostCount() const {
+    return _lost;
+}
+
+uint32_t RD03D_TunnelReceiver::getLateCount() const {
+    return _late;
+}
+
+uint32_t RD03D_TunnelReceiver::getInvalidCount() const {
+    return _invalid;
+}
+
+uint32_t RD03D_TunnelReceiver::getRestartCount() const {
+    return _restarts;
+}
+
+void RD03D_TunnelReceiver::reset() {
+    _expected = 0;
+    _bootId = 0;
+    _synced = false;
+}
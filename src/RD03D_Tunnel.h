@@ -0,0 +1,261 @@
+/**
+ * @file RD03D_Tunnel.h
+ * @brief Raw UART tunnel: forward radar bytes to a central parser
+ *
+ * For sites where the node should stay minimal, RD03D_Tunnel packs the
+ * raw bytes update() reads from the UART into datagrams, each with a
+ * sequence number and the arrival time of every batch of bytes, and
+ * hands them to a send callback (usually UDP). Attached with parsing
+ * switched off, the node no longer decodes frames at all.
+ *
+ * RD03D_TunnelReceiver is the other end: it checks the sequence and
+ * feeds the bytes into an RD03D with feed(), exactly as if the radar
+ * were a local tty. Every datagram also carries a boot ID the node draws
+ * once with random() (the hardware RNG on ESP32), so a rebooted node is
+ * recognised even if its first datagrams are lost and its sequence is
+ * still behind the old one. extras/host/tunnel runs one receiver and parser per
+ * sensor; the same class works on a gateway ESP32.
+ *
+ * Node:
+ * @code
+ * RD03D_Tunnel tunnel(NODE_ID);
+ *
+ * bool sendDatagram(const uint8_t* data, size_t len) {
+ *     udp.beginPacket(hostIP, 9000);
+ *     udp.write(data, len);
+ *     return udp.endPacket();
+ * }
+ *
+ * void setup() {
+ *     radar.begin(Serial1, 20, 21);
+ *     tunnel.onSend(sendDatagram);
+ *     radar.attachTunnel(&tunnel);   // Forward only, no local parsing
+ * }
+ *
+ * void loop() {
+ *     radar.update();                // Reads, forwards, flushes on age
+ * }
+ * @endcode
+ *
+ * Datagram layout (little endian): RD03D_TunnelHeader, then `records`
+ * records of {uint16 offset in us from baseMicros, uint16 length, bytes}.
+ * There is no checksum of its own: UDP's covers the datagram.
+ */
+
+#ifndef RD03D_TUNNEL_H
+#define RD03D_TUNNEL_H
+
+#include "RD03D.h"
+
+// ============== CONFIGURATION ==============
+#define RD03D_TUNNEL_DATAGRAM   512   // Largest datagram, header included (fits any MTU)
+#define RD03D_TUNNEL_MAX_DELAY  20    // ms the oldest byte may wait before a flush
+#define RD03D_TUNNEL_HEADER_SIZE 24
+#define RD03D_TUNNEL_RECORD_SIZE 4    // Record header: offset + length
+
+// Header flags
+#define RD03D_TUNNEL_FLAG_FIRST 0x01  // Sent before any datagram of this boot was accepted (informational)
+
+/**
+ * @brief Datagram header
+ */
+struct RD03D_TunnelHeader {
+    uint32_t magic;        ///< "RD3U"
+    uint16_t sensorId;     ///< Id given to the sending tunnel
+    uint8_t format;        ///< Layout version
+    uint8_t flags;         ///< RD03D_TUNNEL_FLAG_* bits
+    uint32_t bootId;       ///< Random per tunnel instance (node boot); a change is a restart
+    uint32_t sequence;     ///< Incremented per datagram, including ones the send callback dropped
+    uint32_t baseMicros;   ///< micros() on the node when the first record arrived
+    uint16_t records;      ///< Number of records that follow
+    uint16_t length;       ///< Bytes after the header (records and their data)
+};
+
+/**
+ * @brief Send callback
+ * @param datagram Complete datagram
+ * @param len Datagram length in bytes
+ * @return true if sent; a false return drops the datagram (the receiver sees a gap)
+ */
+typedef bool (*RD03D_TunnelSendCallback)(const uint8_t* datagram, size_t len);
+
+// ============== SENDER ==============
+class RD03D_Tunnel {
+public:
+    /**
+     * @brief Constructor
+     * @param sensorId Id carried in every datagram, so one host can serve many nodes
+     */
+    RD03D_Tunnel(uint16_t sensorId = 0);
+
+    /**
+     * @brief Set callback that sends a finished datagram
+     */
+    void onSend(RD03D_TunnelSendCallback callback);
+
+    /**
+     * @brief Set how long bytes may be held back to fill a datagram
+     * @param ms Delay in ms (0 = send on every poll() that has bytes)
+     */
+    void setMaxDelay(uint16_t ms);
+
+    /**
+     * @brief Add raw bytes that arrived at arrivalMicros
+     *
+     * Bytes with the same arrival time as the previous record extend it.
+     * A full datagram is sent straight away. RD03D::update() calls this
+     * for an attached tunnel.
+     * @param data Raw radar bytes
+     * @param len Number of bytes
+     * @param arrivalMicros micros() when the bytes were read
+     */
+    void write(const uint8_t* data, size_t len, uint32_t arrivalMicros);
+
+    /**
+     * @brief Send the pending datagram if its oldest byte is older than the max delay
+     * @param nowMicros Current micros()
+     */
+    void poll(uint32_t nowMicros);
+
+    /**
+     * @brief Send the pending datagram now
+     * @return false if nothing was pending or the send callback failed
+     */
+    bool flush();
+
+    /**
+     * @brief Set the boot ID instead of drawing it with random()
+     *
+     * Only needed if the sketch seeds random() with a fixed value, which
+     * would repeat the ID on every boot. Call before the first datagram.
+     */
+    void setBootId(uint32_t bootId);
+
+    /**
+     * @brief Get the sequence number the next datagram will carry
+     */
+    uint32_t getSequence() const;
+
+    /**
+     * @brief Get datagrams the send callback accepted
+     */
+    uint32_t getSentCount() const;
+
+    /**
+     * @brief Get datagrams dropped because the send callback failed
+     */
+    uint32_t getDroppedCount() const;
+
+    /**
+     * @brief Get raw radar bytes forwarded (sent or dropped)
+     */
+    uint32_t getByteCount() const;
+
+private:
+    RD03D_TunnelSendCallback _sendCallback;
+    uint8_t _datagram[RD03D_TUNNEL_DATAGRAM];
+    size_t _used;           // Bytes in _datagram, header included
+    size_t _lastRecord;     // Offset of the open record (0 = none)
+    uint16_t _records;
+    uint32_t _baseMicros;
+    uint32_t _lastMicros;   // Arrival time of the open record
+    uint16_t _sensorId;
+    uint16_t _maxDelayMs;
+    uint32_t _sequence;
+    uint32_t _sent;
+    uint32_t _dropped;
+    uint32_t _bytes;
+    uint32_t _bootId;
+    bool _hasBootId;
+    bool _first;
+};
+
+// ============== RECEIVER ==============
+/**
+ * @brief What receive() did with a datagram
+ */
+enum RD03D_TunnelResult {
+    RD03D_TUNNEL_OK = 0,     ///< Next in sequence, fed to the parser
+    RD03D_TUNNEL_GAP,        ///< Datagrams were lost; parser resynced, then fed
+    RD03D_TUNNEL_RESTART,    ///< Sender restarted; parser resynced, then fed
+    RD03D_TUNNEL_LATE,       ///< Duplicate or reordered behind newer data; dropped
+    RD03D_TUNNEL_INVALID     ///< Not a tunnel datagram or damaged; dropped
+};
+
+class RD03D_TunnelReceiver {
+public:
+    /**
+     * @brief Constructor
+     */
+    RD03D_TunnelReceiver();
+
+    /**
+     * @brief Check a datagram and read its header
+     * @param header Filled in when the datagram is valid (may be nullptr)
+     * @return false if the datagram is not a complete, well-formed tunnel datagram
+     */
+    static bool parseHeader(const uint8_t* datagram, size_t len, RD03D_TunnelHeader* header);
+
+    /**
+     * @brief Feed a datagram's bytes into a parser
+     *
+     * Frames decode inside this call, through the radar's own callbacks;
+     * getArrivalMicros() gives the node's arrival time of the bytes
+     * being fed. After lost datagrams the parser is resynced first, so
+     * no frame is stitched together from both sides of the gap. A new
+     * boot ID is a sender restart: the sequence starts again from that
+     * datagram, whatever its number.
+     * @param datagram Datagram as received
+     * @param len Datagram length
+     * @param radar Parser for this sensor
+     */
+    RD03D_TunnelResult receive(const uint8_t* datagram, size_t len, RD03D& radar);
+
+    /**
+     * @brief Get the node's micros() when the bytes being fed arrived
+     */
+    uint32_t getArrivalMicros() const;
+
+    /**
+     * @brief Get datagrams fed to the parser
+     */
+    uint32_t getReceivedCount() const;
+
+    /**
+     * @brief Get datagrams missing from the sequence
+     */
+    uint32_t getLostCount() const;
+
+    /**
+     * @brief Get duplicate or reordered datagrams dropped
+     */
+    uint32_t getLateCount() const;
+
+    /**
+     * @brief Get invalid datagrams dropped
+     */
+    uint32_t getInvalidCount() const;
+
+    /**
+     * @brief Get sender restarts seen
+     */
+    uint32_t getRestartCount() const;
+
+    /**
+     * @brief Forget the sequence (the next datagram is accepted as-is)
+     */
+    void reset();
+
+private:
+    uint32_t _expected;
+    uint32_t _bootId;       // Boot ID of the sender being followed
+    bool _synced;
+    uint32_t _arrivalMicros;
+    uint32_t _received;
+    uint32_t _lost;
+    uint32_t _late;
+    uint32_t _invalid;
+    uint32_t _restarts;
+};
+
+#endif // RD03D_TUNNEL_H